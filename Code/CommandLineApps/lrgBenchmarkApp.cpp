@@ -0,0 +1,1671 @@
+#include <lrgExceptionMacro.h>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <functional>
+#include <cmath>
+#include <limits>
+#include "lrgGradientDescentSolverStrategy.h"
+#include "lrgFileLoaderDataCreator.h"
+#include "lrgConjugateGradientSolverStrategy.h"
+#include "lrgCoordinateDescentSolverStrategy.h"
+#include "lrgWarmStartFitter.h"
+#include "lrgRecursiveLeastSquares.h"
+#include "lrgSlidingWindowRegression.h"
+#include "lrgNormalEquationSolverStrategy.h"
+#include "lrgGroupedRegression.h"
+#include "lrgBatchedRegression.h"
+#include "lrgBasisRegression.h"
+#include "lrgRobustSolverStrategy.h"
+#include "lrgTheilSenSolverStrategy.h"
+#include "lrgRansacSolverStrategy.h"
+#include "lrgCrossValidation.h"
+#include "lrgBootstrap.h"
+#include "lrgGradientDescentSweep.h"
+#include "lrgSketchSolverStrategy.h"
+#include "lrgLogisticRegressionSolverStrategy.h"
+#include "lrgLogisticDataCreator.h"
+#include "lrgLinearModel.h"
+#include "lrgLinearDataCreator.h"
+#include <algorithm>
+#include "lrgParallel.h"
+#include <unordered_map>
+#include <sstream>
+
+// A function that shows how to use the app in the command line.
+static void how_to_use(std::string app)
+{
+    std::cerr << "Usage: " << app << " BENCHMARK [DIR]\n"
+              << "Benchmarks:\n"
+              << "\toptimisers\t\tIterations and wall time of the gradient descent update rules.\n"
+              << "\tpreconditioners\t\tIterations and wall time of gradient descent with and without preconditioning.\n"
+              << "\tcg\t\t\tConjugate gradient against the normal equation as the number of features grows.\n"
+              << "\tlasso\t\t\tCoordinate descent with strong rules and active sets against naive full sweeps.\n"
+              << "\tpath\t\t\tA warm-started regularisation path of 100 lambdas against 100 independent fits.\n"
+              << "\twarmstart\t\tRefits of slowly drifting data, from random thetas and warm-started from the last fit.\n"
+              << "\trls\t\t\tOnline updates per second of recursive least squares against refitting the history.\n"
+              << "\twindow\t\t\tAll sliding-window fits of a long series, with and without re-anchoring, against refitting every window.\n"
+              << "\tgrouped\t\t\tOne fit per key for 10M rows and 1M keys, open addressing against std::unordered_map, 1 to N threads.\n"
+              << "\tbatched\t\t\tFits per second of 10000 small datasets, one FitData call each against the batched solver.\n"
+              << "\tmultitarget\t\tOne normal equation for 1 to 1000 y columns against one fit per column.\n"
+              << "\tbasis\t\t\tPolynomials of degree 2 to 10 and splines on 100M rows, features generated on the fly.\n"
+              << "\trobust\t\t\tHuber and Tukey IRLS with fused passes and low-rank updates against naive refits.\n"
+              << "\ttheilsen\t\tExact O(N log N) and sampled Theil-Sen against the median of all the slopes.\n"
+              << "\transac\t\t\tRANSAC hypotheses per second on 1 to 8 threads against a scalar loop.\n"
+              << "\tcrossvalidation\t\tK-fold by subtracting fold statistics against K refits, and leave-one-out.\n"
+              << "\tbootstrap\t\tBootstrap replicates from multinomial counts on 1 to 4 threads against copied resamples.\n"
+              << "\tsweep\t\t\tGradient descent hyperparameter sweep with successive halving against one fit per config.\n"
+              << "\tsketch\t\t\tCountSketch least squares with and without LSQR refinement against the normal equation.\n"
+              << "\tmixed\t\t\tNormal equation in float with double refinement against all double, near and far from zero.\n"
+              << "\tlogistic\t\tThe fast logistic kernel against std::exp, and Newton against L-BFGS.\n"
+              << "\tpredict\t\t\tRows per second of lrgLinearModel: one row at a time, batches on 1 to 4 threads, streams.\n\n"
+              << "DIR is the directory of the test files. Default: ../Testing/TestFiles\n\n"
+              << "Examples: Inside the build directory run in command line\n"
+              << "./bin/lrgBenchmarkApp optimisers\n"
+              << std::endl;
+}
+
+// Wall time of a function call in milliseconds.
+static double time_ms(const std::function<void()> &func)
+{
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// Reads one of the test files.
+static pdd_vector load_file(std::string filepath)
+{
+    pdd_vector vec;
+    auto vec_ptr = std::make_shared<pdd_vector>(vec);
+    lrgFileLoaderDataCreator data(filepath, std::move(vec_ptr));
+    return data.GetData();
+}
+
+// y = 3x + 2 + noise, with x uniform in [offset, offset + 1).
+// The further x sits from zero, the worse the conditioning of X^T X.
+static pdd_vector shifted_data(unsigned int size, double offset)
+{
+    std::mt19937_64 mt64;
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    std::normal_distribution<double> noise_distribution(0.0, 1.0);
+
+    pdd_vector vec;
+    for (size_t i = 0; i < size; i++)
+    {
+        double x = offset + distribution(mt64);
+        vec.push_back(std::make_pair(x, 3 * x + 2 + noise_distribution(mt64)));
+    }
+    return vec;
+}
+
+// Runs every update rule until the gradient norm drops below the tolerance.
+static void benchmark_optimisers(const std::string &name, const pdd_vector &vec, double eta)
+{
+    std::cout << name << " (eta: " << eta << ")" << std::endl;
+    std::cout << std::setw(12) << "rule" << std::setw(14) << "iterations" << std::setw(12) << "time [ms]"
+              << std::setw(12) << "t0" << std::setw(12) << "t1" << std::endl;
+
+    const char *rules[] = {"plain", "momentum", "nesterov", "adam", "bb"};
+    for (auto rule : rules)
+    {
+        unsigned int iterations = 10000000;
+        lrgGradientDescentSolverStrategy strategy(eta, iterations);
+        strategy.SetUpdateRule(lrgUpdateRuleFromString(rule));
+        strategy.SetTolerance(1e-6);
+
+        pdd thetas;
+        double ms = time_ms([&]() { thetas = strategy.FitData(vec); });
+
+        std::cout << std::setw(12) << rule << std::setw(14) << strategy.GetIterationsRun() << std::setw(12) << ms
+                  << std::setw(12) << thetas.first << std::setw(12) << thetas.second << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+// Runs plain gradient descent with every preconditioner until the gradient norm drops below the tolerance.
+static void benchmark_preconditioners(const std::string &name, const pdd_vector &vec, double eta)
+{
+    std::cout << name << " (eta: " << eta << ")" << std::endl;
+    std::cout << std::setw(14) << "preconditioner" << std::setw(14) << "iterations" << std::setw(12) << "time [ms]"
+              << std::setw(12) << "t0" << std::setw(12) << "t1" << std::endl;
+
+    const char *preconditioners[] = {"none", "standardise", "jacobi"};
+    for (auto preconditioner : preconditioners)
+    {
+        unsigned int iterations = 10000000;
+        lrgGradientDescentSolverStrategy strategy(eta, iterations);
+        strategy.SetPreconditioner(lrgPreconditionerFromString(preconditioner));
+        strategy.SetTolerance(1e-6);
+
+        pdd thetas;
+        double ms = time_ms([&]() { thetas = strategy.FitData(vec); });
+
+        std::cout << std::setw(14) << preconditioner << std::setw(14) << strategy.GetIterationsRun() << std::setw(12) << ms
+                  << std::setw(12) << thetas.first << std::setw(12) << thetas.second << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+// Random design matrices with N = 4p rows and p columns (the first column is ones).
+// The normal equation costs O(N p^2 + p^3), conjugate gradient O(N p) per iteration.
+static void benchmark_cg()
+{
+    std::cout << std::setw(8) << "p" << std::setw(8) << "N" << std::setw(16) << "normal [ms]" << std::setw(12) << "cg [ms]"
+              << std::setw(14) << "cg iterations" << std::setw(16) << "max difference" << std::endl;
+
+    std::mt19937_64 mt64;
+    std::normal_distribution<double> distribution(0.0, 1.0);
+
+    for (int p = 25; p <= 1600; p *= 2)
+    {
+        int N = 4 * p;
+        Eigen::MatrixXd X(N, p);
+        Eigen::VectorXd y(N);
+        for (int i = 0; i < N; i++)
+        {
+            X(i, 0) = 1;
+            for (int j = 1; j < p; j++)
+            {
+                X(i, j) = distribution(mt64);
+            }
+            y(i) = distribution(mt64);
+        }
+
+        unsigned int iterations = 10 * p;
+        double tolerance = 1e-10;
+        lrgConjugateGradientSolverStrategy cg(iterations, tolerance);
+
+        Eigen::VectorXd normal_thetas;
+        Eigen::VectorXd cg_thetas;
+        // The normal equation: form X^T X and factorise it.
+        double normal_ms = time_ms([&]() {
+            Eigen::MatrixXd gram = Eigen::MatrixXd::Zero(p, p);
+            gram.selfadjointView<Eigen::Lower>().rankUpdate(X.transpose());
+            normal_thetas = gram.selfadjointView<Eigen::Lower>().ldlt().solve(X.transpose() * y);
+        });
+        double cg_ms = time_ms([&]() { cg_thetas = cg.FitData(X, y); });
+
+        std::cout << std::setw(8) << p << std::setw(8) << N << std::setw(16) << normal_ms << std::setw(12) << cg_ms
+                  << std::setw(14) << cg.GetIterationsRun()
+                  << std::setw(16) << (normal_thetas - cg_thetas).cwiseAbs().maxCoeff() << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+// A sparse problem: p features of which only 10 matter, N = 2p samples.
+// Both versions of coordinate descent work on the same covariances, so the difference is the number of
+// coordinate steps that are skipped thanks to the strong rule and the active set.
+static void benchmark_lasso()
+{
+    std::cout << std::setw(8) << "p" << std::setw(10) << "lambda" << std::setw(10) << "non-zero"
+              << std::setw(14) << "naive [ms]" << std::setw(16) << "naive updates"
+              << std::setw(14) << "active [ms]" << std::setw(16) << "active updates"
+              << std::setw(16) << "max difference" << std::endl;
+
+    std::mt19937_64 mt64;
+    std::normal_distribution<double> distribution(0.0, 1.0);
+
+    for (int p = 250; p <= 2000; p *= 2)
+    {
+        int N = 2 * p;
+        Eigen::MatrixXd X(N, p);
+        Eigen::VectorXd y(N);
+        for (int i = 0; i < N; i++)
+        {
+            y(i) = 1 + distribution(mt64);
+            for (int j = 0; j < p; j++)
+            {
+                X(i, j) = distribution(mt64);
+                if (j < 10)
+                {
+                    y(i) += (j + 1) * X(i, j);
+                }
+            }
+        }
+
+        const double lambdas[] = {1.0, 0.1};
+        for (double lambda : lambdas)
+        {
+            double alpha = 1;
+            lrgCoordinateDescentSolverStrategy naive(lambda, alpha);
+            naive.SetActiveSet(false);
+            lrgCoordinateDescentSolverStrategy active(lambda, alpha);
+
+            Eigen::VectorXd naive_thetas;
+            Eigen::VectorXd active_thetas;
+            double naive_ms = time_ms([&]() { naive_thetas = naive.FitData(X, y); });
+            double active_ms = time_ms([&]() { active_thetas = active.FitData(X, y); });
+
+            int non_zero = (active_thetas.tail(p).array() != 0).count();
+            std::cout << std::setw(8) << p << std::setw(10) << lambda << std::setw(10) << non_zero
+                      << std::setw(14) << naive_ms << std::setw(16) << naive.GetCoordinateUpdates()
+                      << std::setw(14) << active_ms << std::setw(16) << active.GetCoordinateUpdates()
+                      << std::setw(16) << (naive_thetas - active_thetas).cwiseAbs().maxCoeff() << std::endl;
+        }
+    }
+    std::cout << std::endl;
+}
+
+// The same sparse problems as above, fitted for the 100 lambdas of the default grid.
+// The path shares the covariances and warm-starts every fit; the independent fits start from scratch every time.
+static void benchmark_path()
+{
+    std::cout << std::setw(8) << "p" << std::setw(8) << "alpha" << std::setw(18) << "independent [ms]"
+              << std::setw(20) << "independent updates" << std::setw(12) << "path [ms]" << std::setw(16) << "path updates"
+              << std::setw(16) << "max difference" << std::endl;
+
+    std::mt19937_64 mt64;
+    std::normal_distribution<double> distribution(0.0, 1.0);
+
+    for (int p = 100; p <= 800; p *= 2)
+    {
+        int N = 2 * p;
+        Eigen::MatrixXd X(N, p);
+        Eigen::VectorXd y(N);
+        for (int i = 0; i < N; i++)
+        {
+            y(i) = 1 + distribution(mt64);
+            for (int j = 0; j < p; j++)
+            {
+                X(i, j) = distribution(mt64);
+                if (j < 10)
+                {
+                    y(i) += (j + 1) * X(i, j);
+                }
+            }
+        }
+
+        const double alphas[] = {1.0, 0.5, 0.0};
+        for (double alpha : alphas)
+        {
+            Eigen::VectorXd lambdas = lrgCoordinateDescentSolverStrategy::LambdaGrid(X, y, alpha);
+
+            Eigen::MatrixXd independent(p + 1, lambdas.size());
+            unsigned long independent_updates = 0;
+            double independent_ms = time_ms([&]() {
+                for (int k = 0; k < lambdas.size(); k++)
+                {
+                    double lambda = lambdas(k);
+                    lrgCoordinateDescentSolverStrategy strategy(lambda, alpha);
+                    independent.col(k) = strategy.FitData(X, y);
+                    independent_updates += strategy.GetCoordinateUpdates();
+                }
+            });
+
+            lrgCoordinateDescentSolverStrategy strategy;
+            strategy.SetAlpha(alpha);
+            Eigen::MatrixXd path;
+            double path_ms = time_ms([&]() { path = strategy.FitPath(X, y, lambdas); });
+
+            std::cout << std::setw(8) << p << std::setw(8) << alpha << std::setw(18) << independent_ms
+                      << std::setw(20) << independent_updates << std::setw(12) << path_ms
+                      << std::setw(16) << strategy.GetCoordinateUpdates()
+                      << std::setw(16) << (independent - path).cwiseAbs().maxCoeff() << std::endl;
+        }
+    }
+    std::cout << std::endl;
+}
+
+// 100 refits of data whose slope drifts a little between fits, with the gradient descent rules
+// that converge to a tolerance. Cold fits start from random thetas, the fitter from the previous solution.
+static void benchmark_warmstart(const std::string &name, const pdd_vector &data, double eta)
+{
+    std::cout << name << " (eta: " << eta << ", 100 refits)" << std::endl;
+    std::cout << std::setw(12) << "rule" << std::setw(18) << "cold iterations" << std::setw(14) << "cold [ms]"
+              << std::setw(18) << "warm iterations" << std::setw(14) << "warm [ms]" << std::endl;
+
+    const char *rules[] = {"plain", "nesterov", "bb"};
+    for (auto rule : rules)
+    {
+        unsigned int iterations = 10000000;
+        auto strategy = std::make_shared<lrgGradientDescentSolverStrategy>(eta, iterations);
+        strategy->SetUpdateRule(lrgUpdateRuleFromString(rule));
+        strategy->SetTolerance(1e-6);
+        lrgWarmStartFitter fitter(strategy);
+
+        unsigned long cold_iterations = 0;
+        unsigned long warm_iterations = 0;
+        double cold_ms = 0;
+        double warm_ms = 0;
+        pdd_vector vec = data;
+        for (int refit = 0; refit < 100; refit++)
+        {
+            for (auto &item : vec)
+            {
+                item.second += 0.001 * item.first;
+            }
+            strategy->ClearInitialThetas();
+            cold_ms += time_ms([&]() { strategy->FitData(vec); });
+            cold_iterations += strategy->GetIterationsRun();
+            warm_ms += time_ms([&]() { fitter.FitData(vec); });
+            warm_iterations += strategy->GetIterationsRun();
+        }
+
+        std::cout << std::setw(12) << rule << std::setw(18) << cold_iterations << std::setw(14) << cold_ms
+                  << std::setw(18) << warm_iterations << std::setw(14) << warm_ms << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+// Thetas after every new point of a stream. Refitting the whole history costs O(N) per point,
+// the recursive version O(1).
+static void benchmark_rls()
+{
+    std::cout << std::setw(12) << "points" << std::setw(14) << "method" << std::setw(12) << "time [ms]"
+              << std::setw(18) << "updates/s" << std::setw(12) << "t0" << std::setw(12) << "t1" << std::endl;
+
+    pdd_vector stream = shifted_data(10000000, 0);
+    const double forgetting_factors[] = {1.0, 0.999};
+
+    for (double forgetting_factor : forgetting_factors)
+    {
+        lrgRecursiveLeastSquares rls(forgetting_factor);
+        pdd thetas;
+        double ms = time_ms([&]() {
+            for (const auto &item : stream)
+            {
+                rls.Update(item.first, item.second);
+            }
+            thetas = rls.GetThetas();
+        });
+        std::string method = (forgetting_factor == 1) ? "rls" : "rls f=0.999";
+        std::cout << std::setw(12) << stream.size() << std::setw(14) << method << std::setw(12) << ms
+                  << std::setw(18) << stream.size() / ms * 1000 << std::setw(12) << thetas.first
+                  << std::setw(12) << thetas.second << std::endl;
+    }
+
+    // Reading the thetas after every single update.
+    {
+        lrgRecursiveLeastSquares rls;
+        double sum = 0;
+        double ms = time_ms([&]() {
+            rls.Update(stream[0].first, stream[0].second);
+            for (size_t i = 1; i < stream.size(); i++)
+            {
+                rls.Update(stream[i].first, stream[i].second);
+                sum += rls.GetThetas().second;
+            }
+        });
+        std::cout << std::setw(12) << stream.size() << std::setw(14) << "rls + thetas" << std::setw(12) << ms
+                  << std::setw(18) << stream.size() / ms * 1000 << std::setw(12) << "" << std::setw(12)
+                  << sum / (stream.size() - 1) << std::endl;
+    }
+
+    // The normal equation on the growing history is quadratic in the length of the stream, so only a short one.
+    {
+        unsigned int size = 5000;
+        lrgNormalEquationSolverStrategy normal;
+        pdd_vector history;
+        pdd thetas;
+        double ms = time_ms([&]() {
+            for (size_t i = 0; i < size; i++)
+            {
+                history.push_back(stream[i]);
+                if (i > 0)
+                {
+                    thetas = normal.FitData(history);
+                }
+            }
+        });
+        std::cout << std::setw(12) << size << std::setw(14) << "refit" << std::setw(12) << ms
+                  << std::setw(18) << size / ms * 1000 << std::setw(12) << thetas.first
+                  << std::setw(12) << thetas.second << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+// All window fits of a series whose x-values sit far from zero, where downdating loses precision fastest.
+// The error is the largest relative difference of the slopes from fresh fits of every 1000th window.
+static void benchmark_window()
+{
+    std::cout << std::setw(10) << "points" << std::setw(8) << "W" << std::setw(16) << "method" << std::setw(12) << "time [ms]"
+              << std::setw(16) << "windows/s" << std::setw(16) << "max rel. error" << std::endl;
+
+    pdd_vector series = shifted_data(10000000, 1e4);
+    lrgRecursiveLeastSquares fresh;
+
+    auto max_error = [&](const pdd_vector &thetas, unsigned int window) -> double
+    {
+        double error = 0;
+        for (size_t k = 0; k < thetas.size(); k += 1000)
+        {
+            pdd_vector points(series.begin() + k, series.begin() + k + window);
+            pdd expected = fresh.FitData(points);
+            error = std::max(error, std::abs(thetas[k].second - expected.second) / std::abs(expected.second));
+        }
+        return error;
+    };
+
+    const unsigned int windows[] = {100, 10000};
+    for (unsigned int window : windows)
+    {
+        const unsigned int intervals[] = {window, 0};
+        for (unsigned int interval : intervals)
+        {
+            lrgSlidingWindowRegression sliding(window);
+            sliding.SetReanchorInterval(interval);
+            pdd_vector thetas;
+            double ms = time_ms([&]() { thetas = sliding.FitWindows(series); });
+            std::string method = (interval == 0) ? "no re-anchoring" : "sliding";
+            std::cout << std::setw(10) << series.size() << std::setw(8) << window << std::setw(16) << method
+                      << std::setw(12) << ms << std::setw(16) << thetas.size() / ms * 1000
+                      << std::setw(16) << max_error(thetas, window) << std::endl;
+        }
+
+        // Refitting every window costs O(W) per window, so only the first 30000 points.
+        size_t size = 30000;
+        pdd_vector thetas;
+        double ms = time_ms([&]() {
+            for (size_t k = 0; k + window <= size; k++)
+            {
+                pdd_vector points(series.begin() + k, series.begin() + k + window);
+                thetas.push_back(fresh.FitData(points));
+            }
+        });
+        std::cout << std::setw(10) << size << std::setw(8) << window << std::setw(16) << "refit"
+                  << std::setw(12) << ms << std::setw(16) << thetas.size() / ms * 1000 << std::setw(16) << 0 << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+// 10M rows spread over 1M keys in random order, so nearly every lookup misses the cache.
+// The baseline is a std::unordered_map on one thread. The text rows are parsed and fitted in one go.
+static void benchmark_grouped()
+{
+    std::cout << std::setw(12) << "rows" << std::setw(10) << "keys" << std::setw(24) << "method"
+              << std::setw(12) << "time [ms]" << std::setw(16) << "rows/s" << std::endl;
+
+    const size_t rows = 10000000;
+    const long long keys = 1000000;
+    std::mt19937_64 mt64;
+    std::uniform_int_distribution<long long> key_distribution(0, keys - 1);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+
+    std::vector<long long> key_vec(rows);
+    pdd_vector vec(rows);
+    for (size_t i = 0; i < rows; i++)
+    {
+        key_vec[i] = key_distribution(mt64);
+        double x = distribution(mt64);
+        vec[i] = std::make_pair(x, key_vec[i] % 10 * x + 2 + distribution(mt64));
+    }
+
+    auto report = [&](const std::string &method, double ms)
+    {
+        std::cout << std::setw(12) << rows << std::setw(10) << keys << std::setw(24) << method
+                  << std::setw(12) << ms << std::setw(16) << rows / ms * 1000 << std::endl;
+    };
+
+    {
+        std::unordered_map<long long, lrgSufficientStatistics> groups;
+        std::vector<lrgGroupFit> fits;
+        double ms = time_ms([&]() {
+            for (size_t i = 0; i < rows; i++)
+            {
+                groups[key_vec[i]].Add(vec[i].first, vec[i].second);
+            }
+            for (const auto &group : groups)
+            {
+                double t1 = group.second.GetSxy() / group.second.GetSxx();
+                fits.push_back({group.first, group.second.GetWeight(),
+                                group.second.GetMeanY() - t1 * group.second.GetMeanX(), t1});
+            }
+        });
+        report("unordered_map", ms);
+    }
+
+    std::vector<unsigned int> thread_counts = {1, 2, 4};
+    if (lrgDefaultThreads() > 4)
+    {
+        thread_counts.push_back(lrgDefaultThreads());
+    }
+    for (unsigned int threads : thread_counts)
+    {
+        lrgGroupedRegression grouped(threads);
+        double ms = time_ms([&]() { grouped.FitData(key_vec, vec); });
+        report("open addressing, " + std::to_string(threads) + "t", ms);
+    }
+
+    std::ostringstream text;
+    for (size_t i = 0; i < rows; i++)
+    {
+        text << key_vec[i] << " " << vec[i].first << " " << vec[i].second << "\n";
+    }
+    std::string str = text.str();
+    for (unsigned int threads : thread_counts)
+    {
+        lrgGroupedRegression grouped(threads);
+        double ms = time_ms([&]() { grouped.FitText(str); });
+        report("text, " + std::to_string(threads) + "t", ms);
+    }
+    std::cout << std::endl;
+}
+
+// 10000 independent datasets of 50 to 500 points. The baseline calls the normal equation through
+// the solver interface once per dataset.
+static void benchmark_batched()
+{
+    std::cout << std::setw(10) << "datasets" << std::setw(12) << "points" << std::setw(24) << "method"
+              << std::setw(12) << "time [ms]" << std::setw(16) << "fits/s" << std::endl;
+
+    const size_t count = 10000;
+    std::mt19937_64 mt64;
+    std::uniform_int_distribution<int> sizes(50, 500);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+
+    std::vector<pdd_vector> datasets(count);
+    lrgPackedDatasets packed;
+    for (size_t k = 0; k < count; k++)
+    {
+        int size = sizes(mt64);
+        for (int i = 0; i < size; i++)
+        {
+            double x = distribution(mt64);
+            datasets[k].push_back(std::make_pair(x, k % 10 * x + 2 + distribution(mt64)));
+        }
+        packed.Add(datasets[k]);
+    }
+
+    auto report = [&](const std::string &method, double ms, unsigned int repeats)
+    {
+        std::cout << std::setw(10) << count << std::setw(12) << packed.GetX().size() << std::setw(24) << method
+                  << std::setw(12) << ms / repeats << std::setw(16) << count * repeats / ms * 1000 << std::endl;
+    };
+
+    {
+        std::unique_ptr<lrgLinearModelSolverStrategyI> normal = std::make_unique<lrgNormalEquationSolverStrategy>();
+        pdd_vector thetas(count);
+        double ms = time_ms([&]() {
+            for (size_t k = 0; k < count; k++)
+            {
+                thetas[k] = normal->FitData(datasets[k]);
+            }
+        });
+        report("FitData per dataset", ms, 1);
+    }
+
+    std::vector<unsigned int> thread_counts = {1, 2, 4};
+    if (lrgDefaultThreads() > 4)
+    {
+        thread_counts.push_back(lrgDefaultThreads());
+    }
+    std::vector<double> t0(count), t1(count);
+    for (unsigned int threads : thread_counts)
+    {
+        const unsigned int repeats = 20;
+        lrgBatchedRegression batched(threads);
+        double ms = time_ms([&]() {
+            for (unsigned int r = 0; r < repeats; r++)
+            {
+                batched.FitData(packed, t0.data(), t1.data());
+            }
+        });
+        report("batched, " + std::to_string(threads) + "t", ms, repeats);
+    }
+    std::cout << std::endl;
+}
+
+// Many y columns against the same 100000 x-values. The baseline fits every column on its own.
+static void benchmark_multitarget()
+{
+    std::cout << std::setw(10) << "points" << std::setw(10) << "targets" << std::setw(16) << "method"
+              << std::setw(12) << "time [ms]" << std::setw(18) << "ms per target" << std::endl;
+
+    const size_t size = 100000;
+    std::mt19937_64 mt64;
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    std::vector<double> x(size);
+    for (auto &value : x)
+    {
+        value = distribution(mt64);
+    }
+
+    lrgNormalEquationSolverStrategy normal;
+    const size_t target_counts[] = {1, 10, 100, 1000};
+    for (size_t target_count : target_counts)
+    {
+        std::vector<double> targets(size * target_count);
+        for (size_t i = 0; i < size; i++)
+        {
+            for (size_t t = 0; t < target_count; t++)
+            {
+                targets[i * target_count + t] = t * x[i] + 2 + distribution(mt64);
+            }
+        }
+
+        pdd_vector thetas;
+        double ms = time_ms([&]() { thetas = normal.FitData(x, targets, target_count); });
+        std::cout << std::setw(10) << size << std::setw(10) << target_count << std::setw(16) << "multi-target"
+                  << std::setw(12) << ms << std::setw(18) << ms / target_count << std::endl;
+
+        // One column at a time (taking the column out of Y is part of the work).
+        ms = time_ms([&]() {
+            pdd_vector column(size);
+            for (size_t t = 0; t < target_count; t++)
+            {
+                for (size_t i = 0; i < size; i++)
+                {
+                    column[i] = std::make_pair(x[i], targets[i * target_count + t]);
+                }
+                thetas[t] = normal.FitData(column);
+            }
+        });
+        std::cout << std::setw(10) << size << std::setw(10) << target_count << std::setw(16) << "per column"
+                  << std::setw(12) << ms << std::setw(18) << ms / target_count << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+// 100M rows of y = sin(2x) + noise, fed as 100 chunks of the same 1M rows (the same way a big file would be
+// read). The features are never stored. The baseline builds the expanded matrix of 1M rows with Eigen.
+static void benchmark_basis()
+{
+    std::cout << std::setw(12) << "rows" << std::setw(10) << "basis" << std::setw(8) << "degree" << std::setw(10)
+              << "features" << std::setw(12) << "time [ms]" << std::setw(16) << "rows/s" << std::setw(14)
+              << "memory [kB]" << std::endl;
+
+    const size_t chunk = 1000000;
+    const size_t chunks = 100;
+    std::mt19937_64 mt64;
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    std::normal_distribution<double> noise_distribution(0.0, 0.1);
+    std::vector<double> x(chunk), y(chunk);
+    for (size_t i = 0; i < chunk; i++)
+    {
+        x[i] = 4 * distribution(mt64);
+        y[i] = std::sin(2 * x[i]) + noise_distribution(mt64);
+    }
+
+    double lower = 0;
+    double upper = 4;
+    unsigned int threads = lrgDefaultThreads();
+    auto run = [&](const std::string &name, lrgBasis kind, unsigned int degree, unsigned int knots)
+    {
+        lrgBasisExpansion basis(kind, degree, knots, lower, upper);
+        lrgBasisRegression regression(basis);
+        regression.SetThreads(threads);
+        std::vector<double> thetas;
+        double ms = time_ms([&]() {
+            for (size_t c = 0; c < chunks; c++)
+            {
+                regression.Add(x.data(), y.data(), chunk);
+            }
+            thetas = regression.GetThetas();
+        });
+        double memory = (basis.GetSize() * basis.GetSize() + basis.GetSize()) * sizeof(double) / 1e3;
+        std::cout << std::setw(12) << regression.GetCount() << std::setw(10) << name << std::setw(8) << degree
+                  << std::setw(10) << basis.GetSize() << std::setw(12) << ms << std::setw(16)
+                  << regression.GetCount() / ms * 1000 << std::setw(14) << memory << std::endl;
+    };
+
+    for (unsigned int degree = 2; degree <= 10; degree++)
+    {
+        run("poly", lrgBasis::Polynomial, degree, 0);
+    }
+    run("bspline", lrgBasis::BSpline, 3, 20);
+    run("bspline", lrgBasis::BSpline, 10, 20);
+    run("linear", lrgBasis::PiecewiseLinear, 1, 20);
+
+    // Materialised: the N x p matrix first, then X^T X and X^T y.
+    {
+        unsigned int degree = 10;
+        unsigned int knots = 0;
+        lrgBasisExpansion basis(lrgBasis::Polynomial, degree, knots, lower, upper);
+        Eigen::VectorXd thetas;
+        double ms = time_ms([&]() {
+            Eigen::MatrixXd X(chunk, basis.GetSize());
+            double values[32];
+            for (size_t i = 0; i < chunk; i++)
+            {
+                basis.Evaluate(x[i], values);
+                for (size_t k = 0; k < basis.GetSize(); k++)
+                {
+                    X(i, k) = values[k];
+                }
+            }
+            Eigen::Map<Eigen::VectorXd> y_vec(y.data(), chunk);
+            thetas = (X.transpose() * X).ldlt().solve(X.transpose() * y_vec);
+        });
+        double memory = chunk * basis.GetSize() * sizeof(double) / 1e3;
+        std::cout << std::setw(12) << chunk << std::setw(10) << "expanded" << std::setw(8) << degree
+                  << std::setw(10) << basis.GetSize() << std::setw(12) << ms << std::setw(16) << chunk / ms * 1000
+                  << std::setw(14) << memory << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+// IRLS on y = 2 + 3x + noise with 10% gross outliers. The naive version recomputes the residuals, the scale
+// and the weights in separate passes and refits the weighted normal equation from scratch every iteration.
+static void benchmark_robust()
+{
+    std::cout << std::setw(10) << "points" << std::setw(20) << "method" << std::setw(12) << "iterations"
+              << std::setw(12) << "time [ms]" << std::setw(12) << "t0" << std::setw(12) << "t1" << std::endl;
+
+    const unsigned int sizes[] = {100000, 10000000};
+    for (unsigned int size : sizes)
+    {
+        pdd_vector vec;
+        lrgLinearDataCreator data(2, 3, size, std::make_shared<pdd_vector>(vec));
+        data.SetContamination(0.1, 20);
+        vec = data.GetData();
+
+        auto report = [&](const std::string &method, unsigned int iterations, double ms, const pdd &thetas)
+        {
+            std::cout << std::setw(10) << size << std::setw(20) << method << std::setw(12) << iterations
+                      << std::setw(12) << ms << std::setw(12) << thetas.first << std::setw(12) << thetas.second
+                      << std::endl;
+        };
+
+        // lrgNormalEquationSolverStrategy::FitData(pdd_vector) keeps X on the stack, so the sums instead.
+        {
+            pdd thetas;
+            double ms = time_ms([&]() {
+                lrgSufficientStatistics stats(vec);
+                double t1 = stats.GetSxy() / stats.GetSxx();
+                thetas = std::make_pair(stats.GetMeanY() - t1 * stats.GetMeanX(), t1);
+            });
+            report("least squares", 1, ms, thetas);
+        }
+
+        const lrgRobustLoss losses[] = {lrgRobustLoss::Huber, lrgRobustLoss::Tukey};
+        for (lrgRobustLoss loss : losses)
+        {
+            std::string name = (loss == lrgRobustLoss::Huber) ? "huber" : "tukey";
+            const bool low_rank_modes[] = {true, false};
+            for (bool low_rank : low_rank_modes)
+            {
+                if (! low_rank && loss == lrgRobustLoss::Tukey)
+                {
+                    continue;
+                }
+                lrgRobustSolverStrategy robust(loss);
+                robust.SetLowRankUpdates(low_rank);
+                pdd thetas;
+                double ms = time_ms([&]() { thetas = robust.FitData(vec); });
+                report(name + (loss == lrgRobustLoss::Huber ? (low_rank ? " low-rank" : " fused") : " fused"),
+                       robust.GetIterationsRun(), ms, thetas);
+            }
+        }
+
+        // Naive Huber IRLS.
+        {
+            lrgNormalEquationSolverStrategy normal;
+            pdd thetas;
+            unsigned int iterations = 0;
+            double ms = time_ms([&]() {
+                weighted_vector unit;
+                for (const auto &xy : vec)
+                {
+                    unit.push_back({xy.first, xy.second, 1});
+                }
+                thetas = normal.FitData(unit);
+                for (; iterations < 100; iterations++)
+                {
+                    std::vector<double> residuals(vec.size());
+                    for (size_t i = 0; i < vec.size(); i++)
+                    {
+                        residuals[i] = std::abs(vec[i].second - thetas.first - thetas.second * vec[i].first);
+                    }
+                    std::vector<double> sorted = residuals;
+                    std::nth_element(sorted.begin(), sorted.begin() + sorted.size() / 2, sorted.end());
+                    double cs = 1.345 * sorted[sorted.size() / 2] / 0.6745;
+                    weighted_vector samples;
+                    for (size_t i = 0; i < vec.size(); i++)
+                    {
+                        double w = (residuals[i] <= cs) ? 1 : cs / residuals[i];
+                        samples.push_back({vec[i].first, vec[i].second, w});
+                    }
+                    pdd previous = thetas;
+                    thetas = normal.FitData(samples);
+                    if (std::max(std::abs(thetas.first - previous.first), std::abs(thetas.second - previous.second)) <=
+                        1e-10 * (1 + std::max(std::abs(thetas.first), std::abs(thetas.second))))
+                    {
+                        iterations++;
+                        break;
+                    }
+                }
+            });
+            report("huber naive refit", iterations, ms, thetas);
+        }
+    }
+    std::cout << std::endl;
+}
+
+// Theil-Sen on y = 2 + 3x + noise with 10% gross outliers. The brute force lists all the N (N - 1) / 2 slopes,
+// so it stops at 10^4 points; the exact solver counts them instead and the sampled one uses 10^6 random pairs.
+static void benchmark_theilsen()
+{
+    std::cout << std::setw(10) << "points" << std::setw(20) << "method" << std::setw(12) << "rounds"
+              << std::setw(12) << "time [ms]" << std::setw(12) << "t0" << std::setw(12) << "t1" << std::endl;
+
+    const unsigned int sizes[] = {1000, 10000, 100000, 1000000};
+    for (unsigned int size : sizes)
+    {
+        pdd_vector vec;
+        lrgLinearDataCreator data(2, 3, size, std::make_shared<pdd_vector>(vec));
+        data.SetContamination(0.1, 20);
+        vec = data.GetData();
+
+        auto report = [&](const std::string &method, unsigned int rounds, double ms, const pdd &thetas)
+        {
+            std::cout << std::setw(10) << size << std::setw(20) << method << std::setw(12) << rounds
+                      << std::setw(12) << ms << std::setw(12) << thetas.first << std::setw(12) << thetas.second
+                      << std::endl;
+        };
+
+        if (size <= 10000)
+        {
+            pdd thetas;
+            double ms = time_ms([&]() {
+                std::vector<double> slopes;
+                slopes.reserve(size_t(size) * (size - 1) / 2);
+                for (size_t i = 0; i < vec.size(); i++)
+                {
+                    for (size_t j = i + 1; j < vec.size(); j++)
+                    {
+                        if (vec[i].first != vec[j].first)
+                        {
+                            slopes.push_back((vec[j].second - vec[i].second) / (vec[j].first - vec[i].first));
+                        }
+                    }
+                }
+                auto middle = slopes.begin() + slopes.size() / 2;
+                std::nth_element(slopes.begin(), middle, slopes.end());
+                double t1 = *middle;
+                std::vector<double> intercepts;
+                for (const auto &xy : vec)
+                {
+                    intercepts.push_back(xy.second - t1 * xy.first);
+                }
+                std::nth_element(intercepts.begin(), intercepts.begin() + size / 2, intercepts.end());
+                thetas = std::make_pair(intercepts[size / 2], t1);
+            });
+            report("all slopes", 0, ms, thetas);
+        }
+
+        {
+            lrgTheilSenSolverStrategy theil_sen;
+            pdd thetas;
+            double ms = time_ms([&]() { thetas = theil_sen.FitData(vec); });
+            report("exact", theil_sen.GetRounds(), ms, thetas);
+        }
+
+        {
+            lrgTheilSenSolverStrategy theil_sen;
+            unsigned long pairs = 1000000;
+            theil_sen.SetSampledPairs(pairs);
+            pdd thetas;
+            double ms = time_ms([&]() { thetas = theil_sen.FitData(vec); });
+            report("1M sampled pairs", 0, ms, thetas);
+        }
+    }
+    std::cout << std::endl;
+}
+
+// RANSAC hypothesis throughput on y = 2 + 3x + noise with 90% of the points scattered uniformly. The confidence
+// is set so high that every run scores all 2000 hypotheses. The naive version draws the pairs from one
+// std::mt19937_64 and scores every hypothesis with its own pass over the (x, y) pairs.
+static void benchmark_ransac()
+{
+    std::cout << std::setw(10) << "points" << std::setw(20) << "method" << std::setw(12) << "time [ms]"
+              << std::setw(16) << "hypotheses/s" << std::setw(12) << "t0" << std::setw(12) << "t1" << std::endl;
+
+    const unsigned int sizes[] = {100000, 1000000};
+    for (unsigned int size : sizes)
+    {
+        std::mt19937_64 mt64(7);
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        std::normal_distribution<double> noise(0.0, 0.5);
+        pdd_vector vec;
+        std::vector<double> x(size), y(size);
+        for (unsigned int i = 0; i < size; i++)
+        {
+            x[i] = 10 * uniform(mt64);
+            y[i] = (uniform(mt64) < 0.9) ? -2 + 36 * uniform(mt64) : 2 + 3 * x[i] + noise(mt64);
+            vec.push_back(std::make_pair(x[i], y[i]));
+        }
+
+        unsigned long hypotheses = 2000;
+        double threshold = 1.5;
+        auto report = [&](const std::string &method, double ms, const pdd &thetas)
+        {
+            std::cout << std::setw(10) << size << std::setw(20) << method << std::setw(12) << ms << std::setw(16)
+                      << hypotheses / ms * 1000 << std::setw(12) << thetas.first << std::setw(12) << thetas.second
+                      << std::endl;
+        };
+
+        {
+            pdd thetas;
+            double ms = time_ms([&]() {
+                std::mt19937_64 draws(5489);
+                std::uniform_int_distribution<size_t> index(0, size - 1);
+                size_t best_inliers = 0;
+                for (unsigned long k = 0; k < hypotheses; k++)
+                {
+                    size_t i = index(draws), j = index(draws);
+                    if (vec[i].first == vec[j].first)
+                    {
+                        continue;
+                    }
+                    double t1 = (vec[j].second - vec[i].second) / (vec[j].first - vec[i].first);
+                    double t0 = vec[i].second - t1 * vec[i].first;
+                    size_t inliers = 0;
+                    for (const auto &xy : vec)
+                    {
+                        if (std::abs(xy.second - t0 - t1 * xy.first) <= threshold)
+                        {
+                            inliers++;
+                        }
+                    }
+                    if (inliers > best_inliers)
+                    {
+                        best_inliers = inliers;
+                        thetas = std::make_pair(t0, t1);
+                    }
+                }
+            });
+            report("naive (no refit)", ms, thetas);
+        }
+
+        const unsigned int thread_counts[] = {1, 2, 4, 8};
+        for (unsigned int threads : thread_counts)
+        {
+            lrgRansacSolverStrategy ransac(threshold);
+            double confidence = 0.999999999;
+            ransac.SetConfidence(confidence);
+            ransac.SetMaxHypotheses(hypotheses);
+            ransac.SetThreads(threads);
+            pdd thetas;
+            double ms = time_ms([&]() { thetas = ransac.FitData(x.data(), y.data(), size); });
+            report(std::to_string(threads) + " thread(s)", ms, thetas);
+        }
+    }
+    std::cout << "(hardware threads: " << lrgDefaultThreads() << ")" << std::endl << std::endl;
+}
+
+// K-fold cross-validation of 10^6 points. The naive version gathers the statistics of every training set
+// from the points (re-reading (K - 1) / K of the data per fold) and then scores the fold with another pass.
+static void benchmark_crossvalidation()
+{
+    std::cout << std::setw(10) << "folds" << std::setw(20) << "method" << std::setw(12) << "time [ms]"
+              << std::setw(16) << "mse" << std::endl;
+
+    unsigned int size = 1000000;
+    pdd_vector vec;
+    lrgLinearDataCreator data(2, 3, size, std::make_shared<pdd_vector>(vec));
+    vec = data.GetData();
+
+    const unsigned int fold_counts[] = {5, 10, 50};
+    for (unsigned int K : fold_counts)
+    {
+        double error = 0;
+        double ms = time_ms([&]() {
+            double squared_error = 0;
+            for (unsigned int k = 0; k < K; k++)
+            {
+                size_t begin = size_t(k) * size / K;
+                size_t end = size_t(k + 1) * size / K;
+                lrgSufficientStatistics training;
+                for (size_t i = 0; i < size; i++)
+                {
+                    if (i < begin || i >= end)
+                    {
+                        training.Add(vec[i].first, vec[i].second);
+                    }
+                }
+                double t1 = training.GetSxy() / training.GetSxx();
+                double t0 = training.GetMeanY() - t1 * training.GetMeanX();
+                for (size_t i = begin; i < end; i++)
+                {
+                    double residual = vec[i].second - t0 - t1 * vec[i].first;
+                    squared_error += residual * residual;
+                }
+            }
+            error = squared_error / size;
+        });
+        std::cout << std::setw(10) << K << std::setw(20) << "K refits" << std::setw(12) << ms << std::setw(16)
+                  << error << std::endl;
+
+        lrgCrossValidation validation(K);
+        ms = time_ms([&]() { error = validation.KFold(vec); });
+        std::cout << std::setw(10) << K << std::setw(20) << "subtracted" << std::setw(12) << ms << std::setw(16)
+                  << error << std::endl;
+    }
+
+    lrgCrossValidation validation;
+    double error = 0;
+    double ms = time_ms([&]() { error = validation.LeaveOneOut(vec); });
+    std::cout << std::setw(10) << size << std::setw(20) << "leave-one-out" << std::setw(12) << ms << std::setw(16)
+              << error << std::endl << std::endl;
+}
+
+// Bootstrap replicates of the line through 10^5 points. The naive version copies every resample into a new
+// pdd_vector and calls lrgNormalEquationSolverStrategy::FitData on it (200 replicates, it is slow).
+static void benchmark_bootstrap()
+{
+    std::cout << std::setw(20) << "method" << std::setw(12) << "replicates" << std::setw(12) << "time [ms]"
+              << std::setw(16) << "ms/replicate" << std::setw(12) << "se(t1)" << std::endl;
+
+    unsigned int size = 100000;
+    pdd_vector vec;
+    lrgLinearDataCreator data(2, 3, size, std::make_shared<pdd_vector>(vec));
+    vec = data.GetData();
+
+    auto report = [&](const std::string &method, unsigned int replicates, double ms, const std::vector<double> &t1)
+    {
+        double mean = 0, variance = 0;
+        for (double value : t1)
+        {
+            mean += value / t1.size();
+        }
+        for (double value : t1)
+        {
+            variance += (value - mean) * (value - mean) / (t1.size() - 1);
+        }
+        std::cout << std::setw(20) << method << std::setw(12) << replicates << std::setw(12) << ms << std::setw(16)
+                  << ms / replicates << std::setw(12) << std::sqrt(variance) << std::endl;
+    };
+
+    {
+        unsigned int replicates = 200;
+        std::vector<double> t1;
+        double ms = time_ms([&]() {
+            std::mt19937_64 mt64(5489);
+            std::uniform_int_distribution<size_t> distribution(0, size - 1);
+            lrgNormalEquationSolverStrategy normal;
+            for (unsigned int r = 0; r < replicates; r++)
+            {
+                pdd_vector resample;
+                for (unsigned int n = 0; n < size; n++)
+                {
+                    resample.push_back(vec[distribution(mt64)]);
+                }
+                t1.push_back(normal.FitData(resample).second);
+            }
+        });
+        report("copied resamples", replicates, ms, t1);
+    }
+
+    const unsigned int thread_counts[] = {1, 2, 4};
+    for (unsigned int threads : thread_counts)
+    {
+        unsigned int replicates = 1000;
+        lrgBootstrap bootstrap(replicates);
+        bootstrap.SetThreads(threads);
+        double ms = time_ms([&]() { bootstrap.FitData(vec); });
+        std::vector<double> t1;
+        for (auto &thetas : bootstrap.GetReplicates())
+        {
+            t1.push_back(thetas.second);
+        }
+        report(std::to_string(threads) + " thread(s)", replicates, ms, t1);
+    }
+
+    unsigned int replicates = 1000;
+    lrgBootstrap bootstrap(replicates);
+    bootstrap.FitData(vec);
+    std::pair<pdd, pdd> percentile = bootstrap.GetPercentileIntervals(0.95);
+    std::pair<pdd, pdd> bca = bootstrap.GetBCaIntervals(0.95);
+    std::cout << "95% t1 percentile: [" << percentile.second.first << ", " << percentile.second.second << "], BCa: ["
+              << bca.second.first << ", " << bca.second.second << "]" << std::endl;
+    std::cout << "(hardware threads: " << lrgDefaultThreads() << ")" << std::endl << std::endl;
+}
+
+static void benchmark_sweep()
+{
+    std::cout << std::setw(24) << "method" << std::setw(12) << "configs" << std::setw(14) << "iterations"
+              << std::setw(12) << "time [ms]" << std::setw(16) << "best loss" << std::endl;
+
+    unsigned int size = 1000000;
+    pdd_vector vec;
+    lrgLinearDataCreator data(2, 3, size, std::make_shared<pdd_vector>(vec));
+    vec = data.GetData();
+
+    auto configurations = lrgGradientDescentSweep::Grid({0.005, 0.01, 0.02, 0.05, 0.1, 0.2, 0.5, 1, 2}, {20000},
+                                                        {lrgUpdateRule::Plain, lrgUpdateRule::Momentum,
+                                                         lrgUpdateRule::Nesterov, lrgUpdateRule::Adam},
+                                                        {lrgPreconditioner::None, lrgPreconditioner::Standardise});
+    lrgSufficientStatistics stats(vec);
+    auto loss_of = [&](const pdd &thetas) { return stats.GetSquaredError(thetas) / stats.GetWeight(); };
+
+    // Every configuration on its own, each reading the data again.
+    {
+        double best = std::numeric_limits<double>::infinity();
+        unsigned long iterations = 0;
+        double ms = time_ms([&]() {
+            for (auto &configuration : configurations)
+            {
+                double eta = configuration.eta;
+                unsigned int max_iterations = configuration.iterations;
+                lrgGradientDescentSolverStrategy solver(eta, max_iterations);
+                solver.SetUpdateRule(configuration.rule);
+                solver.SetPreconditioner(configuration.preconditioner);
+                double loss = loss_of(solver.FitData(vec));
+                best = std::isfinite(loss) ? std::min(best, loss) : best;
+                iterations += solver.GetIterationsRun();
+            }
+        });
+        std::cout << std::setw(24) << "one fit per config" << std::setw(12) << configurations.size() << std::setw(14)
+                  << iterations << std::setw(12) << ms << std::setw(16) << best << std::endl;
+    }
+
+    // The shared statistics, every configuration run to the end.
+    {
+        double best = std::numeric_limits<double>::infinity();
+        unsigned long iterations = 0;
+        double ms = time_ms([&]() {
+            for (auto &configuration : configurations)
+            {
+                double eta = configuration.eta;
+                unsigned int max_iterations = configuration.iterations;
+                lrgGradientDescentSolverStrategy solver(eta, max_iterations);
+                solver.SetUpdateRule(configuration.rule);
+                solver.SetPreconditioner(configuration.preconditioner);
+                double loss = loss_of(solver.FitData(stats));
+                best = std::isfinite(loss) ? std::min(best, loss) : best;
+                iterations += solver.GetIterationsRun();
+            }
+        });
+        std::cout << std::setw(24) << "shared statistics" << std::setw(12) << configurations.size() << std::setw(14)
+                  << iterations << std::setw(12) << ms << std::setw(16) << best << std::endl;
+    }
+
+    // The sweep reads the data once and halves the configurations at every rung.
+    const unsigned int thread_counts[] = {1, 2, 4};
+    for (unsigned int threads : thread_counts)
+    {
+        lrgGradientDescentSweep sweep;
+        sweep.SetThreads(threads);
+        double ms = time_ms([&]() { sweep.Run(vec, configurations); });
+        std::cout << std::setw(24) << "sweep, " + std::to_string(threads) + " thread(s)" << std::setw(12)
+                  << configurations.size() << std::setw(14) << sweep.GetTotalIterations() << std::setw(12) << ms
+                  << std::setw(16) << sweep.GetBest().loss << std::endl;
+    }
+
+    lrgGradientDescentSweep sweep;
+    sweep.Run(stats, configurations);
+    const lrgSweepResult &best = sweep.GetBest();
+    unsigned int diverged = 0;
+    for (auto &result : sweep.GetLeaderboard())
+    {
+        diverged += result.diverged;
+    }
+    std::cout << "best: eta " << best.configuration.eta << ", rule " << int(best.configuration.rule)
+              << ", preconditioner " << int(best.configuration.preconditioner) << ", thetas (" << best.thetas.first
+              << ", " << best.thetas.second << "), " << diverged << " configurations diverged" << std::endl;
+    std::cout << "(hardware threads: " << lrgDefaultThreads() << ")" << std::endl << std::endl;
+}
+
+static void benchmark_sketch()
+{
+    std::cout << std::setw(28) << "method" << std::setw(12) << "time [ms]" << std::setw(16) << "|t0 error|"
+              << std::setw(16) << "|t1 error|" << std::setw(16) << "excess SSE" << std::endl;
+
+    // x far from zero makes the columns 1 and x almost parallel.
+    size_t size = 5000000;
+    std::mt19937_64 mt64(42);
+    std::uniform_real_distribution<double> uniform(100, 110);
+    std::normal_distribution<double> noise(0.0, 1.0);
+    std::vector<double> x(size), y(size);
+    for (size_t i = 0; i < size; i++)
+    {
+        x[i] = uniform(mt64);
+        y[i] = 2 + 3 * x[i] + noise(mt64);
+    }
+
+    // The exact line, and its sum of squared errors (long double, so the excess of the others shows).
+    lrgNormalEquationSolverStrategy normal;
+    pdd_vector exact;
+    double exact_ms = time_ms([&]() { exact = normal.FitData(x, y, 1); });
+    auto sse = [&](const pdd &thetas)
+    {
+        long double sum = 0;
+        for (size_t i = 0; i < size; i++)
+        {
+            long double r = (long double)(y[i]) - thetas.first - thetas.second * (long double)(x[i]);
+            sum += r * r;
+        }
+        return sum;
+    };
+    long double exact_sse = sse(exact[0]);
+
+    auto report = [&](const std::string &method, double ms, const pdd &thetas)
+    {
+        std::cout << std::setw(28) << method << std::setw(12) << ms << std::setw(16)
+                  << std::abs(thetas.first - exact[0].first) << std::setw(16) << std::abs(thetas.second - exact[0].second)
+                  << std::setw(16) << double((sse(thetas) - exact_sse) / exact_sse) << std::endl;
+    };
+    report("exact normal equation", exact_ms, exact[0]);
+
+    const unsigned int sketch_rows[] = {1024, 16384, 262144};
+    for (unsigned int rows : sketch_rows)
+    {
+        lrgSketchSolverStrategy sketch(rows);
+        pdd thetas;
+        double ms = time_ms([&]() { thetas = sketch.FitData(x.data(), y.data(), size); });
+        report("sketch, m = " + std::to_string(rows), ms, thetas);
+    }
+
+    const unsigned int refinements[] = {1, 10};
+    for (unsigned int iterations : refinements)
+    {
+        unsigned int rows = 1024;
+        lrgSketchSolverStrategy sketch(rows);
+        sketch.SetRefinement(iterations);
+        pdd thetas;
+        double ms = time_ms([&]() { thetas = sketch.FitData(x.data(), y.data(), size); });
+        report("m = 1024 + " + std::to_string(sketch.GetIterationsRun()) + " LSQR", ms, thetas);
+    }
+    std::cout << "(excess SSE: the relative excess over the exact sum of squared errors)" << std::endl << std::endl;
+}
+
+static void benchmark_mixed()
+{
+    std::cout << std::setw(16) << "data" << std::setw(24) << "method" << std::setw(14) << "ms/fit"
+              << std::setw(16) << "|t0 error|" << std::setw(16) << "|t1 error|" << std::setw(14) << "refinements"
+              << std::endl;
+
+    // The double path keeps X on the stack, so the data stay well below its limit.
+    unsigned int size = 200000;
+    unsigned int repeats = 20;
+    const double offsets[] = {0, 10000};
+    for (double offset : offsets)
+    {
+        std::mt19937_64 mt64(42);
+        std::uniform_real_distribution<double> uniform(offset, offset + 1);
+        std::normal_distribution<double> noise(0.0, 1.0);
+        pdd_vector vec(size);
+        for (auto &xy : vec)
+        {
+            xy.first = uniform(mt64);
+            xy.second = 2 + 3 * xy.first + noise(mt64);
+        }
+
+        // The exact line in long double, relative to the first point.
+        long double x0 = vec[0].first, y0 = vec[0].second;
+        long double sd = 0, sdd = 0, se = 0, sde = 0;
+        for (auto &xy : vec)
+        {
+            long double d = xy.first - x0, e = xy.second - y0;
+            sd += d;
+            sdd += d * d;
+            se += e;
+            sde += d * e;
+        }
+        long double b = (size * sde - sd * se) / (size * sdd - sd * sd);
+        long double a = (se - b * sd) / size;
+        pdd exact = std::make_pair(double(y0 + a - b * x0), double(b));
+
+        std::string data_name = (offset == 0) ? "x in [0, 1)" : "x in [1e4, 1e4+1)";
+        auto run = [&](const std::string &method, lrgNormalEquationSolverStrategy &normal)
+        {
+            pdd thetas;
+            double ms = time_ms([&]() {
+                for (unsigned int r = 0; r < repeats; r++)
+                {
+                    thetas = normal.FitData(vec);
+                }
+            });
+            std::cout << std::setw(16) << data_name << std::setw(24) << method << std::setw(14) << ms / repeats
+                      << std::setw(16) << std::abs(thetas.first - exact.first) << std::setw(16)
+                      << std::abs(thetas.second - exact.second) << std::setw(14) << normal.GetRefinementsRun()
+                      << std::endl;
+        };
+
+        lrgNormalEquationSolverStrategy all_double;
+        run("double", all_double);
+
+        // The other double path: the centred moments of lrgSufficientStatistics, one pass with a division per point.
+        {
+            pdd thetas;
+            double ms = time_ms([&]() {
+                for (unsigned int r = 0; r < repeats; r++)
+                {
+                    lrgSufficientStatistics stats(vec);
+                    double t1 = stats.GetSxy() / stats.GetSxx();
+                    thetas = std::make_pair(stats.GetMeanY() - t1 * stats.GetMeanX(), t1);
+                }
+            });
+            std::cout << std::setw(16) << data_name << std::setw(24) << "double, centred moments" << std::setw(14)
+                      << ms / repeats << std::setw(16) << std::abs(thetas.first - exact.first) << std::setw(16)
+                      << std::abs(thetas.second - exact.second) << std::setw(14) << 0 << std::endl;
+        }
+
+        unsigned int none = 0;
+        lrgNormalEquationSolverStrategy float_only;
+        float_only.SetPrecision(lrgPrecision::Mixed);
+        float_only.SetRefinement(none);
+        run("float, no refinement", float_only);
+
+        lrgNormalEquationSolverStrategy mixed;
+        mixed.SetPrecision(lrgPrecision::Mixed);
+        run("mixed, refined", mixed);
+    }
+    std::cout << std::endl;
+}
+
+static void benchmark_logistic()
+{
+    // The kernel: the fast exp and log1p against the library functions, on the same margins.
+    {
+        size_t size = 4000000;
+        std::mt19937_64 mt64(42);
+        std::normal_distribution<double> normal(0.0, 4.0);
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        std::vector<double> margins(size), labels(size), residuals(size), weights(size);
+        for (size_t i = 0; i < size; i++)
+        {
+            margins[i] = normal(mt64);
+            labels[i] = (uniform(mt64) < 0.5) ? 1 : 0;
+        }
+
+        double fast_loss = 0, library_loss = 0;
+        double fast_ms = time_ms([&]() {
+            fast_loss = lrgLogisticKernel(margins.data(), labels.data(), size, residuals.data(), weights.data());
+        });
+        double library_ms = time_ms([&]() {
+            for (size_t i = 0; i < size; i++)
+            {
+                double z = margins[i];
+                double e = std::exp(-std::abs(z));
+                double probability = ((z >= 0) ? 1.0 : e) / (1 + e);
+                residuals[i] = probability - labels[i];
+                weights[i] = probability * (1 - probability);
+                library_loss += std::max(z, 0.0) + std::log1p(e) - labels[i] * z;
+            }
+        });
+        std::cout << std::setw(24) << "kernel" << std::setw(16) << "Mrows/s" << std::setw(24) << "loss" << std::endl;
+        std::cout << std::setw(24) << "fast exp and log1p" << std::setw(16) << size / fast_ms / 1000 << std::setw(24)
+                  << std::setprecision(15) << fast_loss << std::setprecision(6) << std::endl;
+        std::cout << std::setw(24) << "std::exp and log1p" << std::setw(16) << size / library_ms / 1000
+                  << std::setw(24) << std::setprecision(15) << library_loss << std::setprecision(6) << std::endl
+                  << std::endl;
+    }
+
+    std::cout << std::setw(24) << "data" << std::setw(12) << "method" << std::setw(12) << "time [ms]"
+              << std::setw(12) << "iterations" << std::setw(20) << "loss" << std::endl;
+    auto report = [](const std::string &data, const std::string &method, double ms,
+                     const lrgLogisticRegressionSolverStrategy &logistic)
+    {
+        std::cout << std::setw(24) << data << std::setw(12) << method << std::setw(12) << ms << std::setw(12)
+                  << logistic.GetIterationsRun() << std::setw(20) << std::setprecision(12) << logistic.GetLoss()
+                  << std::setprecision(6) << std::endl;
+    };
+
+    // One feature, many samples.
+    {
+        pdd_vector vec;
+        lrgLogisticDataCreator data(-2, 4, 1000000, std::make_shared<pdd_vector>(vec));
+        vec = data.GetData();
+        const lrgLogisticMethod methods[] = {lrgLogisticMethod::Newton, lrgLogisticMethod::LBFGS};
+        for (auto method : methods)
+        {
+            lrgLogisticRegressionSolverStrategy logistic;
+            logistic.SetMethod(method);
+            double ms = time_ms([&]() { logistic.FitData(vec); });
+            report("1e6 x 1", (method == lrgLogisticMethod::Newton) ? "newton" : "lbfgs", ms, logistic);
+        }
+    }
+
+    // Many sparse features: 10 non-zeros per sample.
+    const int feature_counts[] = {50, 500, 5000};
+    for (int features : feature_counts)
+    {
+        int samples = 100000;
+        std::mt19937_64 mt64(7);
+        std::uniform_int_distribution<int> column(1, features);
+        std::normal_distribution<double> value(0.0, 1.0);
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        std::vector<Eigen::Triplet<double>> triplets;
+        lrgSparseDataset data;
+        data.y.resize(samples);
+        for (int i = 0; i < samples; i++)
+        {
+            triplets.push_back(Eigen::Triplet<double>(i, 0, 1));
+            double margin = 0;
+            for (int k = 0; k < 10; k++)
+            {
+                int j = column(mt64);
+                double v = value(mt64);
+                triplets.push_back(Eigen::Triplet<double>(i, j, v));
+                margin += ((j % 2) ? 0.5 : -0.5) * v;
+            }
+            data.y(i) = (uniform(mt64) < 1 / (1 + std::exp(-margin))) ? 1 : 0;
+        }
+        data.X.resize(samples, features + 1);
+        data.X.setFromTriplets(triplets.begin(), triplets.end());
+
+        const lrgLogisticMethod methods[] = {lrgLogisticMethod::Newton, lrgLogisticMethod::LBFGS};
+        for (auto method : methods)
+        {
+            // Newton's p x p Hessian is out of the question for the largest.
+            if (method == lrgLogisticMethod::Newton && features > 1000)
+            {
+                continue;
+            }
+            double lambda = 1e-4;
+            lrgLogisticRegressionSolverStrategy logistic(lambda);
+            logistic.SetMethod(method);
+            double ms = time_ms([&]() { logistic.FitData(data); });
+            report("1e5 x " + std::to_string(features) + " sparse", (method == lrgLogisticMethod::Newton) ? "newton" : "lbfgs",
+                   ms, logistic);
+        }
+    }
+    std::cout << std::endl;
+}
+
+static void benchmark_predict()
+{
+    size_t rows = 4000000;
+    int repeats = 5;
+    std::mt19937_64 mt64(42);
+    std::normal_distribution<double> normal(0.0, 2.0);
+    std::vector<double> x(rows), y(rows);
+    for (auto &value : x)
+    {
+        value = normal(mt64);
+    }
+    pdd thetas = std::make_pair(-0.5, 1.25);
+
+    std::cout << std::setw(28) << "prediction" << std::setw(16) << "Mrows/s" << std::setw(16) << "checksum"
+              << std::endl;
+    auto report = [&](const std::string &name, size_t scored, double ms)
+    {
+        double checksum = 0;
+        for (double value : y)
+        {
+            checksum += value;
+        }
+        std::cout << std::setw(28) << name << std::setw(16) << scored / ms / 1000 << std::setw(16) << checksum
+                  << std::endl;
+    };
+
+    // What every consumer wrote before: one call per row.
+    {
+        lrgLinearModel model(thetas);
+        double ms = time_ms([&]() {
+            for (int r = 0; r < repeats; r++)
+            {
+                for (size_t i = 0; i < rows; i++)
+                {
+                    y[i] = model.Predict(x[i]);
+                }
+            }
+        });
+        report("one row at a time", rows * repeats, ms);
+    }
+
+    // The batch kernel into the same buffer, on 1 to 4 threads.
+    const unsigned int thread_counts[] = {1, 2, 4};
+    const lrgLink links[] = {lrgLink::Identity, lrgLink::Logistic};
+    for (lrgLink link : links)
+    {
+        for (unsigned int threads : thread_counts)
+        {
+            lrgLinearModel model(thetas, link);
+            model.SetThreads(threads);
+            double ms = time_ms([&]() {
+                for (int r = 0; r < repeats; r++)
+                {
+                    model.Predict(x.data(), rows, y.data());
+                }
+            });
+            report(std::string((link == lrgLink::Identity) ? "batch" : "logistic batch") + ", " +
+                   std::to_string(threads) + "t", rows * repeats, ms);
+        }
+    }
+
+    // Streaming: text in, text out, a block at a time.
+    {
+        size_t lines = 1000000;
+        std::stringstream text;
+        text << std::setprecision(17);
+        for (size_t i = 0; i < lines; i++)
+        {
+            text << x[i] << "\n";
+        }
+        std::string input = text.str();
+        lrgLinearModel model(thetas);
+        size_t scored = 0;
+        double ms = time_ms([&]() {
+            std::istringstream in(input);
+            std::ostringstream out;
+            scored = model.PredictStream(in, out);
+        });
+        std::fill(y.begin(), y.end(), 0.0);
+        model.Predict(x.data(), lines, y.data());
+        report("stream", scored, ms);
+    }
+    std::cout << "(hardware threads: " << lrgDefaultThreads() << ")" << std::endl << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    int returnStatus = EXIT_FAILURE;
+
+    if (argc != 2 && argc != 3)
+    {
+        how_to_use(argv[0]);
+        return 1;
+    }
+
+    std::string benchmark = argv[1];
+    std::string dir = (argc == 3) ? argv[2] : "../Testing/TestFiles";
+
+    try
+    {
+        if (benchmark == "optimisers")
+        {
+            benchmark_optimisers("TestData1.txt", load_file(dir + "/TestData1.txt"), 0.1);
+            benchmark_optimisers("TestData2.txt", load_file(dir + "/TestData2.txt"), 0.1);
+            benchmark_optimisers("Ill-conditioned, x in [10, 11)", shifted_data(1000, 10), 0.004);
+        }
+        else if (benchmark == "preconditioners")
+        {
+            benchmark_preconditioners("TestData1.txt", load_file(dir + "/TestData1.txt"), 0.1);
+            benchmark_preconditioners("TestData2.txt", load_file(dir + "/TestData2.txt"), 0.1);
+            benchmark_preconditioners("Ill-conditioned, x in [10, 11)", shifted_data(1000, 10), 0.004);
+        }
+        else if (benchmark == "cg")
+        {
+            benchmark_cg();
+        }
+        else if (benchmark == "lasso")
+        {
+            benchmark_lasso();
+        }
+        else if (benchmark == "path")
+        {
+            benchmark_path();
+        }
+        else if (benchmark == "rls")
+        {
+            benchmark_rls();
+        }
+        else if (benchmark == "window")
+        {
+            benchmark_window();
+        }
+        else if (benchmark == "grouped")
+        {
+            benchmark_grouped();
+        }
+        else if (benchmark == "batched")
+        {
+            benchmark_batched();
+        }
+        else if (benchmark == "multitarget")
+        {
+            benchmark_multitarget();
+        }
+        else if (benchmark == "basis")
+        {
+            benchmark_basis();
+        }
+        else if (benchmark == "robust")
+        {
+            benchmark_robust();
+        }
+        else if (benchmark == "theilsen")
+        {
+            benchmark_theilsen();
+        }
+        else if (benchmark == "ransac")
+        {
+            benchmark_ransac();
+        }
+        else if (benchmark == "crossvalidation")
+        {
+            benchmark_crossvalidation();
+        }
+        else if (benchmark == "bootstrap")
+        {
+            benchmark_bootstrap();
+        }
+        else if (benchmark == "sweep")
+    {
+        benchmark_sweep();
+    }
+    else if (benchmark == "sketch")
+    {
+        benchmark_sketch();
+    }
+    else if (benchmark == "mixed")
+    {
+        benchmark_mixed();
+    }
+    else if (benchmark == "logistic")
+    {
+        benchmark_logistic();
+    }
+    else if (benchmark == "predict")
+    {
+        benchmark_predict();
+    }
+    else if (benchmark == "warmstart")
+        {
+            benchmark_warmstart("TestData1.txt", load_file(dir + "/TestData1.txt"), 0.1);
+            benchmark_warmstart("Ill-conditioned, x in [10, 11)", shifted_data(1000, 10), 0.004);
+        }
+        else
+        {
+            how_to_use(argv[0]);
+            return 1;
+        }
+
+        returnStatus = EXIT_SUCCESS;
+    }
+    catch (lrg::Exception &e)
+    {
+        std::cerr << "Caught lrg::Exception: " << e.GetDescription() << std::endl;
+    }
+    catch (std::exception &e)
+    {
+        std::cerr << "Caught std::exception: " << e.what() << std::endl;
+    }
+
+    return returnStatus;
+}
@@ -1,9 +1,26 @@
 #include <lrgExceptionMacro.h>
 #include <iostream>
 #include <fstream>
+#include <algorithm>
 #include "lrgNormalEquationSolverStrategy.h"
 #include "lrgGradientDescentSolverStrategy.h"
+#include "lrgConjugateGradientSolverStrategy.h"
+#include "lrgCoordinateDescentSolverStrategy.h"
+#include "lrgRecursiveLeastSquares.h"
+#include "lrgSlidingWindowRegression.h"
+#include "lrgGroupedRegression.h"
+#include "lrgBasisRegression.h"
+#include "lrgRobustSolverStrategy.h"
+#include "lrgTheilSenSolverStrategy.h"
+#include "lrgRansacSolverStrategy.h"
+#include "lrgSketchSolverStrategy.h"
+#include "lrgLogisticRegressionSolverStrategy.h"
+#include "lrgBootstrap.h"
+#include "lrgLinearModel.h"
 #include "lrgFileLoaderDataCreator.h"
+#include "lrgSparseFileLoader.h"
+#include "lrgSparseNormalEquationSolverStrategy.h"
+#include "lrgSparseStochasticGradientSolverStrategy.h"
 
 // A function that shows how to use the app in the command line.
 // Inspiration was taken from the official cplusplus website.
@@ -13,15 +30,235 @@ static void how_to_use(std::string app)
               << "Options:\n"
               << "\t-h,--help\t\t\tShows how to set the command line arguments.\n"
               << "\t-f,--file FILE\t\t\tSpecify the absolute path of the input file.\n"
-              << "\t-s,--solver SOLVER\t\tSpecify the solver (normal or gradient)\n\n"
+              << "\t-s,--solver SOLVER\t\tSpecify the solver (normal, gradient, cg, lasso, rls, window,\n"
+              << "\t\t\t\t\tbasis, huber, tukey, theilsen, ransac, sketch or logistic)\n"
+              << "\t\t\t\t\tFor libsvm files: normal, cg, sgd or logistic.\n"
+              << "\t\t\t\t\tThe logistic solver needs labels (0 and 1, or -1 and 1) as y-values.\n"
+              << "\t-t,--format FORMAT\t\tSpecify the format of the input file (xy, xyw, xyy, kxy or libsvm).\n"
+              << "\t\t\t\t\tDefault: xy.\n"
+              << "\t\t\t\t\txyw files have a third column with the weight of every sample\n"
+              << "\t\t\t\t\t(solvers: normal, gradient or rls).\n"
+              << "\t\t\t\t\txyy files have several y columns and get one fit per column\n"
+              << "\t\t\t\t\t(solver: normal).\n"
+              << "\t\t\t\t\tkxy files start every line with an integer key and get one fit\n"
+              << "\t\t\t\t\tper key (solver: normal).\n\n"
               << "\t-e,--eta ETA\t\t\tSpecify the eta parameter for the gradient solver.\n"
-              << "\t-i,--iterations ITERATIONS\tSpecify the iterations for the gradient solver.\n\n"
+              << "\t\t\t\t\tUse auto to derive it from X^T X or backtracking for a line search.\n"
+              << "\t-i,--iterations ITERATIONS\tSpecify the iterations for the gradient solver\n"
+              << "\t\t\t\t\t(or the maximum iterations for the cg solver, or the most\n"
+              << "\t\t\t\t\tLSQR iterations of the sketch solver, or the most iterations\n"
+              << "\t\t\t\t\tof the logistic solver).\n"
+              << "\t-u,--update RULE\t\tSpecify the update rule for the gradient solver\n"
+              << "\t\t\t\t\t(plain, momentum, nesterov, adam or bb). Default: plain.\n"
+              << "\t-p,--precondition PRECONDITIONER\tSpecify the preconditioner for the gradient solver\n"
+              << "\t\t\t\t\t(none, standardise or jacobi). Default: none.\n"
+              << "\t\t\t\t\tThe cg solver supports none and jacobi.\n"
+              << "\t-l,--lambda LAMBDA\t\tSpecify the penalty for the lasso solver (the L2 penalty for the\n"
+              << "\t\t\t\t\tlogistic solver). Default: 0.\n"
+              << "\t-a,--alpha ALPHA\t\tSpecify the share of the L1 penalty for the lasso solver\n"
+              << "\t\t\t\t\t(1 is lasso, 0 is ridge, in between is elastic net). Default: 1.\n"
+              << "\t-r,--forget FACTOR\t\tSpecify the forgetting factor in (0, 1] for the rls solver. Default: 1.\n"
+              << "\t-w,--window W\t\t\tSpecify the number of points of the window solver. Default: 100.\n"
+              << "\t\t\t\t\tIt prints the thetas of every window of W consecutive points.\n"
+              << "\t-c,--tuning C\t\t\tSpecify the tuning constant of the huber and tukey solvers.\n"
+              << "\t\t\t\t\tDefault: 1.345 (huber) and 4.685 (tukey).\n"
+              << "\t\t\t\t\tFor ransac, the largest residual of an inlier. Default: automatic.\n"
+              << "\t-m,--pairs N\t\t\tSpecify the random pairs of the theilsen solver. Default: 0, which\n"
+              << "\t\t\t\t\tuses every pair (exact). The pairs are drawn on -j threads.\n"
+              << "\t-n,--bootstrap R\t\tPrint 95% percentile and BCa intervals of the normal solver's thetas\n"
+              << "\t\t\t\t\tfrom R bootstrap replicates (on -j threads). Default: 0 (none).\n"
+              << "\t-b,--basis BASIS\t\tSpecify the features of the basis solver (polynomial, bspline or linear).\n"
+              << "\t\t\t\t\tDefault: polynomial.\n"
+              << "\t-d,--degree DEGREE\t\tSpecify the degree of the basis solver. Default: 3.\n"
+              << "\t-k,--knots KNOTS\t\tSpecify the interior knots of the spline bases. Default: 10.\n"
+              << "\t-j,--threads N\t\t\tSpecify the number of threads for kxy files, sampled theilsen pairs,\n"
+              << "\t\t\t\t\transac and large -x batches.\n"
+              << "\t\t\t\t\tDefault: one per core.\n"
+              << "\t-x,--predict FILE\t\tScore the x-values of FILE (the first value of every line) with the\n"
+              << "\t\t\t\t\tfitted line, one prediction per line (solvers: normal, or logistic for\n"
+              << "\t\t\t\t\tprobabilities). Files of any size are streamed.\n"
+              << "\t-o,--output FILE\t\tWrite the fits of a kxy file, or the predictions of -x, to FILE instead\n"
+              << "\t\t\t\t\tof the screen.\n\n"
               << "Examples: Inside the build directory run in command line\n"
               << "./bin/lrgFitDataApp -f <filepath> -s normal\n"
               << "./bin/lrgFitDataApp -f <filepath> -s gradient -e 0.1 -i 1000\n"
+              << "./bin/lrgFitDataApp -f <filepath> -s gradient -e 0.1 -i 1000 -u nesterov\n"
+              << "./bin/lrgFitDataApp -f <filepath> -s gradient -e auto -i 1000\n"
+              << "./bin/lrgFitDataApp -f <filepath> -s normal -n 10000\n"
+              << "./bin/lrgFitDataApp -f <filepath> -s cg\n"
+              << "./bin/lrgFitDataApp -f <filepath> -s lasso -l 0.1 -a 0.5\n"
+              << "./bin/lrgFitDataApp -f <filepath> -s rls -r 0.99\n"
+              << "./bin/lrgFitDataApp -f <filepath> -s window -w 20\n"
+              << "./bin/lrgFitDataApp -f <filepath> -s tukey\n"
+              << "./bin/lrgFitDataApp -f <filepath> -s theilsen -m 1000000 -j 4\n"
+              << "./bin/lrgFitDataApp -f <filepath> -s ransac -c 1.5 -j 4\n"
+              << "./bin/lrgFitDataApp -f <filepath> -s sketch -i 2\n"
+              << "./bin/lrgFitDataApp -f <filepath> -s basis -b bspline -d 3 -k 10\n"
+              << "./bin/lrgFitDataApp -f <filepath> -t libsvm -s sgd -e 0.01 -i 100\n"
+              << "./bin/lrgFitDataApp -f <filepath> -s logistic\n"
+              << "./bin/lrgFitDataApp -f <filepath> -s normal -x <new x-values> -o predictions.txt\n"
+              << "./bin/lrgFitDataApp -f <filepath> -t libsvm -s logistic -l 0.001\n"
+              << "./bin/lrgFitDataApp -f <filepath> -t xyw -s normal\n"
+              << "./bin/lrgFitDataApp -f <filepath> -t xyy -s normal\n"
+              << "./bin/lrgFitDataApp -f <filepath> -t kxy -s normal -j 4 -o fits.txt\n"
               << std::endl;
 }
 
+// Fits a file in the sparse libsvm format and prints all the thetas.
+// iterations are the epochs of the sgd solver or the maximum iterations of the cg and logistic solvers.
+static void fit_sparse_file(std::string &filepath, std::string &solver, double eta, unsigned int iterations,
+                            std::string &precondition, double lambda)
+{
+    lrgSparseFileLoader loader(filepath);
+    lrgSparseDataset data = loader.GetData();
+
+    std::unique_ptr<lrgSparseLinearModelSolverStrategyI> strategy;
+    if (solver == "normal")
+    {
+        strategy = std::make_unique<lrgSparseNormalEquationSolverStrategy>();
+    }
+    else if (solver == "cg")
+    {
+        auto cg = std::make_unique<lrgConjugateGradientSolverStrategy>();
+        if (iterations != 0)
+        {
+            cg->SetIterations(iterations);
+        }
+        cg->SetPreconditioning(precondition == "jacobi");
+        strategy = std::move(cg);
+    }
+    else if (solver == "sgd")
+    {
+        strategy = std::make_unique<lrgSparseStochasticGradientSolverStrategy>(eta, iterations);
+    }
+    else if (solver == "logistic")
+    {
+        auto logistic = std::make_unique<lrgLogisticRegressionSolverStrategy>(lambda);
+        logistic->SetIterations(iterations);
+        strategy = std::move(logistic);
+    }
+    else
+    {
+        throw std::invalid_argument("Invalid solver for libsvm files...");
+    }
+
+    Eigen::VectorXd thetas = strategy->FitData(data);
+    for (int j = 0; j < thetas.size(); j++)
+    {
+        std::cout << (j > 0 ? ", " : "") << "t" << j << ": " << thetas(j);
+    }
+    std::cout << std::endl;
+}
+
+// Fits a file with a weight column (weighted least squares).
+static void fit_weighted_file(std::string &filepath, std::string &solver, std::unique_ptr<lrgGradientDescentSolverStrategy> gradient,
+                              double forgetting_factor)
+{
+    pdd_vector vec;
+    lrgFileLoaderDataCreator data(filepath, std::make_shared<pdd_vector>(vec));
+    weighted_vector samples = data.GetWeightedData();
+
+    pdd thetas;
+    if (solver == "normal")
+    {
+        lrgNormalEquationSolverStrategy normal;
+        thetas = normal.FitData(samples);
+    }
+    else if (solver == "gradient")
+    {
+        thetas = gradient->FitData(samples);
+    }
+    else if (solver == "rls")
+    {
+        lrgRecursiveLeastSquares rls(forgetting_factor);
+        for (const auto &sample : samples)
+        {
+            rls.Update(sample.x, sample.y, sample.weight);
+        }
+        thetas = rls.GetThetas();
+    }
+    else
+    {
+        throw std::invalid_argument("Invalid solver for xyw files...");
+    }
+    std::cout << "t0: " << thetas.first << ", t1: " << thetas.second << std::endl;
+}
+
+// Fits every y column of a file with several targets against the same x-values.
+static void fit_multi_target_file(std::string &filepath, std::string &solver)
+{
+    if (solver != "normal")
+    {
+        throw std::invalid_argument("Invalid solver for xyy files...");
+    }
+
+    pdd_vector vec;
+    lrgFileLoaderDataCreator data(filepath, std::make_shared<pdd_vector>(vec));
+    std::vector<double> x, targets;
+    size_t target_count = data.GetMultiTargetData(x, targets);
+
+    lrgNormalEquationSolverStrategy normal;
+    pdd_vector thetas = normal.FitData(x, targets, target_count);
+    for (size_t t = 0; t < target_count; t++)
+    {
+        std::cout << "y" << t + 1 << ": t0: " << thetas[t].first << ", t1: " << thetas[t].second << std::endl;
+    }
+}
+
+// Fits a file with a key column, one line per key. Every output line is "key n t0 t1".
+static void fit_grouped_file(std::string &filepath, std::string &solver, unsigned int threads, std::string &output)
+{
+    if (solver != "normal")
+    {
+        throw std::invalid_argument("Invalid solver for kxy files...");
+    }
+
+    lrgGroupedRegression grouped;
+    if (threads > 0)
+    {
+        grouped.SetThreads(threads);
+    }
+    std::vector<lrgGroupFit> fits = grouped.FitFile(filepath);
+
+    std::ofstream output_file;
+    if (! output.empty())
+    {
+        output_file.open(output, std::ios::out);
+        if (! output_file.good())
+        {
+            throw std::ios_base::failure("Writing file failed...");
+        }
+    }
+    std::ostream &out = output.empty() ? std::cout : output_file;
+    for (const auto &fit : fits)
+    {
+        out << fit.key << " " << fit.weight << " " << fit.t0 << " " << fit.t1 << "\n";
+    }
+    out.flush();
+}
+
+// Scores the x-values of the file predict (the first value of every line) with the fitted thetas and writes one
+// prediction per line to output, or to the screen.
+static void predict_file(pdd &thetas, lrgLink link, std::string &predict, unsigned int threads, std::string &output)
+{
+    lrgLinearModel model(thetas, link);
+    if (threads > 0)
+    {
+        model.SetThreads(threads);
+    }
+    if (! output.empty())
+    {
+        model.PredictFile(predict, output);
+        return;
+    }
+    std::ifstream input(predict, std::ios::in);
+    if (! input)
+    {
+        throw std::ios_base::failure("Reading file failed...");
+    }
+    model.PredictStream(input, std::cout);
+}
+
 int main(int argc, char **argv)
 {
     int returnStatus = EXIT_FAILURE;
@@ -49,9 +286,12 @@ int main(int argc, char **argv)
     // 8. The --iterations/-i tag.
     // 9. The number of iterations (<iterations>) 
 
+    // Every further option (e.g. --update/-u) adds another pair of a tag and a value,
+    // so apart from the --help case the number of arguments is always odd.
+
     // In any other case respond with the help message.
 
-    if (argc != 2 && argc != 5 && argc != 9)
+    if (argc != 2 && (argc < 5 || argc % 2 == 0))
     {
         how_to_use(argv[0]);
         return 1;
@@ -61,7 +301,24 @@ int main(int argc, char **argv)
     std::string solver;
     std::string arg;
     double eta = 0;
+    lrgStepSize step_size = lrgStepSize::Fixed;
     unsigned int iterations = 0;    
+    std::string update = "plain";
+    std::string precondition = "none";
+    std::string format = "xy";
+    double lambda = 0;
+    double alpha = 1;
+    double forgetting_factor = 1;
+    unsigned int window = 100;
+    unsigned int threads = 0;
+    std::string basis = "polynomial";
+    double tuning = 0;
+    unsigned long pairs = 0;
+    unsigned int replicates = 0;
+    unsigned int degree = 3;
+    unsigned int knots = 10;
+    std::string output;
+    std::string predict;
 
     // Iterator starts from one to check the options and skips the app's name.
     for (size_t i = 1; i < argc; i++)
@@ -100,8 +357,21 @@ int main(int argc, char **argv)
             if (i + 1 < argc)
             {
                 // use ++i to take the solver name instead of the option parameter.
+                // eta is either a keyword for the step size mode or a number.
                 // Convert string to double with atof()
-                eta = std::atof(argv[++i]);
+                std::string value = argv[++i];
+                if (value == "auto")
+                {
+                    step_size = lrgStepSize::Auto;
+                }
+                else if (value == "backtracking")
+                {
+                    step_size = lrgStepSize::Backtracking;
+                }
+                else
+                {
+                    eta = std::atof(value.c_str());
+                }
             }
         }
         else if ((arg == "-i") || (arg == "--iterations"))
@@ -114,15 +384,177 @@ int main(int argc, char **argv)
                 iterations = std::atoi(argv[++i]);
             }
         }
+        else if ((arg == "-u") || (arg == "--update"))
+        {
+            //Check that there is a rule after the --update/-u option.
+            if (i + 1 < argc)
+            {
+                update = argv[++i];
+            }
+        }
+        else if ((arg == "-t") || (arg == "--format"))
+        {
+            //Check that there is a format after the --format/-t option.
+            if (i + 1 < argc)
+            {
+                format = argv[++i];
+            }
+        }
+        else if ((arg == "-p") || (arg == "--precondition"))
+        {
+            //Check that there is a preconditioner after the --precondition/-p option.
+            if (i + 1 < argc)
+            {
+                precondition = argv[++i];
+            }
+        }
+        else if ((arg == "-l") || (arg == "--lambda"))
+        {
+            //Check that there is a value after the --lambda/-l option.
+            if (i + 1 < argc)
+            {
+                lambda = std::atof(argv[++i]);
+            }
+        }
+        else if ((arg == "-a") || (arg == "--alpha"))
+        {
+            //Check that there is a value after the --alpha/-a option.
+            if (i + 1 < argc)
+            {
+                alpha = std::atof(argv[++i]);
+            }
+        }
+        else if ((arg == "-r") || (arg == "--forget"))
+        {
+            //Check that there is a value after the --forget/-r option.
+            if (i + 1 < argc)
+            {
+                forgetting_factor = std::atof(argv[++i]);
+            }
+        }
+        else if ((arg == "-w") || (arg == "--window"))
+        {
+            //Check that there is a value after the --window/-w option.
+            if (i + 1 < argc)
+            {
+                window = std::atoi(argv[++i]);
+            }
+        }
+        else if ((arg == "-c") || (arg == "--tuning"))
+        {
+            //Check that there is a value after the --tuning/-c option.
+            if (i + 1 < argc)
+            {
+                tuning = std::atof(argv[++i]);
+            }
+        }
+        else if ((arg == "-m") || (arg == "--pairs"))
+        {
+            //Check that there is a value after the --pairs/-m option.
+            if (i + 1 < argc)
+            {
+                pairs = std::strtoul(argv[++i], nullptr, 10);
+            }
+        }
+        else if ((arg == "-n") || (arg == "--bootstrap"))
+        {
+            //Check that there is a value after the --bootstrap/-n option.
+            if (i + 1 < argc)
+            {
+                replicates = std::atoi(argv[++i]);
+            }
+        }
+        else if ((arg == "-b") || (arg == "--basis"))
+        {
+            //Check that there is a basis after the --basis/-b option.
+            if (i + 1 < argc)
+            {
+                basis = argv[++i];
+            }
+        }
+        else if ((arg == "-d") || (arg == "--degree"))
+        {
+            //Check that there is a value after the --degree/-d option.
+            if (i + 1 < argc)
+            {
+                degree = std::atoi(argv[++i]);
+            }
+        }
+        else if ((arg == "-k") || (arg == "--knots"))
+        {
+            //Check that there is a value after the --knots/-k option.
+            if (i + 1 < argc)
+            {
+                knots = std::atoi(argv[++i]);
+            }
+        }
+        else if ((arg == "-j") || (arg == "--threads"))
+        {
+            //Check that there is a value after the --threads/-j option.
+            if (i + 1 < argc)
+            {
+                threads = std::atoi(argv[++i]);
+            }
+        }
+        else if ((arg == "-o") || (arg == "--output"))
+        {
+            //Check that there is a path after the --output/-o option.
+            if (i + 1 < argc)
+            {
+                output = argv[++i];
+            }
+        }
+        else if ((arg == "-x") || (arg == "--predict"))
+        {
+            //Check that there is a path after the --predict/-x option.
+            if (i + 1 < argc)
+            {
+                predict = argv[++i];
+            }
+        }
     }
 
-    //Check if the solver has the right values (gradient or normal).
-    if(! (solver == "normal" || solver == "gradient")){
+    //Check if the solver has the right values (gradient, normal, cg, lasso, rls, window, basis, huber, tukey, theilsen,
+    //ransac, sketch, logistic or sgd).
+    if(! (solver == "normal" || solver == "gradient" || solver == "cg" || solver == "lasso" || solver == "rls" ||
+          solver == "window" || solver == "basis" || solver == "huber" || solver == "tukey" || solver == "theilsen" ||
+          solver == "ransac" || solver == "sketch" || solver == "logistic" ||
+          solver == "sgd")){
         std::cerr << "Invalid arguments for --solver." << std::endl;
     }
 
     try
     {
+        // Sparse files have their own loader and solvers.
+        if (format == "libsvm")
+        {
+            fit_sparse_file(filepath, solver, eta, iterations, precondition, lambda);
+            return EXIT_SUCCESS;
+        }
+        else if (format == "xyw")
+        {
+            auto gradient = std::make_unique<lrgGradientDescentSolverStrategy>(eta, iterations);
+            gradient->SetUpdateRule(lrgUpdateRuleFromString(update));
+            gradient->SetPreconditioner(lrgPreconditionerFromString(precondition));
+            gradient->SetStepSize(step_size);
+            fit_weighted_file(filepath, solver, std::move(gradient), forgetting_factor);
+            return EXIT_SUCCESS;
+        }
+        else if (format == "xyy")
+        {
+            fit_multi_target_file(filepath, solver);
+            return EXIT_SUCCESS;
+        }
+        else if (format == "kxy")
+        {
+            fit_grouped_file(filepath, solver, threads, output);
+            return EXIT_SUCCESS;
+        }
+        else if (format != "xy")
+        {
+            throw std::invalid_argument("Invalid file format...");
+        }
+
         // A variable that stores the number of lines in the file. 
         // It is usefull to check if the file was read correctly.
         int num_lines = 0;
@@ -188,6 +620,26 @@ int main(int argc, char **argv)
             std::unique_ptr<lrgLinearModelSolverStrategyI> solver = std::make_unique<lrgNormalEquationSolverStrategy>(strategy);
             pdd thetas = solver->FitData(vec);
             std::cout << "t0: " << thetas.first << ", t1: " << thetas.second << std::endl;
+            if (! predict.empty())
+            {
+                predict_file(thetas, lrgLink::Identity, predict, threads, output);
+            }
+
+            if (replicates > 0)
+            {
+                lrgBootstrap bootstrap(replicates);
+                if (threads > 0)
+                {
+                    bootstrap.SetThreads(threads);
+                }
+                bootstrap.FitData(vec);
+                std::pair<pdd, pdd> percentile = bootstrap.GetPercentileIntervals(0.95);
+                std::pair<pdd, pdd> bca = bootstrap.GetBCaIntervals(0.95);
+                std::cout << "95% percentile: t0: [" << percentile.first.first << ", " << percentile.first.second
+                          << "], t1: [" << percentile.second.first << ", " << percentile.second.second << "]" << std::endl;
+                std::cout << "95% BCa: t0: [" << bca.first.first << ", " << bca.first.second << "], t1: ["
+                          << bca.second.first << ", " << bca.second.second << "]" << std::endl;
+            }
         }
         // use FitData() of lrgGradientDescentSolverStrategy.
         else if (solver == "gradient")
@@ -195,10 +647,143 @@ int main(int argc, char **argv)
             // In that case we can use unique pointers.
             // This is a another case of how polymorphism can be used.
             lrgGradientDescentSolverStrategy strategy(eta, iterations);
+            strategy.SetUpdateRule(lrgUpdateRuleFromString(update));
+            strategy.SetPreconditioner(lrgPreconditionerFromString(precondition));
+            strategy.SetStepSize(step_size);
             std::unique_ptr<lrgLinearModelSolverStrategyI> solver = std::make_unique<lrgGradientDescentSolverStrategy>(strategy);
             pdd thetas = solver->FitData(vec);
             std::cout << "t0: " << thetas.first << ", t1: " << thetas.second << std::endl;
         }
+        // use FitData() of lrgConjugateGradientSolverStrategy.
+        else if (solver == "cg")
+        {
+            lrgConjugateGradientSolverStrategy strategy;
+            if (iterations != 0)
+            {
+                strategy.SetIterations(iterations);
+            }
+            if (precondition != "none" && precondition != "jacobi")
+            {
+                throw std::invalid_argument("The cg solver supports the none and jacobi preconditioners...");
+            }
+            strategy.SetPreconditioning(precondition == "jacobi");
+            std::unique_ptr<lrgLinearModelSolverStrategyI> solver = std::make_unique<lrgConjugateGradientSolverStrategy>(strategy);
+            pdd thetas = solver->FitData(vec);
+            std::cout << "t0: " << thetas.first << ", t1: " << thetas.second << std::endl;
+        }
+        // use FitData() of lrgCoordinateDescentSolverStrategy.
+        else if (solver == "lasso")
+        {
+            lrgCoordinateDescentSolverStrategy strategy(lambda, alpha);
+            if (iterations != 0)
+            {
+                strategy.SetIterations(iterations);
+            }
+            std::unique_ptr<lrgLinearModelSolverStrategyI> solver = std::make_unique<lrgCoordinateDescentSolverStrategy>(strategy);
+            pdd thetas = solver->FitData(vec);
+            std::cout << "t0: " << thetas.first << ", t1: " << thetas.second << std::endl;
+        }
+        // use FitData() of lrgRecursiveLeastSquares.
+        else if (solver == "rls")
+        {
+            std::unique_ptr<lrgLinearModelSolverStrategyI> solver = std::make_unique<lrgRecursiveLeastSquares>(forgetting_factor);
+            pdd thetas = solver->FitData(vec);
+            std::cout << "t0: " << thetas.first << ", t1: " << thetas.second << std::endl;
+        }
+        // use FitWindows() of lrgSlidingWindowRegression, one line per window.
+        else if (solver == "window")
+        {
+            lrgSlidingWindowRegression sliding(window);
+            pdd_vector thetas = sliding.FitWindows(vec);
+            for (size_t k = 0; k < thetas.size(); k++)
+            {
+                std::cout << "window " << k << ": t0: " << thetas[k].first << ", t1: " << thetas[k].second << std::endl;
+            }
+        }
+        // Robust regression. Without -c the usual tuning constant of the loss.
+        else if (solver == "huber" || solver == "tukey")
+        {
+            lrgRobustLoss loss = lrgRobustLossFromString(solver);
+            std::unique_ptr<lrgLinearModelSolverStrategyI> robust = (tuning == 0)
+                ? std::make_unique<lrgRobustSolverStrategy>(loss)
+                : std::make_unique<lrgRobustSolverStrategy>(loss, tuning);
+            pdd thetas = robust->FitData(vec);
+            std::cout << "t0: " << thetas.first << ", t1: " << thetas.second << std::endl;
+        }
+        // Theil-Sen: every pair of points, or -m random pairs drawn on -j threads.
+        else if (solver == "theilsen")
+        {
+            lrgTheilSenSolverStrategy theil_sen;
+            theil_sen.SetSampledPairs(pairs);
+            if (threads > 0)
+            {
+                theil_sen.SetThreads(threads);
+            }
+            pdd thetas = theil_sen.FitData(vec);
+            std::cout << "t0: " << thetas.first << ", t1: " << thetas.second << std::endl;
+        }
+        // RANSAC. Without -c the threshold is measured from the data.
+        else if (solver == "ransac")
+        {
+            std::unique_ptr<lrgRansacSolverStrategy> ransac = (tuning == 0)
+                ? std::make_unique<lrgRansacSolverStrategy>()
+                : std::make_unique<lrgRansacSolverStrategy>(tuning);
+            if (threads > 0)
+            {
+                ransac->SetThreads(threads);
+            }
+            pdd thetas = ransac->FitData(vec);
+            std::cout << "t0: " << thetas.first << ", t1: " << thetas.second << std::endl;
+            std::cout << "inliers: " << ransac->GetInliers() << " of " << vec.size() << ", hypotheses: "
+                      << ransac->GetHypotheses() << std::endl;
+        }
+        // Sketch-and-solve, refined by -i LSQR iterations.
+        else if (solver == "sketch")
+        {
+            lrgSketchSolverStrategy sketch;
+            sketch.SetRefinement(iterations);
+            pdd thetas = sketch.FitData(vec);
+            std::cout << "t0: " << thetas.first << ", t1: " << thetas.second << std::endl;
+            std::cout << "LSQR iterations: " << sketch.GetIterationsRun() << std::endl;
+        }
+        // Logistic regression on labels, with the share of the points on the right side of the boundary.
+        else if (solver == "logistic")
+        {
+            lrgLogisticRegressionSolverStrategy logistic(lambda);
+            logistic.SetIterations(iterations);
+            pdd thetas = logistic.FitData(vec);
+            size_t right = 0;
+            for (auto &xy : vec)
+            {
+                right += ((thetas.first + thetas.second * xy.first > 0) == (xy.second > 0));
+            }
+            std::cout << "t0: " << thetas.first << ", t1: " << thetas.second << std::endl;
+            std::cout << "log loss: " << logistic.GetLoss() << ", accuracy: " << double(right) / vec.size()
+                      << ", iterations: " << logistic.GetIterationsRun() << std::endl;
+            if (! predict.empty())
+            {
+                predict_file(thetas, lrgLink::Logistic, predict, threads, output);
+            }
+        }
+        // The basis features cover the range of the x-values in the file.
+        else if (solver == "basis")
+        {
+            auto range = std::minmax_element(vec.begin(), vec.end());
+            double lower = range.first->first;
+            double upper = range.second->first;
+            lrgBasisExpansion expansion(lrgBasisFromString(basis), degree, knots, lower, upper);
+            lrgBasisRegression regression(expansion);
+            std::vector<double> thetas = regression.FitData(vec);
+            for (size_t k = 0; k < thetas.size(); k++)
+            {
+                std::cout << (k > 0 ? ", " : "") << "t" << k << ": " << thetas[k];
+            }
+            std::cout << std::endl;
+        }
+        else if (solver == "sgd")
+        {
+            throw std::invalid_argument("The sgd solver needs a libsvm file (--format libsvm)...");
+        }
         
         
         returnStatus = EXIT_SUCCESS;
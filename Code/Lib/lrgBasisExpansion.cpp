@@ -0,0 +1,145 @@
+#include "lrgBasisExpansion.h"
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+
+// Converts a command line keyword to the basis.
+lrgBasis lrgBasisFromString(const std::string &name)
+{
+    if (name == "polynomial")
+    {
+        return lrgBasis::Polynomial;
+    }
+    else if (name == "bspline")
+    {
+        return lrgBasis::BSpline;
+    }
+    else if (name == "linear")
+    {
+        return lrgBasis::PiecewiseLinear;
+    }
+    throw std::invalid_argument("Invalid basis: " + name);
+}
+
+lrgBasisExpansion::lrgBasisExpansion(lrgBasis basis, unsigned int &degree, unsigned int &knots, double &lower,
+                                     double &upper)
+{
+    if (! (lower < upper))
+    {
+        throw std::invalid_argument("The range of x must have lower < upper...");
+    }
+    // Evaluate() keeps the features of one x on the stack.
+    if (degree > 30)
+    {
+        throw std::invalid_argument("The degree can be at most 30...");
+    }
+    m_basis = basis;
+    m_degree = (basis == lrgBasis::PiecewiseLinear) ? 1 : degree;
+    m_knots = (basis == lrgBasis::Polynomial) ? 0 : knots;
+    m_lower = lower;
+    m_upper = upper;
+    m_spacing = (upper - lower) / (m_knots + 1);
+
+    // Clamped knots: lower and upper repeated degree + 1 times, the interior knots equally spaced in between.
+    // Unlike knots that simply continue past the ends, every B-spline then has a fair share of the range
+    // and X^T X stays well conditioned for high degrees.
+    m_knot_vector.resize(m_knots + 2 * m_degree + 2);
+    for (size_t j = 0; j < m_knot_vector.size(); j++)
+    {
+        long k = static_cast<long>(j) - static_cast<long>(m_degree);
+        k = std::min<long>(std::max<long>(k, 0), m_knots + 1);
+        m_knot_vector[j] = (k == static_cast<long>(m_knots) + 1) ? upper : lower + k * m_spacing;
+    }
+}
+
+lrgBasisExpansion::lrgBasisExpansion()
+{
+    m_basis = lrgBasis::Polynomial;
+    m_degree = 1;
+    m_knots = 0;
+    m_lower = 0;
+    m_upper = 1;
+    m_spacing = 1;
+}
+
+// Destructor
+lrgBasisExpansion::~lrgBasisExpansion() {}
+
+lrgBasis lrgBasisExpansion::GetBasis() const
+{
+    return m_basis;
+}
+
+unsigned int lrgBasisExpansion::GetDegree() const
+{
+    return m_degree;
+}
+
+size_t lrgBasisExpansion::GetSize() const
+{
+    return m_knots + m_degree + 1;
+}
+
+size_t lrgBasisExpansion::GetWidth() const
+{
+    return m_degree + 1;
+}
+
+size_t lrgBasisExpansion::Evaluate(double x, double *values) const
+{
+    if (m_basis == lrgBasis::Polynomial)
+    {
+        // T_0 = 1, T_1 = u, T_k = 2u T_(k-1) - T_(k-2).
+        double u = (2 * x - m_lower - m_upper) / (m_upper - m_lower);
+        values[0] = 1;
+        if (m_degree > 0)
+        {
+            values[1] = u;
+        }
+        for (unsigned int k = 2; k <= m_degree; k++)
+        {
+            values[k] = 2 * u * values[k - 1] - values[k - 2];
+        }
+        return 0;
+    }
+
+    // x lies in the piece span (between the knots span + degree and span + degree + 1) and the non-zero
+    // B-splines are span, ..., span + degree. Points outside the range use the first or the last piece.
+    long span = static_cast<long>(std::floor((x - m_lower) / m_spacing));
+    span = std::min<long>(std::max<long>(span, 0), m_knots);
+    const double *t = m_knot_vector.data() + span + m_degree;
+
+    // The triangular Cox-de Boor recursion ("The NURBS Book", algorithm A2.2).
+    double left[32], right[32];
+    values[0] = 1;
+    for (unsigned int j = 1; j <= m_degree; j++)
+    {
+        left[j] = x - t[1 - static_cast<long>(j)];
+        right[j] = t[j] - x;
+        double saved = 0;
+        for (unsigned int r = 0; r < j; r++)
+        {
+            double temp = values[r] / (right[r + 1] + left[j - r]);
+            values[r] = saved + right[r + 1] * temp;
+            saved = left[j - r] * temp;
+        }
+        values[j] = saved;
+    }
+    return static_cast<size_t>(span);
+}
+
+double lrgBasisExpansion::Predict(const std::vector<double> &thetas, double x) const
+{
+    if (thetas.size() != GetSize())
+    {
+        throw std::invalid_argument("There must be one theta for every feature...");
+    }
+    double values[32];
+    size_t first = Evaluate(x, values);
+    double result = 0;
+    for (size_t a = 0; a < GetWidth(); a++)
+    {
+        result += thetas[first + a] * values[a];
+    }
+    return result;
+}
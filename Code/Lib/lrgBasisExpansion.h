@@ -0,0 +1,64 @@
+#ifndef lrgBasisExpansion_h
+#define lrgBasisExpansion_h
+#include <string>
+#include <vector>
+#include <cstddef>
+
+// The functions of x that a basis expansion turns into features.
+enum class lrgBasis
+{
+    Polynomial,     // all polynomials up to the degree
+    BSpline,        // splines of the degree with equally spaced knots
+    PiecewiseLinear // continuous straight pieces between equally spaced knots (B-splines of degree 1)
+};
+
+// Converts the command line keywords (polynomial, bspline, linear) to an lrgBasis.
+lrgBasis lrgBasisFromString(const std::string &name);
+
+// Expands a single x-value into the features of a basis, without storing any of them.
+// [lower, upper] is the range of the data. x-values outside it are allowed (the fit is extrapolated).
+//
+// The polynomial features are the Chebyshev polynomials T_0, ..., T_degree of x scaled to [-1, 1].
+// They span the same polynomials as 1, x, ..., x^degree, but the normal equation stays well conditioned
+// for high degrees. The thetas therefore belong to the Chebyshev polynomials; use Predict() to evaluate the fit.
+//
+// The spline features are clamped B-splines with knots equally spaced interior knots between lower and upper.
+// Only degree + 1 of them are non-zero at any x, so X^T X is banded.
+class lrgBasisExpansion
+{
+private:
+    lrgBasis m_basis;
+    unsigned int m_degree;
+    unsigned int m_knots;
+    double m_lower;
+    double m_upper;
+    double m_spacing;
+    std::vector<double> m_knot_vector;
+
+public:
+    // knots is the number of interior knots of the splines. The polynomial basis does not use it, and the
+    // piecewise linear basis does not use the degree.
+    lrgBasisExpansion(lrgBasis basis, unsigned int &degree, unsigned int &knots, double &lower, double &upper);
+
+    // Empty constructor. A straight line on [0, 1], the same model as the other solvers.
+    lrgBasisExpansion();
+    ~lrgBasisExpansion();
+
+    lrgBasis GetBasis() const;
+    unsigned int GetDegree() const;
+
+    // The number of features p.
+    size_t GetSize() const;
+
+    // The number of features that can be non-zero at a single x.
+    size_t GetWidth() const;
+
+    // Writes the GetWidth() features of x that can be non-zero into values and returns the index of the first one.
+    // All the other features of x are zero.
+    size_t Evaluate(double x, double *values) const;
+
+    // The value of the fitted function at x.
+    double Predict(const std::vector<double> &thetas, double x) const;
+};
+
+#endif
@@ -0,0 +1,182 @@
+#include "lrgBasisRegression.h"
+#include "lrgParallel.h"
+#include <Eigen/Dense>
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+
+// The rows of a polynomial tile. Tile x features stays in the L1/L2 cache.
+static const size_t tile_rows = 256;
+
+// Adds the points [0, size) to the upper triangle of gram (p x p, column-major) and to rhs.
+static void accumulate(const lrgBasisExpansion &basis, const double *x, const double *y, size_t size,
+                       double *gram, double *rhs)
+{
+    size_t p = basis.GetSize();
+    Eigen::Map<Eigen::MatrixXd> G(gram, p, p);
+    Eigen::Map<Eigen::VectorXd> b(rhs, p);
+
+    if (basis.GetBasis() == lrgBasis::Polynomial)
+    {
+        // Every feature is non-zero: expand a tile, then G += F F^T and b += F y as matrix products.
+        Eigen::MatrixXd features(p, std::min(tile_rows, size));
+        for (size_t begin = 0; begin < size; begin += tile_rows)
+        {
+            size_t rows = std::min(tile_rows, size - begin);
+            for (size_t i = 0; i < rows; i++)
+            {
+                basis.Evaluate(x[begin + i], features.col(i).data());
+            }
+            auto tile = features.leftCols(rows);
+            G.selfadjointView<Eigen::Upper>().rankUpdate(tile);
+            b.noalias() += tile * Eigen::Map<const Eigen::VectorXd>(y + begin, rows);
+        }
+        return;
+    }
+
+    // Splines: only the band around the non-zero features changes.
+    size_t width = basis.GetWidth();
+    double values[32];
+    for (size_t i = 0; i < size; i++)
+    {
+        size_t first = basis.Evaluate(x[i], values);
+        for (size_t c = 0; c < width; c++)
+        {
+            double *column = gram + (first + c) * p + first;
+            double value = values[c];
+            for (size_t r = 0; r <= c; r++)
+            {
+                column[r] += values[r] * value;
+            }
+            rhs[first + c] += value * y[i];
+        }
+    }
+}
+
+lrgBasisRegression::lrgBasisRegression(const lrgBasisExpansion &basis) : m_basis(basis)
+{
+    m_threads = 1;
+    Reset();
+}
+
+// Empty constructor. A straight line.
+lrgBasisRegression::lrgBasisRegression() : lrgBasisRegression(lrgBasisExpansion()) {}
+
+// Destructor
+lrgBasisRegression::~lrgBasisRegression() {}
+
+void lrgBasisRegression::SetThreads(unsigned int &threads)
+{
+    if (threads == 0)
+    {
+        throw std::invalid_argument("At least one thread is needed...");
+    }
+    m_threads = threads;
+}
+
+const lrgBasisExpansion &lrgBasisRegression::GetBasis() const
+{
+    return m_basis;
+}
+
+void lrgBasisRegression::Add(double x, double y)
+{
+    accumulate(m_basis, &x, &y, 1, m_gram.data(), m_rhs.data());
+    m_count++;
+}
+
+// Every thread accumulates its own part of the points, the small p x p sums are added up at the end.
+void lrgBasisRegression::Add(const double *x, const double *y, size_t size)
+{
+    size_t p = m_basis.GetSize();
+    unsigned int threads = (size < 16 * tile_rows) ? 1 : m_threads;
+    if (threads == 1)
+    {
+        accumulate(m_basis, x, y, size, m_gram.data(), m_rhs.data());
+    }
+    else
+    {
+        std::vector<std::vector<double>> grams(threads, std::vector<double>(p * p, 0));
+        std::vector<std::vector<double>> rhss(threads, std::vector<double>(p, 0));
+        lrgParallelFor(threads, size, [&](unsigned int thread, size_t begin, size_t end)
+        {
+            accumulate(m_basis, x + begin, y + begin, end - begin, grams[thread].data(), rhss[thread].data());
+        });
+        for (unsigned int thread = 0; thread < threads; thread++)
+        {
+            for (size_t k = 0; k < p * p; k++)
+            {
+                m_gram[k] += grams[thread][k];
+            }
+            for (size_t k = 0; k < p; k++)
+            {
+                m_rhs[k] += rhss[thread][k];
+            }
+        }
+    }
+    m_count += size;
+}
+
+void lrgBasisRegression::Add(const pdd_vector &vec)
+{
+    // Split the pairs into two columns a tile at a time, so Add() above sees contiguous arrays.
+    const size_t chunk = 1 << 16;
+    std::vector<double> x, y;
+    for (size_t begin = 0; begin < vec.size(); begin += chunk)
+    {
+        size_t end = std::min(vec.size(), begin + chunk);
+        x.resize(end - begin);
+        y.resize(end - begin);
+        for (size_t i = begin; i < end; i++)
+        {
+            x[i - begin] = vec[i].first;
+            y[i - begin] = vec[i].second;
+        }
+        Add(x.data(), y.data(), end - begin);
+    }
+}
+
+void lrgBasisRegression::Reset()
+{
+    size_t p = m_basis.GetSize();
+    m_gram.assign(p * p, 0);
+    m_rhs.assign(p, 0);
+    m_count = 0;
+}
+
+size_t lrgBasisRegression::GetCount() const
+{
+    return m_count;
+}
+
+std::vector<double> lrgBasisRegression::GetThetas() const
+{
+    if (m_count == 0)
+    {
+        throw std::length_error("Vector is empty...");
+    }
+
+    size_t p = m_basis.GetSize();
+    Eigen::Map<const Eigen::MatrixXd> G(m_gram.data(), p, p);
+    Eigen::Map<const Eigen::VectorXd> b(m_rhs.data(), p);
+    Eigen::MatrixXd gram = G.selfadjointView<Eigen::Upper>();
+    Eigen::LDLT<Eigen::MatrixXd> ldlt(gram);
+
+    // Too few points (or a spline piece without points) leave X^T X singular.
+    Eigen::VectorXd solution = ldlt.solve(b);
+    double smallest = ldlt.vectorD().cwiseAbs().minCoeff();
+    double largest = ldlt.vectorD().cwiseAbs().maxCoeff();
+    if (ldlt.info() != Eigen::Success || ! (smallest > 1e-13 * largest) || ! solution.allFinite())
+    {
+        throw std::logic_error("Invalid values for thetas...");
+    }
+
+    return std::vector<double>(solution.data(), solution.data() + p);
+}
+
+std::vector<double> lrgBasisRegression::FitData(const pdd_vector &vec)
+{
+    Reset();
+    Add(vec);
+    return GetThetas();
+}
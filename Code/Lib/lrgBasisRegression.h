@@ -0,0 +1,47 @@
+#ifndef lrgBasisRegression_h
+#define lrgBasisRegression_h
+#include "lrgLinearModelSolverStrategyI.h"
+#include "lrgBasisExpansion.h"
+#include <vector>
+#include <cstddef>
+
+// Least squares on the features of a lrgBasisExpansion, y = sum_k thetas_k * f_k(x).
+// The features of every point are generated inside the loop that accumulates X^T X and X^T y and are
+// thrown away straight after, so the expanded N x p matrix never exists: the memory is O(p^2) for any N.
+// Points can be added in any number of calls (e.g. a file read in chunks) before GetThetas() solves.
+//
+// The polynomial features are expanded a tile of rows at a time and added to X^T X with a blocked
+// rank-k update. For splines only the (degree + 1) x (degree + 1) block of the non-zero features
+// is updated for every point.
+class lrgBasisRegression
+{
+private:
+    lrgBasisExpansion m_basis;
+    unsigned int m_threads;
+    size_t m_count;
+    std::vector<double> m_gram;
+    std::vector<double> m_rhs;
+
+public:
+    lrgBasisRegression(const lrgBasisExpansion &basis);
+    lrgBasisRegression();
+    ~lrgBasisRegression();
+
+    // The threads used by Add() for arrays of points. Default: 1.
+    void SetThreads(unsigned int &threads);
+    const lrgBasisExpansion &GetBasis() const;
+
+    void Add(double x, double y);
+    void Add(const double *x, const double *y, size_t size);
+    void Add(const pdd_vector &vec);
+    void Reset();
+    size_t GetCount() const;
+
+    // Solves the normal equation of all the points added so far. One theta per feature.
+    std::vector<double> GetThetas() const;
+
+    // Reset(), Add(vec) and GetThetas() in one go.
+    std::vector<double> FitData(const pdd_vector &vec);
+};
+
+#endif
@@ -0,0 +1,135 @@
+#include "lrgBatchedRegression.h"
+#include "lrgParallel.h"
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <stdexcept>
+
+// Fits the models order[0], ..., order[Lanes - 1] (all of them valid, shortest first).
+static void fit_batch(const size_t *order, const size_t *offsets, const double *x, const double *y,
+                      double *t0, double *t1)
+{
+    const size_t L = lrgBatchedRegression::Lanes;
+    size_t start[L], size[L];
+    double x0[L], y0[L], sx[L], sy[L], sxx[L], sxy[L];
+    for (size_t l = 0; l < L; l++)
+    {
+        start[l] = offsets[order[l]];
+        size[l] = offsets[order[l] + 1] - start[l];
+        x0[l] = (size[l] > 0) ? x[start[l]] : 0;
+        y0[l] = (size[l] > 0) ? y[start[l]] : 0;
+        sx[l] = sy[l] = sxx[l] = sxy[l] = 0;
+    }
+
+    // All the lanes have at least size[0] points. Lane l of step i reads point i of its own dataset,
+    // and the four sums of the lanes sit side by side in the registers.
+    size_t common = size[0];
+    for (size_t i = 0; i < common; i++)
+    {
+        for (size_t l = 0; l < L; l++)
+        {
+            double dx = x[start[l] + i] - x0[l];
+            double dy = y[start[l] + i] - y0[l];
+            sx[l] += dx;
+            sy[l] += dy;
+            sxx[l] += dx * dx;
+            sxy[l] += dx * dy;
+        }
+    }
+
+    // The longer datasets finish on their own.
+    for (size_t l = 1; l < L; l++)
+    {
+        for (size_t i = common; i < size[l]; i++)
+        {
+            double dx = x[start[l] + i] - x0[l];
+            double dy = y[start[l] + i] - y0[l];
+            sx[l] += dx;
+            sy[l] += dy;
+            sxx[l] += dx * dx;
+            sxy[l] += dx * dy;
+        }
+    }
+
+    // Solve all the lanes at once. In the shifted units y - y0 = a + t1 * (x - x0).
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    for (size_t l = 0; l < L; l++)
+    {
+        double n = size[l];
+        double mean_x = sx[l] / n;
+        double mean_y = sy[l] / n;
+        double var_x = sxx[l] - sx[l] * mean_x;
+        double cov_xy = sxy[l] - sx[l] * mean_y;
+        double slope = (n > 1 && var_x > 0) ? cov_xy / var_x : nan;
+        t1[order[l]] = slope;
+        t0[order[l]] = y0[l] + mean_y - slope * (mean_x + x0[l]);
+    }
+}
+
+// threads is the number of threads that share the batches.
+lrgBatchedRegression::lrgBatchedRegression(unsigned int &threads)
+{
+    m_threads = 1;
+    SetThreads(threads);
+}
+
+// Empty constructor. One thread per hardware thread.
+lrgBatchedRegression::lrgBatchedRegression()
+{
+    m_threads = lrgDefaultThreads();
+}
+
+// Destructor
+lrgBatchedRegression::~lrgBatchedRegression() {}
+
+void lrgBatchedRegression::SetThreads(unsigned int &threads)
+{
+    if (threads == 0)
+    {
+        throw std::invalid_argument("At least one thread is needed...");
+    }
+    m_threads = threads;
+}
+
+pdd_vector lrgBatchedRegression::FitData(const lrgPackedDatasets &datasets)
+{
+    size_t count = datasets.GetCount();
+    std::vector<double> t0(count), t1(count);
+    FitData(datasets, t0.data(), t1.data());
+
+    pdd_vector thetas(count);
+    for (size_t k = 0; k < count; k++)
+    {
+        thetas[k] = std::make_pair(t0[k], t1[k]);
+    }
+    return thetas;
+}
+
+void lrgBatchedRegression::FitData(const lrgPackedDatasets &datasets, double *t0, double *t1)
+{
+    size_t count = datasets.GetCount();
+    if (count == 0)
+    {
+        throw std::length_error("There are no datasets...");
+    }
+    const size_t *offsets = datasets.GetOffsets().data();
+
+    // Datasets of similar size go into the same batch, so the lanes finish together.
+    // The last batch is padded with copies of the last dataset, which only rewrite its own thetas.
+    size_t batches = (count + Lanes - 1) / Lanes;
+    std::vector<size_t> order(batches * Lanes, 0);
+    std::iota(order.begin(), order.begin() + count, 0);
+    std::stable_sort(order.begin(), order.begin() + count,
+                     [&](size_t a, size_t b) { return datasets.GetSize(a) < datasets.GetSize(b); });
+    std::fill(order.begin() + count, order.end(), order[count - 1]);
+
+    const double *x = datasets.GetX().data();
+    const double *y = datasets.GetY().data();
+    lrgParallelFor(std::min<size_t>(m_threads, batches), batches, [&](unsigned int, size_t begin, size_t end)
+    {
+        for (size_t b = begin; b < end; b++)
+        {
+            fit_batch(&order[b * Lanes], offsets, x, y, t0, t1);
+        }
+    });
+}
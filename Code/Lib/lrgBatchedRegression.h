@@ -0,0 +1,33 @@
+#ifndef lrgBatchedRegression_h
+#define lrgBatchedRegression_h
+#include "lrgPackedDatasets.h"
+
+// Fits a straight line to every dataset of a lrgPackedDatasets, for thousands of small datasets at once.
+// Nothing is allocated and nothing is called per dataset. The datasets are taken Lanes at a time and the
+// inner loop runs over the lanes, so every SIMD register holds the sums of several models.
+// The threads split the batches of Lanes models between them.
+//
+// The sums are taken relative to the first point of every dataset (shifted data), which keeps the
+// single-pass sums accurate when the values sit far from zero.
+// Datasets with fewer than two distinct x-values have no fit, their thetas are NaN.
+class lrgBatchedRegression
+{
+public:
+    static const size_t Lanes = 8;
+
+    lrgBatchedRegression(unsigned int &threads);
+    lrgBatchedRegression();
+    ~lrgBatchedRegression();
+    void SetThreads(unsigned int &threads);
+
+    // The thetas (t0, t1) of every dataset, in the same order as the datasets.
+    pdd_vector FitData(const lrgPackedDatasets &datasets);
+
+    // The same, written into caller buffers of GetCount() values each.
+    void FitData(const lrgPackedDatasets &datasets, double *t0, double *t1);
+
+private:
+    unsigned int m_threads;
+};
+
+#endif
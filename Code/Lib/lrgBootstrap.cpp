@@ -0,0 +1,334 @@
+#include "lrgBootstrap.h"
+#include "lrgParallel.h"
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+// The standard normal distribution function.
+static double normal_cdf(double z)
+{
+    return 0.5 * std::erfc(-z / std::sqrt(2.0));
+}
+
+// Its inverse: Acklam's rational approximation (relative error 1e-9), polished with one Halley step.
+static double normal_quantile(double p)
+{
+    static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                               1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+    static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                               6.680131188771972e+01, -1.328068155288572e+01};
+    static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                               -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+    static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                               3.754408661907416e+00};
+    double x;
+    if (p < 0.02425 || p > 1 - 0.02425)
+    {
+        double q = std::sqrt(-2 * std::log(std::min(p, 1 - p)));
+        x = (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+            ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1);
+        x = (p < 0.5) ? x : -x;
+    }
+    else
+    {
+        double q = p - 0.5;
+        double r = q * q;
+        x = (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+            (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1);
+    }
+    double e = normal_cdf(x) - p;
+    double u = e * 2.5066282746310002 * std::exp(x * x / 2);
+    return x - u / (1 + x * u / 2);
+}
+
+// The p-quantile of sorted values, interpolated between neighbours.
+static double quantile(const std::vector<double> &sorted, double p)
+{
+    double position = std::min(std::max(p, 0.0), 1.0) * (sorted.size() - 1);
+    size_t below = size_t(position);
+    if (below + 1 >= sorted.size())
+    {
+        return sorted.back();
+    }
+    double share = position - below;
+    return sorted[below] * (1 - share) + sorted[below + 1] * share;
+}
+
+// The acceleration of the BCa interval from the jackknife (leave-one-out) values.
+static double acceleration(const std::vector<double> &jackknife)
+{
+    double mean = 0;
+    size_t count = 0;
+    for (double value : jackknife)
+    {
+        if (std::isfinite(value))
+        {
+            mean += value;
+            count++;
+        }
+    }
+    if (count == 0)
+    {
+        return 0;
+    }
+    mean /= count;
+    double squares = 0, cubes = 0;
+    for (double value : jackknife)
+    {
+        if (std::isfinite(value))
+        {
+            double difference = mean - value;
+            squares += difference * difference;
+            cubes += difference * difference * difference;
+        }
+    }
+    return (squares > 0) ? cubes / (6 * std::pow(squares, 1.5)) : 0;
+}
+
+// The line through moments relative to (mean_x, mean_y), or NaNs if all the x-values are the same.
+static pdd solve_moments(double s, double sx, double sy, double sxx, double sxy, double mean_x, double mean_y)
+{
+    double centre_x = sx / s;
+    double variance = sxx / s - centre_x * centre_x;
+    if (! (variance > 1e-12 * sxx / s))
+    {
+        double nan = std::numeric_limits<double>::quiet_NaN();
+        return std::make_pair(nan, nan);
+    }
+    double t1 = (sxy / s - centre_x * sy / s) / variance;
+    return std::make_pair(mean_y + sy / s - t1 * (mean_x + centre_x), t1);
+}
+
+// Adds N draws of a point (uniform, with replacement) to the counts. Below 2^32 points every 64-bit number
+// gives two draws with Lemire's multiply-and-shift, which rejects the rare values that would bias it.
+static void draw_counts(std::mt19937_64 &mt64, size_t N, std::vector<unsigned int> &counts)
+{
+    if (N >= (1ULL << 32))
+    {
+        std::uniform_int_distribution<size_t> distribution(0, N - 1);
+        for (size_t n = 0; n < N; n++)
+        {
+            counts[distribution(mt64)]++;
+        }
+        return;
+    }
+    unsigned long long range = N;
+    unsigned long long threshold = (0x100000000ULL - range) % range;
+    size_t drawn = 0;
+    while (drawn < N)
+    {
+        unsigned long long bits = mt64();
+        for (int half = 0; half < 2 && drawn < N; half++)
+        {
+            unsigned long long product = (half == 0 ? (bits & 0xffffffffULL) : (bits >> 32)) * range;
+            if ((product & 0xffffffffULL) >= threshold)
+            {
+                counts[product >> 32]++;
+                drawn++;
+            }
+        }
+    }
+}
+
+lrgBootstrap::lrgBootstrap(unsigned int &replicates) : lrgBootstrap()
+{
+    if (replicates == 0)
+    {
+        throw std::invalid_argument("At least one replicate is needed...");
+    }
+    m_replicates = replicates;
+}
+
+lrgBootstrap::lrgBootstrap()
+{
+    m_replicates = 1000;
+    m_threads = lrgDefaultThreads();
+    m_seed = 5489;
+    m_estimate = std::make_pair(0.0, 0.0);
+    m_acceleration = std::make_pair(0.0, 0.0);
+}
+
+lrgBootstrap::~lrgBootstrap()
+{
+}
+
+void lrgBootstrap::SetThreads(unsigned int &threads)
+{
+    if (threads == 0)
+    {
+        throw std::invalid_argument("The number of threads must be positive...");
+    }
+    m_threads = threads;
+}
+
+void lrgBootstrap::SetSeed(unsigned long seed)
+{
+    m_seed = seed;
+}
+
+pdd lrgBootstrap::FitData(const pdd_vector &vec)
+{
+    if (vec.empty())
+    {
+        throw std::length_error("Vector is empty...");
+    }
+
+    // The points relative to their means, once.
+    size_t N = vec.size();
+    double mean_x = 0, mean_y = 0;
+    for (auto &xy : vec)
+    {
+        mean_x += xy.first;
+        mean_y += xy.second;
+    }
+    mean_x /= N;
+    mean_y /= N;
+    std::vector<double> dx(N), dy(N);
+    double sx = 0, sy = 0, sxx = 0, sxy = 0;
+    for (size_t i = 0; i < N; i++)
+    {
+        dx[i] = vec[i].first - mean_x;
+        dy[i] = vec[i].second - mean_y;
+        sx += dx[i];
+        sy += dy[i];
+        sxx += dx[i] * dx[i];
+        sxy += dx[i] * dy[i];
+    }
+    m_samples.clear();
+    m_estimate = solve_moments(N, sx, sy, sxx, sxy, mean_x, mean_y);
+    if (std::isnan(m_estimate.second))
+    {
+        throw std::logic_error("Invalid values for thetas...");
+    }
+
+    // The leave-one-out lines for the acceleration: the moments of all the points minus one.
+    std::vector<double> jackknife_t0(N), jackknife_t1(N);
+    for (size_t i = 0; i < N; i++)
+    {
+        pdd thetas = (N > 1) ? solve_moments(N - 1, sx - dx[i], sy - dy[i], sxx - dx[i] * dx[i], sxy - dx[i] * dy[i],
+                                             mean_x, mean_y)
+                             : m_estimate;
+        jackknife_t0[i] = thetas.first;
+        jackknife_t1[i] = thetas.second;
+    }
+    m_acceleration = std::make_pair(acceleration(jackknife_t0), acceleration(jackknife_t1));
+
+    std::vector<pdd> samples(m_replicates);
+    lrgParallelFor(m_threads, m_replicates, [&](unsigned int, size_t begin, size_t end)
+    {
+        // How often every point was drawn, back to zero after every replicate.
+        std::vector<unsigned int> counts(N, 0);
+        for (size_t r = begin; r < end; r++)
+        {
+            std::seed_seq sequence{(unsigned int)(m_seed), (unsigned int)(m_seed >> 32), (unsigned int)(r)};
+            std::mt19937_64 mt64(sequence);
+            draw_counts(mt64, N, counts);
+
+            double r_sx = 0, r_sy = 0, r_sxx = 0, r_sxy = 0;
+            for (size_t i = 0; i < N; i++)
+            {
+                double weight = counts[i];
+                counts[i] = 0;
+                double wx = weight * dx[i];
+                r_sx += wx;
+                r_sy += weight * dy[i];
+                r_sxx += wx * dx[i];
+                r_sxy += wx * dy[i];
+            }
+            samples[r] = solve_moments(N, r_sx, r_sy, r_sxx, r_sxy, mean_x, mean_y);
+        }
+    });
+
+    for (auto &sample : samples)
+    {
+        if (! std::isnan(sample.second))
+        {
+            m_samples.push_back(sample);
+        }
+    }
+    return m_estimate;
+}
+
+const std::vector<pdd> &lrgBootstrap::GetReplicates() const
+{
+    return m_samples;
+}
+
+pdd lrgBootstrap::GetStandardErrors() const
+{
+    if (m_samples.size() < 2)
+    {
+        throw std::logic_error("Not enough bootstrap replicates...");
+    }
+    double mean_t0 = 0, mean_t1 = 0;
+    for (auto &sample : m_samples)
+    {
+        mean_t0 += sample.first;
+        mean_t1 += sample.second;
+    }
+    mean_t0 /= m_samples.size();
+    mean_t1 /= m_samples.size();
+    double var_t0 = 0, var_t1 = 0;
+    for (auto &sample : m_samples)
+    {
+        var_t0 += (sample.first - mean_t0) * (sample.first - mean_t0);
+        var_t1 += (sample.second - mean_t1) * (sample.second - mean_t1);
+    }
+    return std::make_pair(std::sqrt(var_t0 / (m_samples.size() - 1)), std::sqrt(var_t1 / (m_samples.size() - 1)));
+}
+
+std::pair<pdd, pdd> lrgBootstrap::GetPercentileIntervals(double level) const
+{
+    return GetIntervals(level, false);
+}
+
+std::pair<pdd, pdd> lrgBootstrap::GetBCaIntervals(double level) const
+{
+    return GetIntervals(level, true);
+}
+
+std::pair<pdd, pdd> lrgBootstrap::GetIntervals(double level, bool corrected) const
+{
+    if (! (level > 0 && level < 1))
+    {
+        throw std::invalid_argument("The level must be in (0, 1)...");
+    }
+    if (m_samples.empty())
+    {
+        throw std::logic_error("Not enough bootstrap replicates...");
+    }
+
+    pdd intervals[2];
+    for (int k = 0; k < 2; k++)
+    {
+        std::vector<double> sorted;
+        for (auto &sample : m_samples)
+        {
+            sorted.push_back(k == 0 ? sample.first : sample.second);
+        }
+        std::sort(sorted.begin(), sorted.end());
+
+        double lower = (1 - level) / 2;
+        double upper = (1 + level) / 2;
+        if (corrected)
+        {
+            // The bias correction z0 from the share of replicates below the estimate (ties count half).
+            double estimate = (k == 0) ? m_estimate.first : m_estimate.second;
+            double B = sorted.size();
+            double below = std::lower_bound(sorted.begin(), sorted.end(), estimate) - sorted.begin();
+            double equal = std::upper_bound(sorted.begin(), sorted.end(), estimate) - sorted.begin() - below;
+            double share = std::min(std::max((below + equal / 2) / B, 0.5 / B), 1 - 0.5 / B);
+            double z0 = normal_quantile(share);
+            double a = (k == 0) ? m_acceleration.first : m_acceleration.second;
+
+            double z_lower = z0 + normal_quantile(lower);
+            double z_upper = z0 + normal_quantile(upper);
+            lower = normal_cdf(z0 + z_lower / (1 - a * z_lower));
+            upper = normal_cdf(z0 + z_upper / (1 - a * z_upper));
+        }
+        intervals[k] = std::make_pair(quantile(sorted, lower), quantile(sorted, upper));
+    }
+    return std::make_pair(intervals[0], intervals[1]);
+}
@@ -0,0 +1,53 @@
+#ifndef lrgBootstrap_h
+#define lrgBootstrap_h
+#include "lrgLinearModelSolverStrategyI.h"
+#include <vector>
+
+// Bootstrap confidence intervals for the thetas of the least squares line.
+//
+// A replicate draws N of the N points with replacement and fits the line again. The resample is never
+// built: the draws only count how often every point was picked (multinomial weights), and one pass adds the
+// counted x and y moments of every point (relative to the means of the data, so nothing cancels) and solves
+// the 2x2 normal equation. The replicates are shared between the threads, and replicate r always draws from
+// its own random stream seeded with (seed, r), so they are the same for any number of threads.
+//
+// The percentile interval takes the quantiles of the replicates. The BCa interval moves those quantiles
+// to correct for the bias (the share of replicates below the estimate) and the skewness (the acceleration,
+// from the N leave-one-out lines, which are a subtraction each rather than a refit).
+class lrgBootstrap
+{
+private:
+    unsigned int m_replicates;
+    unsigned int m_threads;
+    unsigned long m_seed;
+    pdd m_estimate;
+    std::vector<pdd> m_samples;
+    pdd m_acceleration;
+
+    std::pair<pdd, pdd> GetIntervals(double level, bool corrected) const;
+
+public:
+    lrgBootstrap(unsigned int &replicates);
+    lrgBootstrap();
+    ~lrgBootstrap();
+
+    // Default: one thread per hardware thread.
+    void SetThreads(unsigned int &threads);
+
+    void SetSeed(unsigned long seed);
+
+    // Fits the data and all the replicates. Returns the fit of the data itself.
+    pdd FitData(const pdd_vector &vec);
+
+    // The thetas of every replicate. A replicate that drew a single x-value has no line and is left out.
+    const std::vector<pdd> &GetReplicates() const;
+
+    // The standard deviations of the replicated t0 and t1.
+    pdd GetStandardErrors() const;
+
+    // The intervals (lower, upper) of t0 and of t1 with the given coverage, e.g. 0.95.
+    std::pair<pdd, pdd> GetPercentileIntervals(double level) const;
+    std::pair<pdd, pdd> GetBCaIntervals(double level) const;
+};
+
+#endif
@@ -0,0 +1,260 @@
+#include "lrgConjugateGradientSolverStrategy.h"
+#include <stdexcept>
+#include <cmath>
+
+// CGLS, i.e. conjugate gradient applied to X^T X thetas = X^T y without forming X^T X.
+// multiply(v) must return X * v and multiply_transpose(r) must return X^T * r.
+// scale holds the diagonal of the (right) preconditioner D: we solve for z with thetas = D * z,
+// which is the same as running CGLS on X * D. With D = 1/norm(column of X) all columns have unit length.
+// initial is the starting point in the original units (a warm start), or empty to start from zero.
+template <typename Multiply, typename MultiplyTranspose>
+static Eigen::VectorXd cgls(Multiply multiply, MultiplyTranspose multiply_transpose, const Eigen::VectorXd &scale,
+                            const Eigen::VectorXd &y, const Eigen::VectorXd &initial, unsigned int iterations,
+                            double tolerance, unsigned int &iterations_run)
+{
+    if (initial.size() != 0 && initial.size() != scale.size())
+    {
+        throw std::invalid_argument("The initial thetas do not match the number of columns of X...");
+    }
+
+    Eigen::VectorXd z = Eigen::VectorXd::Zero(scale.size());
+    Eigen::VectorXd residuals = y;
+    Eigen::VectorXd s = scale.cwiseProduct(multiply_transpose(residuals));
+    // The tolerance is always relative to the gradient at zero, so a good warm start needs fewer iterations.
+    double initial_norm = s.norm();
+    iterations_run = 0;
+
+    // y is orthogonal to every column of X: zero is the answer, wherever the warm start is.
+    if (initial_norm == 0)
+    {
+        return Eigen::VectorXd::Zero(scale.size());
+    }
+
+    if (initial.size() != 0)
+    {
+        z = initial.cwiseQuotient(scale);
+        residuals = y - multiply(initial);
+        s = scale.cwiseProduct(multiply_transpose(residuals));
+    }
+    Eigen::VectorXd direction = s;
+    double gamma = s.squaredNorm();
+
+    // The warm start is already good enough.
+    if (std::sqrt(gamma) <= tolerance * initial_norm)
+    {
+        return scale.cwiseProduct(z);
+    }
+
+    for (size_t i = 0; i < iterations; i++)
+    {
+        Eigen::VectorXd q = multiply(scale.cwiseProduct(direction));
+        double qq = q.squaredNorm();
+        if (qq == 0)
+        {
+            break;
+        }
+
+        double alpha = gamma / qq;
+        z += alpha * direction;
+        residuals -= alpha * q;
+        iterations_run++;
+
+        s = scale.cwiseProduct(multiply_transpose(residuals));
+        double gamma_new = s.squaredNorm();
+
+        // Stop when the gradient of the least squares problem is small compared to where we started.
+        if (std::sqrt(gamma_new) <= tolerance * initial_norm)
+        {
+            break;
+        }
+
+        direction = s + (gamma_new / gamma) * direction;
+        gamma = gamma_new;
+    }
+
+    return scale.cwiseProduct(z);
+}
+
+// The inverse column norms, or ones when preconditioning is off.
+// A zero column (e.g. all x-values are zero) is left unscaled.
+static Eigen::VectorXd column_scale(const Eigen::VectorXd &column_norms, bool preconditioning)
+{
+    Eigen::VectorXd scale = Eigen::VectorXd::Ones(column_norms.size());
+    if (preconditioning)
+    {
+        for (int j = 0; j < column_norms.size(); j++)
+        {
+            if (column_norms(j) > 0)
+            {
+                scale(j) = 1 / column_norms(j);
+            }
+        }
+    }
+    return scale;
+}
+
+// iterations is the maximum number of conjugate gradient steps.
+// tolerance is the relative reduction of the gradient norm that counts as converged.
+lrgConjugateGradientSolverStrategy::lrgConjugateGradientSolverStrategy(unsigned int &iterations, double &tolerance)
+{
+    m_iterations = iterations;
+    m_tolerance = tolerance;
+    m_preconditioning = false;
+    m_iterations_run = 0;
+}
+
+// Empty constructor. In exact arithmetic CG needs at most p iterations,
+// so the defaults are more than enough for the two thetas of a straight line.
+lrgConjugateGradientSolverStrategy::lrgConjugateGradientSolverStrategy()
+{
+    m_iterations = 1000;
+    m_tolerance = 1e-12;
+    m_preconditioning = false;
+    m_iterations_run = 0;
+}
+
+// Destructor
+lrgConjugateGradientSolverStrategy::~lrgConjugateGradientSolverStrategy() {}
+
+// Setters
+void lrgConjugateGradientSolverStrategy::SetIterations(unsigned int &iterations)
+{
+    m_iterations = iterations;
+}
+
+void lrgConjugateGradientSolverStrategy::SetTolerance(double &tolerance)
+{
+    m_tolerance = tolerance;
+}
+
+// Scale the columns of X to unit length before iterating (Jacobi preconditioning of X^T X).
+void lrgConjugateGradientSolverStrategy::SetPreconditioning(bool preconditioning)
+{
+    m_preconditioning = preconditioning;
+}
+
+unsigned int lrgConjugateGradientSolverStrategy::GetIterationsRun() const
+{
+    return m_iterations_run;
+}
+
+// Start the next fits from thetas (t0, t1) instead of zero.
+void lrgConjugateGradientSolverStrategy::SetInitialThetas(const pdd &thetas)
+{
+    m_initial_thetas = Eigen::Vector2d(thetas.first, thetas.second);
+}
+
+void lrgConjugateGradientSolverStrategy::SetInitialThetas(const Eigen::VectorXd &thetas)
+{
+    m_initial_thetas = thetas;
+}
+
+// Go back to starting from zero.
+void lrgConjugateGradientSolverStrategy::ClearInitialThetas()
+{
+    m_initial_thetas.resize(0);
+}
+
+// The design matrix X = [1, x] is never built. X * v is v0 + v1 * x and X^T * r is (sum of r, x^T r).
+pdd lrgConjugateGradientSolverStrategy::FitData(pdd_vector vec)
+{
+    if (m_iterations == 0)
+    {
+        throw std::invalid_argument("Invalid argument for iterations...");
+    }
+    if (vec.size() == 0)
+    {
+        throw std::length_error("Vector is empty...");
+    }
+
+    // Copy the x- and y-values into contiguous memory so the products are vectorised.
+    Eigen::VectorXd x(vec.size());
+    Eigen::VectorXd y(vec.size());
+    for (size_t i = 0; i < vec.size(); i++)
+    {
+        x(i) = vec[i].first;
+        y(i) = vec[i].second;
+    }
+
+    auto multiply = [&x](const Eigen::VectorXd &v) -> Eigen::VectorXd
+    {
+        return (v(0) + v(1) * x.array()).matrix();
+    };
+    auto multiply_transpose = [&x](const Eigen::VectorXd &r) -> Eigen::VectorXd
+    {
+        return Eigen::Vector2d(r.sum(), x.dot(r));
+    };
+
+    Eigen::VectorXd column_norms(2);
+    column_norms << std::sqrt(double(vec.size())), x.norm();
+
+    Eigen::VectorXd thetas_mat = cgls(multiply, multiply_transpose, column_scale(column_norms, m_preconditioning),
+                                      y, m_initial_thetas, m_iterations, m_tolerance, m_iterations_run);
+
+    pdd thetas = std::make_pair(thetas_mat(0), thetas_mat(1));
+    return thetas;
+}
+
+// Same as above for a general design matrix.
+Eigen::VectorXd lrgConjugateGradientSolverStrategy::FitData(const Eigen::MatrixXd &X, const Eigen::VectorXd &y)
+{
+    if (m_iterations == 0)
+    {
+        throw std::invalid_argument("Invalid argument for iterations...");
+    }
+    if (X.rows() != y.size() || X.rows() == 0)
+    {
+        throw std::invalid_argument("X and y must have the same, non-zero number of rows...");
+    }
+
+    auto multiply = [&X](const Eigen::VectorXd &v) -> Eigen::VectorXd
+    {
+        return X * v;
+    };
+    auto multiply_transpose = [&X](const Eigen::VectorXd &r) -> Eigen::VectorXd
+    {
+        return X.transpose() * r;
+    };
+
+    Eigen::VectorXd column_norms = X.colwise().norm().transpose();
+
+    return cgls(multiply, multiply_transpose, column_scale(column_norms, m_preconditioning),
+                y, m_initial_thetas, m_iterations, m_tolerance, m_iterations_run);
+}
+
+// Same as above for a sparse design matrix.
+Eigen::VectorXd lrgConjugateGradientSolverStrategy::FitData(const lrgSparseDataset &data)
+{
+    if (m_iterations == 0)
+    {
+        throw std::invalid_argument("Invalid argument for iterations...");
+    }
+    if (data.X.rows() != data.y.size() || data.X.rows() == 0)
+    {
+        throw std::invalid_argument("X and y must have the same, non-zero number of rows...");
+    }
+
+    const lrgSparseMatrix &X = data.X;
+    auto multiply = [&X](const Eigen::VectorXd &v) -> Eigen::VectorXd
+    {
+        return X * v;
+    };
+    auto multiply_transpose = [&X](const Eigen::VectorXd &r) -> Eigen::VectorXd
+    {
+        return X.transpose() * r;
+    };
+
+    // Squared column norms in one pass over the non-zeros.
+    Eigen::VectorXd column_norms = Eigen::VectorXd::Zero(X.cols());
+    for (int row = 0; row < X.outerSize(); row++)
+    {
+        for (lrgSparseMatrix::InnerIterator it(X, row); it; ++it)
+        {
+            column_norms(it.col()) += it.value() * it.value();
+        }
+    }
+    column_norms = column_norms.cwiseSqrt();
+
+    return cgls(multiply, multiply_transpose, column_scale(column_norms, m_preconditioning),
+                data.y, m_initial_thetas, m_iterations, m_tolerance, m_iterations_run);
+}
@@ -0,0 +1,42 @@
+#ifndef lrgConjugateGradientSolverStrategy_h
+#define lrgConjugateGradientSolverStrategy_h
+#include "lrgIterativeSolverStrategyI.h"
+#include "lrgSparseLinearModelSolverStrategyI.h"
+#include <Eigen/Dense>
+
+// Solves the least squares problem with conjugate gradient on the normal equation (CGLS).
+// X^T X is never formed. Every iteration only needs one product X * v and one product X^T * r,
+// so for p features the cost is O(N * p) per iteration instead of O(N * p^2 + p^3) for the normal equation.
+class lrgConjugateGradientSolverStrategy : public lrgIterativeSolverStrategyI, public lrgSparseLinearModelSolverStrategyI
+{
+private:
+    unsigned int m_iterations;
+    double m_tolerance;
+    bool m_preconditioning;
+    unsigned int m_iterations_run;
+    Eigen::VectorXd m_initial_thetas;
+
+public:
+    lrgConjugateGradientSolverStrategy(unsigned int &iterations, double &tolerance);
+    lrgConjugateGradientSolverStrategy();
+    ~lrgConjugateGradientSolverStrategy();
+    void SetIterations(unsigned int &iterations);
+    void SetTolerance(double &tolerance);
+    void SetPreconditioning(bool preconditioning);
+    unsigned int GetIterationsRun() const;
+    virtual void SetInitialThetas(const pdd &thetas);
+    virtual void ClearInitialThetas();
+
+    // Warm start for the matrix versions of FitData(), one value per column of X.
+    void SetInitialThetas(const Eigen::VectorXd &thetas);
+    virtual pdd FitData(pdd_vector vec);
+
+    // Fits y = X * thetas for a design matrix with any number of columns.
+    // X should contain a column of ones if an intercept is wanted.
+    Eigen::VectorXd FitData(const Eigen::MatrixXd &X, const Eigen::VectorXd &y);
+
+    // Same for sparse data. The products only visit the non-zeros of X.
+    virtual Eigen::VectorXd FitData(const lrgSparseDataset &data);
+};
+
+#endif
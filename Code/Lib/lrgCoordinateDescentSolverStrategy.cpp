@@ -0,0 +1,372 @@
+#include "lrgCoordinateDescentSolverStrategy.h"
+#include "lrgSufficientStatistics.h"
+#include <stdexcept>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+// The solution of the one-dimensional lasso problem: shrink z towards zero by gamma.
+static double soft_threshold(double z, double gamma)
+{
+    if (z > gamma)
+    {
+        return z - gamma;
+    }
+    else if (z < -gamma)
+    {
+        return z + gamma;
+    }
+    return 0;
+}
+
+// Cyclic coordinate descent on the covariances of the centred data.
+// diagonal holds the diagonal of gram = X^T X / N, column(j) returns column j of gram and
+// correlations = X^T y / N. A column is only asked for once theta_j becomes non-zero, so the
+// caller can compute the columns lazily and never build the whole of X^T X.
+// thetas holds the starting point (a warm start) and receives the result. previous_lambda is the lambda the
+// starting point was fitted with; it sharpens the strong rule along a path. Zero means lambda_max.
+// Returns the number of sweeps and counts every single coordinate step in coordinate_updates.
+template <typename Column>
+static unsigned int coordinate_descent(const Eigen::VectorXd &diagonal, Column column, const Eigen::VectorXd &correlations,
+                                       double lambda, double alpha, unsigned int iterations, double tolerance,
+                                       bool active_set, double previous_lambda, Eigen::VectorXd &thetas,
+                                       unsigned long &coordinate_updates)
+{
+    const int p = correlations.size();
+    const double l1 = lambda * alpha;
+    const double l2 = lambda * (1 - alpha);
+
+    // gram * thetas, kept up to date after every step so each step costs O(p).
+    Eigen::VectorXd fitted = Eigen::VectorXd::Zero(p);
+    for (int j = 0; j < p; j++)
+    {
+        if (thetas(j) != 0)
+        {
+            fitted += thetas(j) * column(j);
+        }
+    }
+    unsigned int sweeps = 0;
+    coordinate_updates = 0;
+
+    // One coordinate step. Returns the size of the change, measured in units of the fitted values.
+    auto update = [&](int j) -> double
+    {
+        coordinate_updates++;
+        double z = correlations(j) - fitted(j) + diagonal(j) * thetas(j);
+        double denominator = diagonal(j) + l2;
+        double theta = (denominator > 0) ? soft_threshold(z, l1) / denominator : 0;
+        double delta = theta - thetas(j);
+        if (delta != 0)
+        {
+            fitted += delta * column(j);
+            thetas(j) = theta;
+        }
+        return std::abs(delta) * std::sqrt(diagonal(j));
+    };
+
+    auto sweep = [&](const std::vector<int> &features) -> double
+    {
+        double max_change = 0;
+        for (int j : features)
+        {
+            max_change = std::max(max_change, update(j));
+        }
+        sweeps++;
+        return max_change;
+    };
+
+    std::vector<int> all(p);
+    for (int j = 0; j < p; j++)
+    {
+        all[j] = j;
+    }
+
+    // The naive version cycles through every feature until nothing changes.
+    if (! active_set)
+    {
+        while (sweeps < iterations && sweep(all) >= tolerance)
+        {
+        }
+        return sweeps;
+    }
+
+    // Strong rule: a feature whose correlation with the residuals is below alpha * (2 * lambda - previous_lambda)
+    // is very likely to stay at zero, so we leave it out. Features that are already non-zero always stay in.
+    // From a cold start the previous solution is the all-zero one of lambda_max.
+    // Ridge (alpha = 0) has no zeros to exploit.
+    if (previous_lambda == 0 && alpha > 0)
+    {
+        previous_lambda = correlations.cwiseAbs().maxCoeff() / alpha;
+    }
+    std::vector<int> strong;
+    std::vector<bool> in_strong(p, false);
+    for (int j = 0; j < p; j++)
+    {
+        if (alpha == 0 || thetas(j) != 0 || std::abs(correlations(j) - fitted(j)) >= alpha * (2 * lambda - previous_lambda))
+        {
+            strong.push_back(j);
+            in_strong[j] = true;
+        }
+    }
+
+    while (sweeps < iterations)
+    {
+        // A full sweep over the strong set. If nothing moves, we have the solution for the strong set.
+        if (sweep(strong) < tolerance)
+        {
+            // The rule can be wrong, so check the optimality (KKT) condition |correlation with residuals| <= l1
+            // of every feature we left out. The ones that violate it join the strong set.
+            bool violations = false;
+            for (int j = 0; j < p; j++)
+            {
+                if (! in_strong[j] && std::abs(correlations(j) - fitted(j)) > l1)
+                {
+                    strong.push_back(j);
+                    in_strong[j] = true;
+                    violations = true;
+                }
+            }
+            if (! violations)
+            {
+                break;
+            }
+            continue;
+        }
+
+        // Iterate on the active set only until it converges, then go back to a full sweep.
+        std::vector<int> active;
+        for (int j : strong)
+        {
+            if (thetas(j) != 0)
+            {
+                active.push_back(j);
+            }
+        }
+        while (sweeps < iterations && sweep(active) >= tolerance)
+        {
+        }
+    }
+
+    return sweeps;
+}
+
+// lambda is the strength of the penalty and alpha the share of the L1 (lasso) part.
+lrgCoordinateDescentSolverStrategy::lrgCoordinateDescentSolverStrategy(double &lambda, double &alpha)
+{
+    m_lambda = 0;
+    m_alpha = 1;
+    SetLambda(lambda);
+    SetAlpha(alpha);
+    m_iterations = 100000;
+    m_tolerance = 1e-10;
+    m_active_set = true;
+    m_sweeps_run = 0;
+    m_coordinate_updates = 0;
+}
+
+// Empty constructor. Without a penalty the result is ordinary least squares.
+lrgCoordinateDescentSolverStrategy::lrgCoordinateDescentSolverStrategy()
+{
+    m_lambda = 0;
+    m_alpha = 1;
+    m_iterations = 100000;
+    m_tolerance = 1e-10;
+    m_active_set = true;
+    m_sweeps_run = 0;
+    m_coordinate_updates = 0;
+}
+
+// Destructor
+lrgCoordinateDescentSolverStrategy::~lrgCoordinateDescentSolverStrategy() {}
+
+// Setters
+void lrgCoordinateDescentSolverStrategy::SetLambda(double &lambda)
+{
+    if (lambda < 0)
+    {
+        throw std::invalid_argument("Lambda cannot be negative...");
+    }
+    m_lambda = lambda;
+}
+
+void lrgCoordinateDescentSolverStrategy::SetAlpha(double &alpha)
+{
+    if (alpha < 0 || alpha > 1)
+    {
+        throw std::invalid_argument("Alpha must be in [0, 1]...");
+    }
+    m_alpha = alpha;
+}
+
+// iterations is the maximum number of sweeps.
+void lrgCoordinateDescentSolverStrategy::SetIterations(unsigned int &iterations)
+{
+    m_iterations = iterations;
+}
+
+void lrgCoordinateDescentSolverStrategy::SetTolerance(double &tolerance)
+{
+    m_tolerance = tolerance;
+}
+
+// false switches off the strong rule and the active set, every sweep visits every feature.
+void lrgCoordinateDescentSolverStrategy::SetActiveSet(bool active_set)
+{
+    m_active_set = active_set;
+}
+
+unsigned int lrgCoordinateDescentSolverStrategy::GetSweepsRun() const
+{
+    return m_sweeps_run;
+}
+
+unsigned long lrgCoordinateDescentSolverStrategy::GetCoordinateUpdates() const
+{
+    return m_coordinate_updates;
+}
+
+// Start the next fits from thetas (t0, t1) instead of zero.
+void lrgCoordinateDescentSolverStrategy::SetInitialThetas(const pdd &thetas)
+{
+    m_initial_thetas = Eigen::Vector2d(thetas.first, thetas.second);
+}
+
+void lrgCoordinateDescentSolverStrategy::SetInitialThetas(const Eigen::VectorXd &thetas)
+{
+    m_initial_thetas = thetas;
+}
+
+// Go back to starting from zero.
+void lrgCoordinateDescentSolverStrategy::ClearInitialThetas()
+{
+    m_initial_thetas.resize(0);
+}
+
+// The starting point for p features: the slopes of the initial thetas, or zero.
+static Eigen::VectorXd starting_thetas(const Eigen::VectorXd &initial, int p)
+{
+    if (initial.size() == 0)
+    {
+        return Eigen::VectorXd::Zero(p);
+    }
+    if (initial.size() != p + 1)
+    {
+        throw std::invalid_argument("The initial thetas do not match the number of columns of X...");
+    }
+    return initial.tail(p);
+}
+
+// With a single feature the covariances are just Sxx / N and Sxy / N.
+pdd lrgCoordinateDescentSolverStrategy::FitData(pdd_vector vec)
+{
+    if (vec.size() == 0)
+    {
+        throw std::length_error("Vector is empty...");
+    }
+
+    lrgSufficientStatistics stats(vec);
+
+    Eigen::VectorXd gram(1);
+    gram(0) = stats.GetSxx() / stats.GetWeight();
+    Eigen::VectorXd correlations(1);
+    correlations(0) = stats.GetSxy() / stats.GetWeight();
+    Eigen::VectorXd thetas = starting_thetas(m_initial_thetas, 1);
+
+    auto column = [&gram](int) -> const Eigen::VectorXd & { return gram; };
+    m_sweeps_run = coordinate_descent(gram, column, correlations, m_lambda, m_alpha, m_iterations, m_tolerance,
+                                      m_active_set, 0, thetas, m_coordinate_updates);
+
+    return std::make_pair(stats.GetMeanY() - thetas(0) * stats.GetMeanX(), thetas(0));
+}
+
+// A single fit is a path with one lambda.
+Eigen::VectorXd lrgCoordinateDescentSolverStrategy::FitData(const Eigen::MatrixXd &X, const Eigen::VectorXd &y)
+{
+    Eigen::VectorXd lambdas(1);
+    lambdas(0) = m_lambda;
+    return FitPath(X, y, lambdas).col(0);
+}
+
+// Centring X and y takes care of the (unpenalised) intercept: t0 = mean(y) - mean(X) * thetas.
+// The correlations and the diagonal of the Gram matrix cost O(N p). A full column of the Gram matrix
+// costs another O(N p) and is computed the first time its feature enters the model, so a sparse solution
+// with k non-zeros costs O(N p k) instead of the O(N p^2) of forming X^T X.
+// All of this is shared by every lambda of the path, and every fit starts from the solution of the one before.
+Eigen::MatrixXd lrgCoordinateDescentSolverStrategy::FitPath(const Eigen::MatrixXd &X, const Eigen::VectorXd &y,
+                                                             const Eigen::VectorXd &lambdas)
+{
+    if (X.rows() != y.size() || X.rows() == 0)
+    {
+        throw std::invalid_argument("X and y must have the same, non-zero number of rows...");
+    }
+    if (lambdas.size() == 0 || lambdas.minCoeff() < 0)
+    {
+        throw std::invalid_argument("The lambdas must be a non-empty list of non-negative values...");
+    }
+
+    const double N = X.rows();
+    Eigen::RowVectorXd means_x = X.colwise().mean();
+    double mean_y = y.mean();
+
+    Eigen::MatrixXd centred_x = X.rowwise() - means_x;
+    Eigen::VectorXd diagonal = centred_x.colwise().squaredNorm().transpose() / N;
+    Eigen::VectorXd correlations = centred_x.transpose() * (y.array() - mean_y).matrix() / N;
+
+    std::vector<Eigen::VectorXd> columns(X.cols());
+    auto column = [&](int j) -> const Eigen::VectorXd &
+    {
+        if (columns[j].size() == 0)
+        {
+            columns[j] = centred_x.transpose() * centred_x.col(j) / N;
+        }
+        return columns[j];
+    };
+
+    Eigen::MatrixXd path(X.cols() + 1, lambdas.size());
+    Eigen::VectorXd thetas = starting_thetas(m_initial_thetas, X.cols());
+    double previous_lambda = 0;
+    m_sweeps_run = 0;
+    m_coordinate_updates = 0;
+
+    for (int k = 0; k < lambdas.size(); k++)
+    {
+        unsigned long coordinate_updates = 0;
+        m_sweeps_run += coordinate_descent(diagonal, column, correlations, lambdas(k), m_alpha, m_iterations,
+                                           m_tolerance, m_active_set, previous_lambda, thetas, coordinate_updates);
+        m_coordinate_updates += coordinate_updates;
+        previous_lambda = lambdas(k);
+
+        path(0, k) = mean_y - means_x.dot(thetas);
+        path.col(k).tail(X.cols()) = thetas;
+    }
+
+    return path;
+}
+
+// glmnet's default grid: count values from lambda_max down to ratio * lambda_max, evenly spaced on a log scale.
+// lambda_max is the smallest lambda at which all thetas are zero. It does not exist for ridge,
+// so for alpha close to zero we use the lambda_max of alpha = 0.001.
+Eigen::VectorXd lrgCoordinateDescentSolverStrategy::LambdaGrid(const Eigen::MatrixXd &X, const Eigen::VectorXd &y,
+                                                               double alpha, unsigned int count, double ratio)
+{
+    if (X.rows() != y.size() || X.rows() == 0)
+    {
+        throw std::invalid_argument("X and y must have the same, non-zero number of rows...");
+    }
+    if (count == 0 || ratio <= 0 || ratio >= 1)
+    {
+        throw std::invalid_argument("The grid needs at least one value and a ratio in (0, 1)...");
+    }
+
+    Eigen::MatrixXd centred_x = X.rowwise() - X.colwise().mean();
+    Eigen::VectorXd correlations = centred_x.transpose() * (y.array() - y.mean()).matrix() / double(X.rows());
+    double lambda_max = correlations.cwiseAbs().maxCoeff() / std::max(alpha, 1e-3);
+
+    Eigen::VectorXd lambdas(count);
+    for (unsigned int k = 0; k < count; k++)
+    {
+        double fraction = (count == 1) ? 0 : double(k) / (count - 1);
+        lambdas(k) = lambda_max * std::pow(ratio, fraction);
+    }
+    return lambdas;
+}
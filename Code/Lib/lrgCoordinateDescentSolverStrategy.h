@@ -0,0 +1,62 @@
+#ifndef lrgCoordinateDescentSolverStrategy_h
+#define lrgCoordinateDescentSolverStrategy_h
+#include "lrgIterativeSolverStrategyI.h"
+#include <Eigen/Dense>
+
+// Elastic-net regression (lasso for alpha = 1, ridge for alpha = 0) with cyclic coordinate descent.
+// It minimises
+//   1/(2N) * ||y - t0 - X * thetas||^2 + lambda * ((1 - alpha)/2 * ||thetas||^2 + alpha * ||thetas||_1)
+// The intercept t0 is not penalised.
+//
+// The updates work on the covariances X^T X / N and X^T y / N of the centred data (covariance updates),
+// so a coordinate step costs O(p) no matter how many samples there are. Only the columns of X^T X that
+// belong to features with a non-zero theta are ever computed.
+// By default only the features that pass the strong rule are visited, and after the first sweep the
+// iterations run on the active set (the non-zero thetas) until it stops changing.
+class lrgCoordinateDescentSolverStrategy : public lrgIterativeSolverStrategyI
+{
+private:
+    double m_lambda;
+    double m_alpha;
+    unsigned int m_iterations;
+    double m_tolerance;
+    bool m_active_set;
+    unsigned int m_sweeps_run;
+    unsigned long m_coordinate_updates;
+    Eigen::VectorXd m_initial_thetas;
+
+public:
+    lrgCoordinateDescentSolverStrategy(double &lambda, double &alpha);
+    lrgCoordinateDescentSolverStrategy();
+    ~lrgCoordinateDescentSolverStrategy();
+    void SetLambda(double &lambda);
+    void SetAlpha(double &alpha);
+    void SetIterations(unsigned int &iterations);
+    void SetTolerance(double &tolerance);
+    void SetActiveSet(bool active_set);
+    unsigned int GetSweepsRun() const;
+    unsigned long GetCoordinateUpdates() const;
+    virtual void SetInitialThetas(const pdd &thetas);
+    virtual void ClearInitialThetas();
+
+    // Warm start for the matrix versions, (t0, thetas) like the result of FitData(). t0 is not needed
+    // (it follows from the means) but is accepted so a previous result can be passed back as it is.
+    void SetInitialThetas(const Eigen::VectorXd &thetas);
+    virtual pdd FitData(pdd_vector vec);
+
+    // Fits y = t0 + X * thetas for a design matrix with any number of columns.
+    // X must NOT contain a column of ones. The result is (t0, thetas).
+    Eigen::VectorXd FitData(const Eigen::MatrixXd &X, const Eigen::VectorXd &y);
+
+    // Fits the whole regularisation path, one column (t0, thetas) for every lambda.
+    // The covariances are computed once and each fit is warm-started from the previous one
+    // (the first one from the initial thetas, if any),
+    // so lambdas should go from large to small. GetSweepsRun() and GetCoordinateUpdates() are totals.
+    Eigen::MatrixXd FitPath(const Eigen::MatrixXd &X, const Eigen::VectorXd &y, const Eigen::VectorXd &lambdas);
+
+    // A decreasing grid of count lambdas from lambda_max (all thetas zero) to ratio * lambda_max.
+    static Eigen::VectorXd LambdaGrid(const Eigen::MatrixXd &X, const Eigen::VectorXd &y, double alpha,
+                                      unsigned int count = 100, double ratio = 1e-3);
+};
+
+#endif
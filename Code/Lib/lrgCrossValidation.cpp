@@ -0,0 +1,127 @@
+#include "lrgCrossValidation.h"
+#include "lrgSufficientStatistics.h"
+#include <stdexcept>
+#include <string>
+
+// The least squares line of the statistics.
+static pdd fit_statistics(const lrgSufficientStatistics &stats)
+{
+    if (! (stats.GetSxx() > 0))
+    {
+        throw std::logic_error("Invalid values for thetas...");
+    }
+    double t1 = stats.GetSxy() / stats.GetSxx();
+    return std::make_pair(stats.GetMeanY() - t1 * stats.GetMeanX(), t1);
+}
+
+lrgCrossValidation::lrgCrossValidation(unsigned int &folds)
+{
+    if (folds < 2)
+    {
+        throw std::invalid_argument("At least two folds are needed...");
+    }
+    m_folds = folds;
+}
+
+lrgCrossValidation::lrgCrossValidation()
+{
+    m_folds = 10;
+}
+
+lrgCrossValidation::~lrgCrossValidation()
+{
+}
+
+double lrgCrossValidation::KFold(const pdd_vector &vec)
+{
+    if (vec.size() < m_folds)
+    {
+        throw std::invalid_argument("Every fold needs at least one point...");
+    }
+    std::vector<unsigned int> folds(vec.size());
+    for (size_t i = 0; i < vec.size(); i++)
+    {
+        folds[i] = (unsigned int)(i * m_folds / vec.size());
+    }
+    return KFold(vec, folds);
+}
+
+double lrgCrossValidation::KFold(const pdd_vector &vec, const std::vector<unsigned int> &folds)
+{
+    if (vec.empty())
+    {
+        throw std::length_error("Vector is empty...");
+    }
+    if (folds.size() != vec.size())
+    {
+        throw std::invalid_argument("Every point needs a fold...");
+    }
+
+    // The only pass over the data.
+    std::vector<lrgSufficientStatistics> fold_stats(m_folds);
+    for (size_t i = 0; i < vec.size(); i++)
+    {
+        if (folds[i] >= m_folds)
+        {
+            throw std::invalid_argument("Invalid fold: " + std::to_string(folds[i]));
+        }
+        fold_stats[folds[i]].Add(vec[i].first, vec[i].second);
+    }
+
+    lrgSufficientStatistics total;
+    for (auto &stats : fold_stats)
+    {
+        if (stats.GetWeight() == 0)
+        {
+            throw std::invalid_argument("Every fold needs at least one point...");
+        }
+        total.Merge(stats);
+    }
+
+    m_fits.clear();
+    double squared_error = 0;
+    for (auto &stats : fold_stats)
+    {
+        lrgSufficientStatistics training = total;
+        training.Subtract(stats);
+        lrgFoldFit fit;
+        fit.thetas = fit_statistics(training);
+        fit.weight = stats.GetWeight();
+        fit.squared_error = stats.GetSquaredError(fit.thetas);
+        squared_error += fit.squared_error;
+        m_fits.push_back(fit);
+    }
+    return squared_error / total.GetWeight();
+}
+
+const std::vector<lrgFoldFit> &lrgCrossValidation::GetFoldFits() const
+{
+    return m_fits;
+}
+
+double lrgCrossValidation::LeaveOneOut(const pdd_vector &vec)
+{
+    if (vec.empty())
+    {
+        throw std::length_error("Vector is empty...");
+    }
+
+    lrgSufficientStatistics stats(vec);
+    pdd thetas = fit_statistics(stats);
+    double N = stats.GetWeight();
+
+    double press = 0;
+    for (auto &xy : vec)
+    {
+        double dx = xy.first - stats.GetMeanX();
+        double leverage = 1 / N + dx * dx / stats.GetSxx();
+        // A point with leverage 1 decides the line alone (for instance the only point at its x with N = 2).
+        if (! (1 - leverage > 1e-12))
+        {
+            throw std::logic_error("Invalid values for thetas...");
+        }
+        double residual = (xy.second - thetas.first - thetas.second * xy.first) / (1 - leverage);
+        press += residual * residual;
+    }
+    return press / N;
+}
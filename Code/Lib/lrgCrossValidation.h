@@ -0,0 +1,50 @@
+#ifndef lrgCrossValidation_h
+#define lrgCrossValidation_h
+#include "lrgLinearModelSolverStrategyI.h"
+#include <vector>
+
+// One fold of a cross-validation: the least squares line fitted on the other folds, the number of
+// points in the fold and the sum of the squared errors of the line on them.
+struct lrgFoldFit
+{
+    pdd thetas;
+    double weight;
+    double squared_error;
+};
+
+// Cross-validation of the least squares line without refitting every fold from the data.
+//
+// K-fold: one pass gathers the sufficient statistics of every fold (lrgSufficientStatistics). Merged they are
+// the statistics of all the data, and all of the data minus a fold is the training set of that fold, so each
+// training fit is a subtraction and a 2x2 solve. The error of the fit on the fold it left out also follows
+// from the moments of the fold. The cost is one pass over the data, whatever K is.
+//
+// Leave-one-out: the residual of point i from the line fitted without it is e_i / (1 - h_i), where e_i is
+// the residual from the line through all the points and h_i = 1 / N + (x_i - mean_x)^2 / Sxx its leverage
+// (the diagonal of the hat matrix). No line is ever refitted.
+class lrgCrossValidation
+{
+private:
+    unsigned int m_folds;
+    std::vector<lrgFoldFit> m_fits;
+
+public:
+    lrgCrossValidation(unsigned int &folds);
+    lrgCrossValidation();
+    ~lrgCrossValidation();
+
+    // The mean squared error over all the held-out points. Point i goes to fold i * K / N, so the folds are
+    // consecutive blocks: shuffle sorted data first.
+    double KFold(const pdd_vector &vec);
+
+    // The same with the fold (0 ... K - 1) of every point given. Every fold needs at least one point.
+    double KFold(const pdd_vector &vec, const std::vector<unsigned int> &folds);
+
+    // The fits of the last KFold call, one per fold.
+    const std::vector<lrgFoldFit> &GetFoldFits() const;
+
+    // The mean squared leave-one-out error (PRESS / N).
+    double LeaveOneOut(const pdd_vector &vec);
+};
+
+#endif
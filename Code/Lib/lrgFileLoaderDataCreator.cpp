@@ -1,5 +1,7 @@
 #include "lrgFileLoaderDataCreator.h"
 #include <fstream>
+#include <sstream>
+#include <stdexcept>
 
 // Constructor follows RAII pattern. 
 // filepath is the path of the file that contains the data.
@@ -48,4 +50,81 @@ pdd_vector lrgFileLoaderDataCreator::GetData(){
     m_file.close();
 
     return (*m_vec_ptr);
-}
\ No newline at end of file
+}
+
+// A method that copies x, y and weight values from file and places them inside a vector.
+// Every line must have exactly three numbers and the weights cannot be negative.
+weighted_vector lrgFileLoaderDataCreator::GetWeightedData()
+{
+    std::ifstream file(m_filepath, std::ios::in);
+
+    if (! file)
+    {
+        throw std::ios_base::failure("Reading file failed...");
+    }
+
+    weighted_vector vec;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream values(line);
+        lrgWeightedSample sample;
+        std::string rest;
+        if (! (values >> sample.x >> sample.y >> sample.weight) || (values >> rest))
+        {
+            throw std::ios_base::failure("Every line needs three values (x, y and weight): " + line);
+        }
+        if (sample.weight < 0)
+        {
+            throw std::invalid_argument("Weights cannot be negative: " + line);
+        }
+        vec.push_back(sample);
+    }
+
+    if (vec.size() == 0)
+    {
+        throw std::length_error("Vector is empty. Something went wrong when reading the input file...");
+    }
+
+    return vec;
+}
+
+size_t lrgFileLoaderDataCreator::GetMultiTargetData(std::vector<double> &x, std::vector<double> &targets)
+{
+    std::ifstream file(m_filepath, std::ios::in);
+
+    if (! file)
+    {
+        throw std::ios_base::failure("Reading file failed...");
+    }
+
+    x.clear();
+    targets.clear();
+    size_t target_count = 0;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream values(line);
+        double value;
+        size_t count = 0;
+        while (values >> value)
+        {
+            (count == 0 ? x : targets).push_back(value);
+            count++;
+        }
+
+        // The first line sets the number of targets.
+        if (! values.eof() || count < 2 || (target_count > 0 && count - 1 != target_count))
+        {
+            throw std::ios_base::failure("Every line needs x and the same number of y-values: " + line);
+        }
+        target_count = count - 1;
+    }
+
+    if (x.size() == 0)
+    {
+        throw std::length_error("Vector is empty. Something went wrong when reading the input file...");
+    }
+
+    return target_count;
+}
@@ -1,8 +1,10 @@
 #ifndef lrgFileLoaderDataCreator_h
 #define lrgFileLoaderDataCreator_h
 #include "lrgDataCreatorI.h"
+#include "lrgWeightedLinearModelSolverStrategyI.h"
 #include <string>
 #include <memory>
+#include <cstddef>
 
 // pdd stands for pair of doubles, i.e. pair<double, double>
 typedef std::shared_ptr<std::vector<std::pair<double, double>>> shared_ptr_pdd_vector;
@@ -17,6 +19,13 @@ public:
     lrgFileLoaderDataCreator(std::string&  filepath, shared_ptr_pdd_vector vec_ptr);
     ~lrgFileLoaderDataCreator();
     virtual pdd_vector GetData();
+
+    // For files with a third column that holds the weight of every sample: x y weight
+    weighted_vector GetWeightedData();
+
+    // For files with several y columns: x y_1 ... y_T. Every line must have the same number of values.
+    // x gets the first column and targets the y-values row by row. Returns T.
+    size_t GetMultiTargetData(std::vector<double> &x, std::vector<double> &targets);
 };
 
 #endif
\ No newline at end of file
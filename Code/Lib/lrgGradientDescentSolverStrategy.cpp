@@ -3,14 +3,69 @@
 #include <unsupported/Eigen/NonLinearOptimization>
 #include <random>
 #include <functional>
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+
+// Converts a command line keyword to the update rule.
+lrgUpdateRule lrgUpdateRuleFromString(const std::string &name)
+{
+    if (name == "plain")
+    {
+        return lrgUpdateRule::Plain;
+    }
+    else if (name == "momentum")
+    {
+        return lrgUpdateRule::Momentum;
+    }
+    else if (name == "nesterov")
+    {
+        return lrgUpdateRule::Nesterov;
+    }
+    else if (name == "adam")
+    {
+        return lrgUpdateRule::Adam;
+    }
+    else if (name == "bb")
+    {
+        return lrgUpdateRule::BarzilaiBorwein;
+    }
+    throw std::invalid_argument("Invalid update rule: " + name);
+}
+
+// Converts a command line keyword to the preconditioner.
+lrgPreconditioner lrgPreconditionerFromString(const std::string &name)
+{
+    if (name == "none")
+    {
+        return lrgPreconditioner::None;
+    }
+    else if (name == "standardise")
+    {
+        return lrgPreconditioner::Standardise;
+    }
+    else if (name == "jacobi")
+    {
+        return lrgPreconditioner::Jacobi;
+    }
+    throw std::invalid_argument("Invalid preconditioner: " + name);
+}
 
 // Passing values by reference.
 // eta defines how big or small the change in thetas value will be.
-// iterations is the number of times that the gradient batch will run. 
+// iterations is the number of times that the gradient batch will run.
 lrgGradientDescentSolverStrategy::lrgGradientDescentSolverStrategy(double &eta, unsigned int &iterations)
 {
     m_eta = eta;
     m_iterations = iterations;
+    m_rule = lrgUpdateRule::Plain;
+    m_preconditioner = lrgPreconditioner::None;
+    m_step_size = lrgStepSize::Fixed;
+    m_momentum = 0.9;
+    m_tolerance = 0;
+    m_iterations_run = 0;
+    m_has_initial_thetas = false;
+    m_initial_thetas = std::make_pair(0.0, 0.0);
 }
 
 // Empty constructor
@@ -18,6 +73,14 @@ lrgGradientDescentSolverStrategy::lrgGradientDescentSolverStrategy()
 {
     m_eta = 0;
     m_iterations = 0;
+    m_rule = lrgUpdateRule::Plain;
+    m_preconditioner = lrgPreconditioner::None;
+    m_step_size = lrgStepSize::Fixed;
+    m_momentum = 0.9;
+    m_tolerance = 0;
+    m_iterations_run = 0;
+    m_has_initial_thetas = false;
+    m_initial_thetas = std::make_pair(0.0, 0.0);
 }
 
 // Destructor
@@ -34,80 +97,297 @@ void lrgGradientDescentSolverStrategy::SetIterations(unsigned int &iterations)
     m_iterations = iterations;
 }
 
-// A method that puts data from vector inside Eigen::Matrices and perform linear algebra computations.
+void lrgGradientDescentSolverStrategy::SetUpdateRule(lrgUpdateRule rule)
+{
+    m_rule = rule;
+}
+
+void lrgGradientDescentSolverStrategy::SetPreconditioner(lrgPreconditioner preconditioner)
+{
+    m_preconditioner = preconditioner;
+}
+
+void lrgGradientDescentSolverStrategy::SetStepSize(lrgStepSize step_size)
+{
+    m_step_size = step_size;
+}
+
+// momentum is the decay factor (beta) of the velocity for Momentum and Nesterov,
+// and of the first moment for Adam.
+void lrgGradientDescentSolverStrategy::SetMomentum(const double &momentum)
+{
+    if (momentum < 0 || momentum >= 1)
+    {
+        throw std::invalid_argument("Momentum must be in [0, 1)...");
+    }
+    m_momentum = momentum;
+}
+
+// If tolerance is positive, the iterations stop as soon as the norm of the gradient drops below it.
+// The default (zero) always runs all the iterations.
+void lrgGradientDescentSolverStrategy::SetTolerance(const double &tolerance)
+{
+    m_tolerance = tolerance;
+}
+
+// The number of iterations the last FitData() call actually needed.
+unsigned int lrgGradientDescentSolverStrategy::GetIterationsRun() const
+{
+    return m_iterations_run;
+}
+
+// Start the next fits from thetas instead of random values, e.g. from the solution of a previous fit.
+void lrgGradientDescentSolverStrategy::SetInitialThetas(const pdd &thetas)
+{
+    m_initial_thetas = thetas;
+    m_has_initial_thetas = true;
+}
+
+// Go back to random initial thetas.
+void lrgGradientDescentSolverStrategy::ClearInitialThetas()
+{
+    m_has_initial_thetas = false;
+}
+
+// A method that gathers the statistics of the data and hands them to the optimiser.
 // returns a pdd, i.e. a pair of doubles pair<double, double>
 pdd lrgGradientDescentSolverStrategy::FitData(pdd_vector vec)
+{
+    lrgSufficientStatistics stats(vec);
+    return FitData(stats);
+}
+
+// The weighted statistics are gathered in the same single pass, and the optimiser below does not change:
+// the gradient 2 * (X^T W X / W thetas - X^T W y / W) only needs the weighted normal equation.
+pdd lrgGradientDescentSolverStrategy::FitData(const weighted_vector &vec)
+{
+    lrgSufficientStatistics stats(vec);
+    return FitData(stats);
+}
+
+// The gradient of the mean squared error only depends on X^T X and X^T y:
+// gradients = 2/N * X^T * (X * thetas - y) = 2 * (X^T X / N * thetas - X^T y / N)
+// So we build these 2x2 and 2x1 matrices once and every iteration costs O(1) instead of O(N).
+pdd lrgGradientDescentSolverStrategy::FitData(const lrgSufficientStatistics &stats)
 {
     // Check if eta and iterations are set. If they are zero we cannot proceed.
     // They can be zero in two cases:
     // a) user create an object with the empty constructor and forgot to set attribute values.
     // b) user didn't call the programme appropriately throught the command line interface.
-    if (m_eta == 0 || m_iterations == 0)
+    // eta is only needed when the step size is fixed.
+    if ((m_eta == 0 && m_step_size == lrgStepSize::Fixed) || m_iterations == 0)
     {
         throw std::invalid_argument("Invalid arguments for eta and/or iterations...");
     }
 
-    // This part of the code is the same as the FitData() method in lrgNormalEquationSolverStrategy class.
-    //-----------------------------------------------------------------------------------------------------
-    // We are going to use the size of the vector many times, so we create a variable.
-    int vec_size = vec.size();
-
-    // An array that will keep the y-values of the pair vector.
-    double array_y[vec_size];
-
-    // An array that will keep the x-values of the pair vector.
-    double array_x[vec_size][2];
+    // Adam rescales every step by its own moments, so a step size from X^T X means nothing to it.
+    // The line search only makes sense for the plain rule.
+    if ((m_step_size == lrgStepSize::Auto && m_rule == lrgUpdateRule::Adam) ||
+        (m_step_size == lrgStepSize::Backtracking && m_rule != lrgUpdateRule::Plain))
+    {
+        throw std::invalid_argument("This step size mode cannot be used with the chosen update rule...");
+    }
 
-    for (size_t i = 0; i < vec_size; i++)
+    if (stats.GetWeight() == 0)
     {
-        // According to "Hands-On Machine Learning", the first column of X-matrix must have ones.
-        // Also X-matrix must be 2D to do valid matrix multiplications.
-        array_x[i][0] = 1;
+        throw std::length_error("Vector is empty...");
+    }
 
-        // Fill the second column of array_x with the x-values of the pair vector (vec).
-        array_x[i][1] = vec[i].first;
+    double array_gram[2][2];
+    double array_rhs[2];
+    stats.GetScaledNormalEquation(array_gram, array_rhs);
 
-        // Fill the array_y.
-        array_y[i] = vec[i].second;
+    // Fixed-size Eigen types live on the stack, there is no heap allocation inside the loop.
+    Eigen::Matrix2d gram;
+    gram << array_gram[0][0], array_gram[0][1], array_gram[1][0], array_gram[1][1];
+    Eigen::Vector2d rhs(array_rhs[0], array_rhs[1]);
+
+    // Preconditioning is a change of variables thetas = M * phi.
+    // The optimiser works on phi, where the loss has the normal equation (M^T X^T X M) phi = M^T X^T y,
+    // and at the end we map phi back to the original units.
+    Eigen::Matrix2d M = Eigen::Matrix2d::Identity();
+    if (m_preconditioner == lrgPreconditioner::Standardise)
+    {
+        // z = (x - mean_x) / std_x, so y = phi0 + phi1 * z = (phi0 - phi1 * mean_x / std_x) + phi1 / std_x * x.
+        // If all x-values are equal there is nothing to scale.
+        double std_x = std::sqrt(stats.GetSxx() / stats.GetWeight());
+        if (std_x == 0)
+        {
+            std_x = 1;
+        }
+        M(0, 1) = -stats.GetMeanX() / std_x;
+        M(1, 1) = 1 / std_x;
     }
+    else if (m_preconditioner == lrgPreconditioner::Jacobi)
+    {
+        for (int k = 0; k < 2; k++)
+        {
+            if (gram(k, k) > 0)
+            {
+                M(k, k) = 1 / std::sqrt(gram(k, k));
+            }
+        }
+    }
+    gram = M.transpose() * gram * M;
+    rhs = M.transpose() * rhs;
 
-    // Create an Eigen::Matrix (y) by using the allocated memory that array_y had.
-    Eigen::Map<Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>> y(array_y, vec_size, 1);
+    double eta = m_eta;
+    if (m_step_size == lrgStepSize::Auto)
+    {
+        // The Hessian of the loss is 2 * X^T X / N. For a 2x2 matrix Eigen computes the eigenvalues in closed form.
+        // With L the largest and mu the smallest eigenvalue, the fastest stable fixed step is
+        // 2 / (L + mu) for plain gradient descent (and the first Barzilai-Borwein step),
+        // and the usual 1 / L for the momentum methods.
+        Eigen::SelfAdjointEigenSolver<Eigen::Matrix2d> eigen_solver;
+        eigen_solver.computeDirect(2.0 * gram, Eigen::EigenvaluesOnly);
+        double mu = eigen_solver.eigenvalues()(0);
+        double L = eigen_solver.eigenvalues()(1);
+        if (!(L > 0))
+        {
+            throw std::logic_error("X^T X has no positive eigenvalue...");
+        }
+        if (m_rule == lrgUpdateRule::Plain || m_rule == lrgUpdateRule::BarzilaiBorwein)
+        {
+            eta = 2 / (L + std::max(mu, 0.0));
+        }
+        else
+        {
+            eta = 1 / L;
+        }
+    }
+    else if (m_step_size == lrgStepSize::Backtracking && eta == 0)
+    {
+        eta = 1;
+    }
 
-    // Do the same with array_x.
-    // RowMajor tells the Eigen::Map function to store the Eigen::Matrix row by row.
-    Eigen::Map<Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>> X(array_x[0], vec_size, 2);
-    //-----------------------------------------------------------------------------------------------------
+    Eigen::Vector2d thetas_mat;
+    if (m_has_initial_thetas)
+    {
+        // Warm start. The optimiser works on phi, so undo the preconditioning: phi = M^-1 * thetas.
+        // M is upper triangular with a non-zero diagonal.
+        Eigen::Vector2d initial(m_initial_thetas.first, m_initial_thetas.second);
+        thetas_mat = M.triangularView<Eigen::Upper>().solve(initial);
+    }
+    else
+    {
+        // Normal distribution with mean:0.0 and standard deviation:1.0
+        std::normal_distribution<double> distribution(0.0, 1.0);
+        std::mt19937_64 mt64;
+        auto rand_theta = std::bind(distribution, mt64);
 
-    // An array that stores the random values of thetas.
-    // We use that array to create the Eigen::Matrix for thetas.
-    double array_thetas[2];
+        // Give random initial values to thetas.
+        thetas_mat(0) = rand_theta();
+        thetas_mat(1) = rand_theta();
+    }
 
-    // Normal distribution with mean:0.0 and standard deviation:1.0
-    std::normal_distribution<double> distribution(0.0, 1.0);
-    std::mt19937_64 mt64;
-    auto rand_theta = std::bind(distribution, mt64);
+    auto gradient_at = [&gram, &rhs](const Eigen::Vector2d &t) -> Eigen::Vector2d
+    {
+        return 2.0 * (gram * t - rhs);
+    };
 
-    // Give random initial values to thetas and add them to the array.
-    array_thetas[0] = rand_theta();
-    array_thetas[1] = rand_theta();
+    // How much the mean squared error changes when thetas move by d, given the gradient g at thetas.
+    // Only used by the line search. Taking the difference of two losses instead would be lost in
+    // rounding errors long before the gradient is small.
+    auto loss_change = [&gram](const Eigen::Vector2d &d, const Eigen::Vector2d &g) -> double
+    {
+        return d.dot(g + gram * d);
+    };
 
-    // Map array_thetas to an Eigen::Matrix (thetas) and use the already allocated memory.
-    // thetas_mat is always a 2x1 array.
-    Eigen::Map<Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>> thetas_mat(array_thetas, 2, 1);
+    // State of the update rules.
+    // velocity is used by Momentum/Nesterov, first/second moments by Adam,
+    // and the previous iterate by Barzilai-Borwein.
+    Eigen::Vector2d velocity = Eigen::Vector2d::Zero();
+    Eigen::Vector2d first_moment = Eigen::Vector2d::Zero();
+    Eigen::Vector2d second_moment = Eigen::Vector2d::Zero();
+    Eigen::Vector2d previous_thetas = thetas_mat;
+    Eigen::Vector2d previous_gradients = Eigen::Vector2d::Zero();
+    const double beta2 = 0.999;
+    const double epsilon = 1e-8;
+    double beta1_power = 1;
+    double beta2_power = 1;
 
-    // An Eigen::Matrix to store the gradients.
-    // gradients is always a 2x1 array.
-    Eigen::MatrixXd gradients(2, 1);
+    Eigen::Vector2d gradients;
+    m_iterations_run = 0;
 
     // Tweak parameters iteratively in order to compute the result.
     // Followed the code example in "Hands-On Machine Learning" p.115 .
     for (size_t i = 0; i < m_iterations; i++)
     {
-        gradients = 2.0 / vec_size * X.transpose() * (X * thetas_mat - y);
-        thetas_mat = thetas_mat - m_eta * gradients;
+        gradients = gradient_at(thetas_mat);
+
+        if (m_tolerance > 0 && gradients.norm() < m_tolerance)
+        {
+            break;
+        }
+        m_iterations_run++;
+
+        switch (m_rule)
+        {
+        case lrgUpdateRule::Plain:
+            if (m_step_size == lrgStepSize::Backtracking)
+            {
+                // Armijo rule: halve the step until the loss drops by at least half of what the gradient promises.
+                // The next iteration starts from twice the accepted step, so the step can grow again.
+                double squared_norm = gradients.squaredNorm();
+                while (loss_change(-eta * gradients, gradients) > -0.5 * eta * squared_norm && eta > 1e-300)
+                {
+                    eta *= 0.5;
+                }
+                thetas_mat = thetas_mat - eta * gradients;
+                eta *= 2;
+            }
+            else
+            {
+                thetas_mat = thetas_mat - eta * gradients;
+            }
+            break;
+
+        case lrgUpdateRule::Momentum:
+            velocity = m_momentum * velocity - eta * gradients;
+            thetas_mat = thetas_mat + velocity;
+            break;
+
+        case lrgUpdateRule::Nesterov:
+            // Same as momentum, but the gradient is measured where the velocity is about to take us.
+            gradients = gradient_at(thetas_mat + m_momentum * velocity);
+            velocity = m_momentum * velocity - eta * gradients;
+            thetas_mat = thetas_mat + velocity;
+            break;
+
+        case lrgUpdateRule::Adam:
+            beta1_power *= m_momentum;
+            beta2_power *= beta2;
+            first_moment = m_momentum * first_moment + (1 - m_momentum) * gradients;
+            second_moment = beta2 * second_moment + (1 - beta2) * gradients.cwiseAbs2();
+            thetas_mat = thetas_mat - eta * ((first_moment / (1 - beta1_power)).array() /
+                                             ((second_moment / (1 - beta2_power)).array().sqrt() + epsilon)).matrix();
+            break;
+
+        case lrgUpdateRule::BarzilaiBorwein:
+        {
+            // The first step has nothing to compare with, so it uses eta.
+            // After that, step = (s^T s) / (s^T g) where s and g are the changes of thetas and gradients.
+            double step = eta;
+            if (i > 0)
+            {
+                Eigen::Vector2d s = thetas_mat - previous_thetas;
+                Eigen::Vector2d g = gradients - previous_gradients;
+                double sg = s.dot(g);
+                if (sg > 0)
+                {
+                    step = s.squaredNorm() / sg;
+                }
+            }
+            previous_thetas = thetas_mat;
+            previous_gradients = gradients;
+            thetas_mat = thetas_mat - step * gradients;
+            break;
+        }
+        }
     }
 
+    thetas_mat = M * thetas_mat;
+
     pdd thetas = std::make_pair(thetas_mat(0), thetas_mat(1));
     return thetas;
-}
\ No newline at end of file
+}
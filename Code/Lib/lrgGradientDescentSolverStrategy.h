@@ -1,13 +1,55 @@
 #ifndef lrgGradientDescentSolverStrategy_h
 #define lrgGradientDescentSolverStrategy_h
-#include "lrgLinearModelSolverStrategyI.h"
+#include "lrgIterativeSolverStrategyI.h"
+#include "lrgSufficientStatistics.h"
 #include <memory>
+#include <string>
 
-class lrgGradientDescentSolverStrategy : public lrgLinearModelSolverStrategyI
+// The rule that turns a gradient into a change of thetas.
+enum class lrgUpdateRule
+{
+    Plain,          // thetas = thetas - eta * gradients
+    Momentum,       // heavy-ball momentum
+    Nesterov,       // Nesterov accelerated gradient
+    Adam,           // adaptive moment estimation
+    BarzilaiBorwein // step size taken from the last two iterates
+};
+
+// Converts the command line keywords (plain, momentum, nesterov, adam, bb) to an lrgUpdateRule.
+lrgUpdateRule lrgUpdateRuleFromString(const std::string &name);
+
+// The change of variables applied before the optimiser runs.
+enum class lrgPreconditioner
+{
+    None,        // optimise thetas directly
+    Standardise, // centre x and scale it to unit variance
+    Jacobi       // scale each theta by 1/sqrt(diagonal of X^T X)
+};
+
+// Converts the command line keywords (none, standardise, jacobi) to an lrgPreconditioner.
+lrgPreconditioner lrgPreconditionerFromString(const std::string &name);
+
+// How the step size (eta) is chosen.
+enum class lrgStepSize
+{
+    Fixed,       // use the eta given by the user
+    Auto,        // derive eta from the eigenvalues of X^T X
+    Backtracking // search along the gradient until the loss decreases enough (plain rule only)
+};
+
+class lrgGradientDescentSolverStrategy : public lrgIterativeSolverStrategyI, public lrgWeightedLinearModelSolverStrategyI
 {
 private:
     double m_eta;
     unsigned int m_iterations;
+    lrgUpdateRule m_rule;
+    lrgPreconditioner m_preconditioner;
+    lrgStepSize m_step_size;
+    double m_momentum;
+    double m_tolerance;
+    unsigned int m_iterations_run;
+    bool m_has_initial_thetas;
+    pdd m_initial_thetas;
 
 public:
     lrgGradientDescentSolverStrategy(double &eta, unsigned int &iterations);
@@ -15,7 +57,19 @@ public:
     ~lrgGradientDescentSolverStrategy();
     void SetEta(double &eta);
     void SetIterations(unsigned int &iterations);
+    void SetUpdateRule(lrgUpdateRule rule);
+    void SetPreconditioner(lrgPreconditioner preconditioner);
+    void SetStepSize(lrgStepSize step_size);
+    void SetMomentum(const double &momentum);
+    void SetTolerance(const double &tolerance);
+    unsigned int GetIterationsRun() const;
+    virtual void SetInitialThetas(const pdd &thetas);
+    virtual void ClearInitialThetas();
     virtual pdd FitData(pdd_vector vec);
+
+    // Weighted least squares. The gradients are those of the weighted mean squared error.
+    virtual pdd FitData(const weighted_vector &vec);
+    pdd FitData(const lrgSufficientStatistics &stats);
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,229 @@
+#include "lrgGradientDescentSweep.h"
+#include "lrgParallel.h"
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+
+// A loss this many times the loss at the start means the configuration diverges.
+static const double divergence_factor = 1e4;
+
+lrgGradientDescentSweep::lrgGradientDescentSweep()
+{
+    m_threads = lrgDefaultThreads();
+    m_reduction = 2;
+    m_minimum_iterations = 0;
+    m_total_iterations = 0;
+    m_initial_thetas = std::make_pair(0.0, 0.0);
+}
+
+lrgGradientDescentSweep::~lrgGradientDescentSweep()
+{
+}
+
+void lrgGradientDescentSweep::SetThreads(unsigned int &threads)
+{
+    if (threads == 0)
+    {
+        throw std::invalid_argument("The number of threads must be positive...");
+    }
+    m_threads = threads;
+}
+
+void lrgGradientDescentSweep::SetReduction(unsigned int &reduction)
+{
+    if (reduction < 2)
+    {
+        throw std::invalid_argument("The reduction factor must be at least 2...");
+    }
+    m_reduction = reduction;
+}
+
+void lrgGradientDescentSweep::SetMinimumIterations(unsigned int &iterations)
+{
+    m_minimum_iterations = iterations;
+}
+
+void lrgGradientDescentSweep::SetInitialThetas(const pdd &thetas)
+{
+    m_initial_thetas = thetas;
+}
+
+std::vector<lrgSweepConfiguration> lrgGradientDescentSweep::Grid(const std::vector<double> &etas,
+                                                                 const std::vector<unsigned int> &iterations,
+                                                                 const std::vector<lrgUpdateRule> &rules,
+                                                                 const std::vector<lrgPreconditioner> &preconditioners)
+{
+    std::vector<lrgSweepConfiguration> configurations;
+    for (auto rule : rules)
+    {
+        for (auto preconditioner : preconditioners)
+        {
+            for (auto eta : etas)
+            {
+                for (auto iteration : iterations)
+                {
+                    configurations.push_back({eta, iteration, rule, preconditioner, lrgStepSize::Fixed, 0.9});
+                }
+            }
+        }
+    }
+    return configurations;
+}
+
+// Reads the data once. From here on no configuration touches them again.
+const std::vector<lrgSweepResult> &lrgGradientDescentSweep::Run(const pdd_vector &vec,
+                                                                const std::vector<lrgSweepConfiguration> &configurations)
+{
+    lrgSufficientStatistics stats(vec);
+    return Run(stats, configurations);
+}
+
+const std::vector<lrgSweepResult> &lrgGradientDescentSweep::Run(const lrgSufficientStatistics &stats,
+                                                                const std::vector<lrgSweepConfiguration> &configurations)
+{
+    if (configurations.empty())
+    {
+        throw std::invalid_argument("There are no configurations to sweep...");
+    }
+    if (stats.GetWeight() == 0)
+    {
+        throw std::length_error("Vector is empty...");
+    }
+
+    // Every configuration must be usable on its own, so a bad one stops the sweep before anything runs.
+    unsigned int max_iterations = 0;
+    for (auto &configuration : configurations)
+    {
+        if ((configuration.eta == 0 && configuration.step_size == lrgStepSize::Fixed) || configuration.iterations == 0)
+        {
+            throw std::invalid_argument("Invalid arguments for eta and/or iterations...");
+        }
+        if ((configuration.step_size == lrgStepSize::Auto && configuration.rule == lrgUpdateRule::Adam) ||
+            (configuration.step_size == lrgStepSize::Backtracking && configuration.rule != lrgUpdateRule::Plain))
+        {
+            throw std::invalid_argument("This step size mode cannot be used with the chosen update rule...");
+        }
+        if (! (configuration.momentum >= 0 && configuration.momentum < 1))
+        {
+            throw std::invalid_argument("Momentum must be in [0, 1)...");
+        }
+        max_iterations = std::max(max_iterations, configuration.iterations);
+    }
+
+    // Without a minimum, rung 0 is as short as it can be for the last rung to run all the iterations:
+    // one halving per rung leaves a single configuration after ceil(log(n) / log(reduction)) rungs.
+    unsigned long budget = m_minimum_iterations;
+    if (budget == 0)
+    {
+        budget = max_iterations;
+        for (size_t left = configurations.size(); left > 1 && budget > 1; left = (left + m_reduction - 1) / m_reduction)
+        {
+            budget = std::max(budget / m_reduction, 1UL);
+        }
+    }
+
+    double start_loss = stats.GetSquaredError(m_initial_thetas) / stats.GetWeight();
+
+    m_leaderboard.clear();
+    m_total_iterations = 0;
+    for (auto &configuration : configurations)
+    {
+        lrgSweepResult result = {configuration, m_initial_thetas, start_loss, 0, 0, false};
+        m_leaderboard.push_back(result);
+    }
+
+    std::vector<size_t> alive(configurations.size());
+    for (size_t i = 0; i < alive.size(); i++)
+    {
+        alive[i] = i;
+    }
+
+    for (unsigned int rung = 0; ! alive.empty(); rung++)
+    {
+        // Every configuration of the rung runs from the start with its own budget: restarting instead of
+        // resuming keeps the momentum and the Adam moments exactly what one long run would have, and the
+        // shorter rungs before cost no more than a fraction of this one.
+        lrgParallelFor(m_threads, alive.size(), [&](unsigned int, size_t begin, size_t end)
+        {
+            for (size_t a = begin; a < end; a++)
+            {
+                lrgSweepResult &result = m_leaderboard[alive[a]];
+                const lrgSweepConfiguration &configuration = result.configuration;
+                double eta = configuration.eta;
+                unsigned int iterations = (unsigned int)(std::min<unsigned long>(budget, configuration.iterations));
+
+                lrgGradientDescentSolverStrategy solver(eta, iterations);
+                solver.SetUpdateRule(configuration.rule);
+                solver.SetPreconditioner(configuration.preconditioner);
+                solver.SetStepSize(configuration.step_size);
+                solver.SetMomentum(configuration.momentum);
+                solver.SetInitialThetas(m_initial_thetas);
+
+                result.thetas = solver.FitData(stats);
+                result.loss = stats.GetSquaredError(result.thetas) / stats.GetWeight();
+                result.iterations_run = solver.GetIterationsRun();
+                result.rung = rung;
+                result.diverged = ! (std::isfinite(result.loss) && result.loss <= divergence_factor * start_loss);
+            }
+        });
+
+        // Diverged configurations are out whatever their rank.
+        bool finished = true;
+        std::vector<size_t> survivors;
+        for (size_t index : alive)
+        {
+            m_total_iterations += m_leaderboard[index].iterations_run;
+            if (! m_leaderboard[index].diverged)
+            {
+                survivors.push_back(index);
+                finished = finished && budget >= m_leaderboard[index].configuration.iterations;
+            }
+        }
+        if (finished)
+        {
+            break;
+        }
+
+        // The best 1 / reduction go on, ties decided by the order the configurations were given in.
+        std::stable_sort(survivors.begin(), survivors.end(), [this](size_t a, size_t b)
+        {
+            return m_leaderboard[a].loss < m_leaderboard[b].loss;
+        });
+        survivors.resize((survivors.size() + m_reduction - 1) / m_reduction);
+        alive = survivors;
+        budget = std::min<unsigned long>(budget * m_reduction, max_iterations);
+    }
+
+    std::stable_sort(m_leaderboard.begin(), m_leaderboard.end(), [](const lrgSweepResult &a, const lrgSweepResult &b)
+    {
+        if (a.diverged != b.diverged)
+        {
+            return b.diverged;
+        }
+        if (a.rung != b.rung)
+        {
+            return a.rung > b.rung;
+        }
+        return a.loss < b.loss;
+    });
+    return m_leaderboard;
+}
+
+const std::vector<lrgSweepResult> &lrgGradientDescentSweep::GetLeaderboard() const
+{
+    return m_leaderboard;
+}
+
+const lrgSweepResult &lrgGradientDescentSweep::GetBest() const
+{
+    if (m_leaderboard.empty())
+    {
+        throw std::logic_error("The sweep has not been run...");
+    }
+    return m_leaderboard.front();
+}
+
+unsigned long lrgGradientDescentSweep::GetTotalIterations() const
+{
+    return m_total_iterations;
+}
@@ -0,0 +1,82 @@
+#ifndef lrgGradientDescentSweep_h
+#define lrgGradientDescentSweep_h
+#include "lrgGradientDescentSolverStrategy.h"
+#include <vector>
+
+// One optimiser setting of lrgGradientDescentSolverStrategy.
+struct lrgSweepConfiguration
+{
+    double eta;
+    unsigned int iterations;
+    lrgUpdateRule rule;
+    lrgPreconditioner preconditioner;
+    lrgStepSize step_size;
+    double momentum;
+};
+
+// How far a configuration got: its thetas and mean squared error after the iterations of the last rung
+// it ran in. Diverged configurations (the loss blew up or stopped being a number) drop out at once.
+struct lrgSweepResult
+{
+    lrgSweepConfiguration configuration;
+    pdd thetas;
+    double loss;
+    unsigned int iterations_run;
+    unsigned int rung;
+    bool diverged;
+};
+
+// Tries many gradient descent configurations on the same data and keeps the best.
+//
+// The data are read once into lrgSufficientStatistics, which is all that lrgGradientDescentSolverStrategy
+// needs, so every configuration afterwards costs O(iterations) and nothing in N. Successive halving then
+// spends the iterations where they matter: rung 0 runs every configuration for a few iterations, only the
+// best 1 / reduction of them go on to the next rung with reduction times more iterations, and so on until the
+// survivors have run all their iterations (or one is left). The configurations of a rung run in parallel.
+class lrgGradientDescentSweep
+{
+private:
+    unsigned int m_threads;
+    unsigned int m_reduction;
+    unsigned int m_minimum_iterations;
+    pdd m_initial_thetas;
+    unsigned long m_total_iterations;
+    std::vector<lrgSweepResult> m_leaderboard;
+
+public:
+    lrgGradientDescentSweep();
+    ~lrgGradientDescentSweep();
+
+    // Default: one thread per hardware thread.
+    void SetThreads(unsigned int &threads);
+
+    // The share of the configurations kept at every rung is 1 / reduction. Default: 2 (halving).
+    void SetReduction(unsigned int &reduction);
+
+    // The iterations of rung 0. Default: 0, which picks them so that the last rung runs all the iterations.
+    void SetMinimumIterations(unsigned int &iterations);
+
+    // Every configuration starts from these thetas, so they are compared fairly. Default: (0, 0).
+    void SetInitialThetas(const pdd &thetas);
+
+    // Every combination of the values, with a fixed step size and momentum 0.9.
+    static std::vector<lrgSweepConfiguration> Grid(const std::vector<double> &etas,
+                                                   const std::vector<unsigned int> &iterations,
+                                                   const std::vector<lrgUpdateRule> &rules,
+                                                   const std::vector<lrgPreconditioner> &preconditioners = {lrgPreconditioner::None});
+
+    // Runs the sweep and returns the leaderboard (see GetLeaderboard).
+    const std::vector<lrgSweepResult> &Run(const pdd_vector &vec, const std::vector<lrgSweepConfiguration> &configurations);
+    const std::vector<lrgSweepResult> &Run(const lrgSufficientStatistics &stats,
+                                           const std::vector<lrgSweepConfiguration> &configurations);
+
+    // Every configuration of the last run: the ones that reached the furthest rung first, by loss,
+    // and the diverged ones last.
+    const std::vector<lrgSweepResult> &GetLeaderboard() const;
+    const lrgSweepResult &GetBest() const;
+
+    // The gradient descent iterations run over all the configurations and rungs.
+    unsigned long GetTotalIterations() const;
+};
+
+#endif
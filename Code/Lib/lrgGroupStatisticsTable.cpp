@@ -0,0 +1,99 @@
+#include "lrgGroupStatisticsTable.h"
+
+// capacity is rounded up to a power of two, so the slot of a hash is a bit mask instead of a division.
+lrgGroupStatisticsTable::lrgGroupStatisticsTable(size_t capacity)
+{
+    size_t slots = 16;
+    while (slots < capacity)
+    {
+        slots *= 2;
+    }
+    m_entries.resize(slots);
+    m_mask = slots - 1;
+    m_size = 0;
+}
+
+// Empty constructor. The table grows as keys arrive.
+lrgGroupStatisticsTable::lrgGroupStatisticsTable() : lrgGroupStatisticsTable(16) {}
+
+// Destructor
+lrgGroupStatisticsTable::~lrgGroupStatisticsTable() {}
+
+// The finaliser of splitmix64. Consecutive ids (the usual case) end up far apart in the table.
+size_t lrgGroupStatisticsTable::Hash(long long key)
+{
+    unsigned long long h = static_cast<unsigned long long>(key);
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+    h = h ^ (h >> 31);
+    return static_cast<size_t>(h);
+}
+
+lrgSufficientStatistics &lrgGroupStatisticsTable::Get(long long key)
+{
+    size_t slot = Hash(key) & m_mask;
+    while (m_entries[slot].used)
+    {
+        if (m_entries[slot].key == key)
+        {
+            return m_entries[slot].stats;
+        }
+        slot = (slot + 1) & m_mask;
+    }
+
+    // A new key. Keep the table at most half full, so the probe sequences stay short.
+    if (2 * (m_size + 1) > m_entries.size())
+    {
+        Grow();
+        return Get(key);
+    }
+    m_entries[slot].used = true;
+    m_entries[slot].key = key;
+    m_size++;
+    return m_entries[slot].stats;
+}
+
+void lrgGroupStatisticsTable::Prefetch(long long key) const
+{
+#if defined(__GNUC__)
+    __builtin_prefetch(&m_entries[Hash(key) & m_mask], 1);
+#endif
+}
+
+// Reinserts every key into a table twice as big.
+void lrgGroupStatisticsTable::Grow()
+{
+    std::vector<Entry> old_entries(2 * m_entries.size());
+    old_entries.swap(m_entries);
+    m_mask = m_entries.size() - 1;
+    m_size = 0;
+
+    for (const auto &entry : old_entries)
+    {
+        if (entry.used)
+        {
+            Get(entry.key) = entry.stats;
+        }
+    }
+}
+
+void lrgGroupStatisticsTable::Merge(const lrgGroupStatisticsTable &other)
+{
+    for (const auto &entry : other.m_entries)
+    {
+        if (entry.used)
+        {
+            Get(entry.key).Merge(entry.stats);
+        }
+    }
+}
+
+size_t lrgGroupStatisticsTable::GetSize() const
+{
+    return m_size;
+}
+
+const std::vector<lrgGroupStatisticsTable::Entry> &lrgGroupStatisticsTable::GetEntries() const
+{
+    return m_entries;
+}
@@ -0,0 +1,52 @@
+#ifndef lrgGroupStatisticsTable_h
+#define lrgGroupStatisticsTable_h
+#include "lrgSufficientStatistics.h"
+#include <vector>
+#include <cstddef>
+
+// A hash table from an integer key to the statistics of its group.
+// It uses open addressing with linear probing: all the entries sit in one array, every entry fills exactly
+// one cache line, and a lookup usually reads a single line. A std::unordered_map would allocate a node per
+// key and chase a pointer for every lookup. The table doubles when it is half full.
+class lrgGroupStatisticsTable
+{
+public:
+    struct alignas(64) Entry
+    {
+        long long key = 0;
+        bool used = false;
+        lrgSufficientStatistics stats;
+    };
+
+    lrgGroupStatisticsTable(size_t capacity);
+    lrgGroupStatisticsTable();
+    ~lrgGroupStatisticsTable();
+
+    // The statistics of key. A new key starts with empty statistics.
+    lrgSufficientStatistics &Get(long long key);
+
+    // Hints the CPU to load the slot of key into the cache. Calling it a few rows before Get(key)
+    // hides most of the cache miss of a big table.
+    void Prefetch(long long key) const;
+
+    // Merges every group of other into this table.
+    void Merge(const lrgGroupStatisticsTable &other);
+
+    // The number of keys.
+    size_t GetSize() const;
+
+    // All the slots of the table, used or not.
+    const std::vector<Entry> &GetEntries() const;
+
+    // The slot a key starts probing from is Hash(key) & (capacity - 1).
+    static size_t Hash(long long key);
+
+private:
+    std::vector<Entry> m_entries;
+    size_t m_mask;
+    size_t m_size;
+
+    void Grow();
+};
+
+#endif
@@ -0,0 +1,224 @@
+#include "lrgGroupedRegression.h"
+#include "lrgParallel.h"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <algorithm>
+#include <limits>
+#include <cstdlib>
+
+// Skips the spaces and tabs before the next value of a line. False if the line ends first.
+static bool next_value(const char *&p, const char *end)
+{
+    while (p < end && (*p == ' ' || *p == '\t'))
+    {
+        p++;
+    }
+    return p < end && *p != '\n' && *p != '\r';
+}
+
+// Parses the "key x y" lines in [begin, end) into table. end is the end of a line (or of the text).
+// strtoll/strtod are used directly on the buffer: no std::string and no stream per line.
+static void parse_lines(const char *begin, const char *end, lrgGroupStatisticsTable &table)
+{
+    const char *p = begin;
+    while (p < end)
+    {
+        // Skip empty lines.
+        if (*p == '\n' || *p == '\r' || *p == ' ' || *p == '\t')
+        {
+            p++;
+            continue;
+        }
+
+        char *next;
+        long long key = std::strtoll(p, &next, 10);
+        bool valid = (next != p);
+        p = next;
+
+        double values[2];
+        for (int k = 0; k < 2 && valid; k++)
+        {
+            valid = next_value(p, end);
+            if (valid)
+            {
+                values[k] = std::strtod(p, &next);
+                valid = (next != p);
+                p = next;
+            }
+        }
+
+        // Nothing but spaces may follow on the line.
+        if (! valid || next_value(p, end))
+        {
+            throw std::ios_base::failure("Every line needs three values (key, x and y)...");
+        }
+
+        table.Get(key).Add(values[0], values[1]);
+    }
+}
+
+// threads is the number of threads that gather the statistics.
+lrgGroupedRegression::lrgGroupedRegression(unsigned int &threads)
+{
+    m_threads = 1;
+    SetThreads(threads);
+}
+
+// Empty constructor. One thread per hardware thread.
+lrgGroupedRegression::lrgGroupedRegression()
+{
+    m_threads = lrgDefaultThreads();
+}
+
+// Destructor
+lrgGroupedRegression::~lrgGroupedRegression() {}
+
+void lrgGroupedRegression::SetThreads(unsigned int &threads)
+{
+    if (threads == 0)
+    {
+        throw std::invalid_argument("At least one thread is needed...");
+    }
+    m_threads = threads;
+}
+
+// Merges the thread-local tables and solves every group.
+std::vector<lrgGroupFit> lrgGroupedRegression::Solve(std::vector<lrgGroupStatisticsTable> &tables)
+{
+    // Merge into the biggest table, so the fewest keys have to move.
+    auto biggest = std::max_element(tables.begin(), tables.end(),
+                                    [](const lrgGroupStatisticsTable &a, const lrgGroupStatisticsTable &b)
+                                    { return a.GetSize() < b.GetSize(); });
+    std::swap(*biggest, tables.front());
+    for (size_t t = 1; t < tables.size(); t++)
+    {
+        tables.front().Merge(tables[t]);
+        tables[t] = lrgGroupStatisticsTable();
+    }
+    const lrgGroupStatisticsTable &table = tables.front();
+
+    // Gather the groups sorted by key into contiguous arrays (structure of arrays).
+    std::vector<const lrgGroupStatisticsTable::Entry *> entries;
+    entries.reserve(table.GetSize());
+    for (const auto &entry : table.GetEntries())
+    {
+        if (entry.used)
+        {
+            entries.push_back(&entry);
+        }
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](const lrgGroupStatisticsTable::Entry *a, const lrgGroupStatisticsTable::Entry *b)
+              { return a->key < b->key; });
+
+    size_t groups = entries.size();
+    std::vector<double> mean_x(groups), mean_y(groups), sxx(groups), sxy(groups), t0(groups), t1(groups);
+    for (size_t g = 0; g < groups; g++)
+    {
+        mean_x[g] = entries[g]->stats.GetMeanX();
+        mean_y[g] = entries[g]->stats.GetMeanY();
+        sxx[g] = entries[g]->stats.GetSxx();
+        sxy[g] = entries[g]->stats.GetSxy();
+    }
+
+    // The batch solve. No calls and no early exits in the loop, so the compiler turns it into SIMD code.
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    for (size_t g = 0; g < groups; g++)
+    {
+        double slope = (sxx[g] > 0) ? sxy[g] / sxx[g] : nan;
+        t1[g] = slope;
+        t0[g] = mean_y[g] - slope * mean_x[g];
+    }
+
+    std::vector<lrgGroupFit> fits(groups);
+    for (size_t g = 0; g < groups; g++)
+    {
+        fits[g] = {entries[g]->key, entries[g]->stats.GetWeight(), t0[g], t1[g]};
+    }
+    return fits;
+}
+
+std::vector<lrgGroupFit> lrgGroupedRegression::FitData(const std::vector<long long> &keys, const pdd_vector &vec)
+{
+    if (keys.size() != vec.size())
+    {
+        throw std::invalid_argument("Every point needs a key...");
+    }
+    if (vec.size() == 0)
+    {
+        throw std::length_error("Vector is empty...");
+    }
+
+    std::vector<lrgGroupStatisticsTable> tables(m_threads);
+    lrgParallelFor(m_threads, vec.size(), [&](unsigned int thread, size_t begin, size_t end)
+    {
+        lrgGroupStatisticsTable &table = tables[thread];
+        // The slots of the next rows are requested while the current row is added.
+        const size_t distance = 16;
+        for (size_t i = begin; i < end; i++)
+        {
+            if (i + distance < end)
+            {
+                table.Prefetch(keys[i + distance]);
+            }
+            table.Get(keys[i]).Add(vec[i].first, vec[i].second);
+        }
+    });
+
+    return Solve(tables);
+}
+
+// Every thread takes a contiguous piece of the text that starts and ends at a line break.
+std::vector<lrgGroupFit> lrgGroupedRegression::FitText(const std::string &text)
+{
+    const char *data = text.c_str();
+    size_t size = text.size();
+
+    std::vector<size_t> bounds(m_threads + 1, size);
+    bounds[0] = 0;
+    for (unsigned int t = 1; t < m_threads; t++)
+    {
+        size_t position = std::max(size * t / m_threads, bounds[t - 1]);
+        while (position > 0 && position < size && data[position - 1] != '\n')
+        {
+            position++;
+        }
+        bounds[t] = position;
+    }
+
+    std::vector<lrgGroupStatisticsTable> tables(m_threads);
+    lrgParallelRun(m_threads, [&](unsigned int thread)
+    {
+        parse_lines(data + bounds[thread], data + bounds[thread + 1], tables[thread]);
+    });
+
+    size_t keys = 0;
+    for (const auto &table : tables)
+    {
+        keys += table.GetSize();
+    }
+    if (keys == 0)
+    {
+        throw std::length_error("Vector is empty. Something went wrong when reading the input file...");
+    }
+
+    return Solve(tables);
+}
+
+std::vector<lrgGroupFit> lrgGroupedRegression::FitFile(const std::string &filepath)
+{
+    std::ifstream file(filepath, std::ios::in | std::ios::binary);
+    if (! file)
+    {
+        throw std::ios_base::failure("Reading file failed...");
+    }
+
+    // Read the whole file with a single call.
+    file.seekg(0, std::ios::end);
+    std::string text(static_cast<size_t>(file.tellg()), '\0');
+    file.seekg(0, std::ios::beg);
+    file.read(&text[0], text.size());
+
+    return FitText(text);
+}
@@ -0,0 +1,45 @@
+#ifndef lrgGroupedRegression_h
+#define lrgGroupedRegression_h
+#include "lrgLinearModelSolverStrategyI.h"
+#include "lrgGroupStatisticsTable.h"
+#include <string>
+#include <vector>
+
+// The fit of one group. weight is the number of points of the group.
+// Groups whose x-values are all equal have no slope, their thetas are NaN.
+struct lrgGroupFit
+{
+    long long key;
+    double weight;
+    double t0;
+    double t1;
+};
+
+// Fits one line per key, for data with many (millions of) keys and a few points per key.
+// Every thread gathers the statistics of its part of the data in its own lrgGroupStatisticsTable,
+// the tables are merged at the end, and then all the groups are solved in one vectorised loop.
+// The results are sorted by key.
+class lrgGroupedRegression
+{
+private:
+    unsigned int m_threads;
+
+    std::vector<lrgGroupFit> Solve(std::vector<lrgGroupStatisticsTable> &tables);
+
+public:
+    lrgGroupedRegression(unsigned int &threads);
+    lrgGroupedRegression();
+    ~lrgGroupedRegression();
+    void SetThreads(unsigned int &threads);
+
+    // keys[i] is the group of vec[i].
+    std::vector<lrgGroupFit> FitData(const std::vector<long long> &keys, const pdd_vector &vec);
+
+    // Text with one "key x y" line per point. Keys are integers (e.g. sensor or customer ids).
+    std::vector<lrgGroupFit> FitText(const std::string &text);
+
+    // Same for a file. The file is read into memory and parsed in parallel.
+    std::vector<lrgGroupFit> FitFile(const std::string &filepath);
+};
+
+#endif
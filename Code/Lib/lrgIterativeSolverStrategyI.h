@@ -0,0 +1,19 @@
+#ifndef lrgIterativeSolverStrategyI_h
+#define lrgIterativeSolverStrategyI_h
+#include "lrgLinearModelSolverStrategyI.h"
+
+// A solver that iterates from a starting point and can be told where to start (a warm start).
+// A good starting point, e.g. the solution of a previous fit on similar data, saves most of the iterations.
+class lrgIterativeSolverStrategyI : public lrgLinearModelSolverStrategyI
+{
+public:
+    virtual ~lrgIterativeSolverStrategyI() {}
+
+    // The following FitData() calls start from thetas (t0, t1).
+    virtual void SetInitialThetas(const pdd &thetas) = 0;
+
+    // Go back to the solver's own starting point.
+    virtual void ClearInitialThetas() = 0;
+};
+
+#endif
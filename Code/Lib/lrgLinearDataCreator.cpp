@@ -1,6 +1,8 @@
 #include "lrgLinearDataCreator.h"
 #include <random>
 #include <functional>
+#include <stdexcept>
+#include <cmath>
 
 
 // t0,t1 are the coefficients of the linear function: y = t1*x + t0 + noise
@@ -13,6 +15,8 @@ lrgLinearDataCreator::lrgLinearDataCreator(double t0, double t1, unsigned int si
     m_t1 = t1;
     m_size = size;
     m_vec_ptr = std::move(vec_ptr);
+    m_contamination = 0;
+    m_outlier_scale = 0;
 }
 
 // Empty constructor.
@@ -22,11 +26,23 @@ lrgLinearDataCreator::lrgLinearDataCreator()
     m_t0 = 0;
     m_t1 = 0;
     m_size = 0;
+    m_contamination = 0;
+    m_outlier_scale = 0;
 }
 
 // Destructor
 lrgLinearDataCreator::~lrgLinearDataCreator() {}
 
+void lrgLinearDataCreator::SetContamination(double fraction, double scale)
+{
+    if (fraction < 0 || fraction > 1)
+    {
+        throw std::invalid_argument("The fraction of outliers must be in [0, 1]...");
+    }
+    m_contamination = fraction;
+    m_outlier_scale = scale;
+}
+
 pdd_vector lrgLinearDataCreator::GetData()
 {
 
@@ -60,6 +76,11 @@ pdd_vector lrgLinearDataCreator::GetData()
     auto rand_x = std::bind(distribution, mt64);
     auto rand_noise = std::bind(noise_distribution, mt64);
 
+    // The outliers have their own generator, so they don't change the clean points.
+    std::mt19937_64 outlier_mt64(12345);
+    std::uniform_real_distribution<double> outlier_distribution(0.0, 1.0);
+    std::normal_distribution<double> outlier_size(0.0, 1.0);
+
     // Declare x, y, noise.
     double x;
     double y;
@@ -75,6 +96,10 @@ pdd_vector lrgLinearDataCreator::GetData()
         x = rand_x();
         noise = rand_noise();
         y = m_t1 * x + m_t0 + noise;
+        if (m_contamination > 0 && outlier_distribution(outlier_mt64) < m_contamination)
+        {
+            y += m_outlier_scale * (1 + std::abs(outlier_size(outlier_mt64)));
+        }
         m_vec_ptr->push_back(std::make_pair(x, y));
     }
 
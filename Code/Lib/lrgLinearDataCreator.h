@@ -13,11 +13,17 @@ public:
     ~lrgLinearDataCreator();
     virtual pdd_vector GetData();
 
+    // Turns a fraction of the points into gross outliers: their y is moved up by scale * (1 + |N(0, 1)|).
+    // The outliers use their own random numbers, so the clean points are the same as without contamination.
+    void SetContamination(double fraction, double scale);
+
 private:
     unsigned int m_size;
     double m_t0;
     double m_t1;
     shared_ptr_pdd_vector m_vec_ptr;
+    double m_contamination;
+    double m_outlier_scale;
 };
 
 #endif
\ No newline at end of file
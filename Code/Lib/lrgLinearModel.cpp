@@ -0,0 +1,220 @@
+#include "lrgLinearModel.h"
+#include "lrgLogisticRegressionSolverStrategy.h"
+#include "lrgParallel.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+
+// The logistic link scores this many rows, then takes their sigmoids while they are still in the L1 cache.
+static const size_t sigmoid_rows = 1024;
+
+lrgLink lrgLinkFromString(const std::string &name)
+{
+    if (name == "identity")
+    {
+        return lrgLink::Identity;
+    }
+    if (name == "logistic")
+    {
+        return lrgLink::Logistic;
+    }
+    throw std::invalid_argument("Invalid link: " + name);
+}
+
+lrgLinearModel::lrgLinearModel(pdd &thetas, lrgLink link) : lrgLinearModel(thetas)
+{
+    m_link = link;
+}
+
+lrgLinearModel::lrgLinearModel(pdd &thetas) : lrgLinearModel()
+{
+    SetThetas(thetas);
+}
+
+lrgLinearModel::lrgLinearModel()
+{
+    m_t0 = 0;
+    m_t1 = 0;
+    m_link = lrgLink::Identity;
+    m_threads = lrgDefaultThreads();
+    m_parallel_rows = 65536;
+}
+
+lrgLinearModel::~lrgLinearModel()
+{
+}
+
+void lrgLinearModel::SetThetas(pdd &thetas)
+{
+    if (! (std::isfinite(thetas.first) && std::isfinite(thetas.second)))
+    {
+        throw std::logic_error("Invalid values for thetas...");
+    }
+    m_t0 = thetas.first;
+    m_t1 = thetas.second;
+}
+
+void lrgLinearModel::SetLink(lrgLink link)
+{
+    m_link = link;
+}
+
+void lrgLinearModel::SetThreads(unsigned int &threads)
+{
+    if (threads == 0)
+    {
+        throw std::invalid_argument("The number of threads must be positive...");
+    }
+    m_threads = threads;
+}
+
+void lrgLinearModel::SetParallelRows(size_t &rows)
+{
+    if (rows == 0)
+    {
+        throw std::invalid_argument("The rows per thread must be positive...");
+    }
+    m_parallel_rows = rows;
+}
+
+pdd lrgLinearModel::GetThetas() const
+{
+    return std::make_pair(m_t0, m_t1);
+}
+
+lrgLink lrgLinearModel::GetLink() const
+{
+    return m_link;
+}
+
+size_t lrgLinearModel::GetParallelRows() const
+{
+    return m_parallel_rows;
+}
+
+double lrgLinearModel::Predict(double x) const
+{
+    double y;
+    predict_range(&x, 1, &y);
+    return y;
+}
+
+void lrgLinearModel::Predict(const double *x, size_t count, double *y) const
+{
+    // Every thread gets at least m_parallel_rows rows, or the batch stays on this thread.
+    size_t threads = std::min(size_t(m_threads), count / m_parallel_rows);
+    if (threads <= 1)
+    {
+        predict_range(x, count, y);
+        return;
+    }
+    lrgParallelFor(threads, count, [&](unsigned int, size_t begin, size_t end)
+    {
+        predict_range(x + begin, end - begin, y + begin);
+    });
+}
+
+void lrgLinearModel::Predict(const std::vector<double> &x, std::vector<double> &y) const
+{
+    y.resize(x.size());
+    Predict(x.data(), x.size(), y.data());
+}
+
+void lrgLinearModel::predict_range(const double *x, size_t count, double *y) const
+{
+    // Local copies: y could point at the members for all the compiler knows, which would stop it
+    // keeping the thetas in registers.
+    const double t0 = m_t0;
+    const double t1 = m_t1;
+    if (m_link == lrgLink::Identity)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            y[i] = t0 + t1 * x[i];
+        }
+        return;
+    }
+    for (size_t begin = 0; begin < count; begin += sigmoid_rows)
+    {
+        size_t rows = std::min(sigmoid_rows, count - begin);
+        for (size_t i = begin; i < begin + rows; i++)
+        {
+            y[i] = t0 + t1 * x[i];
+        }
+        lrgSigmoidKernel(y + begin, rows, y + begin);
+    }
+}
+
+size_t lrgLinearModel::PredictStream(std::istream &input, std::ostream &output) const
+{
+    std::vector<double> x(BlockRows), y(BlockRows);
+    std::string text;
+    char number[32];
+    size_t lines = 0;
+
+    // Scores the rows of the block and writes them out as one string.
+    auto flush = [&](size_t rows)
+    {
+        Predict(x.data(), rows, y.data());
+        text.clear();
+        for (size_t i = 0; i < rows; i++)
+        {
+            int length = std::snprintf(number, sizeof(number), "%.17g\n", y[i]);
+            text.append(number, length);
+        }
+        output.write(text.data(), text.size());
+    };
+
+    std::string line;
+    size_t rows = 0;
+    while (std::getline(input, line))
+    {
+        const char *begin = line.c_str();
+        char *end;
+        x[rows] = std::strtod(begin, &end);
+        if (end == begin)
+        {
+            // Blank lines are skipped, anything else without a number in front is an error.
+            if (line.find_first_not_of(" \t\r") == std::string::npos)
+            {
+                continue;
+            }
+            throw std::ios_base::failure("Every line needs an x-value: " + line);
+        }
+        rows++;
+        lines++;
+        if (rows == BlockRows)
+        {
+            flush(rows);
+            rows = 0;
+        }
+    }
+    if (rows > 0)
+    {
+        flush(rows);
+    }
+    output.flush();
+    if (! output)
+    {
+        throw std::ios_base::failure("Writing the predictions failed...");
+    }
+    return lines;
+}
+
+size_t lrgLinearModel::PredictFile(const std::string &input_path, const std::string &output_path) const
+{
+    std::ifstream input(input_path, std::ios::in);
+    if (! input)
+    {
+        throw std::ios_base::failure("Reading file failed...");
+    }
+    std::ofstream output(output_path, std::ios::out);
+    if (! output)
+    {
+        throw std::ios_base::failure("Writing file failed...");
+    }
+    return PredictStream(input, output);
+}
@@ -0,0 +1,80 @@
+#ifndef lrgLinearModel_h
+#define lrgLinearModel_h
+#include "lrgLinearModelSolverStrategyI.h"
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// What a model does with t0 + t1 x.
+enum class lrgLink
+{
+    Identity, // the line itself (least squares fits)
+    Logistic  // sigmoid(t0 + t1 x), the probability of label 1 (lrgLogisticRegressionSolverStrategy)
+};
+
+// Converts the keywords identity and logistic to an lrgLink.
+lrgLink lrgLinkFromString(const std::string &name);
+
+// A fitted line, for scoring new x-values: FitData of any strategy gives the thetas, the model predicts.
+//
+// Predict on a batch writes into a buffer of the caller, so scoring allocates nothing. The inner loop is a
+// plain multiply-add over contiguous doubles, which the compiler turns into SIMD instructions; the logistic
+// link runs the margins through lrgSigmoidKernel a block at a time, while the block is still in the cache.
+// Batches of at least GetParallelRows() rows per thread are split between the threads in contiguous ranges.
+//
+// PredictStream reads x-values (the first number of every line, so xy files work as they are) a block at a
+// time and writes one prediction per line, so files of any size are scored in constant memory.
+class lrgLinearModel
+{
+public:
+    // The rows scored and written at a time by PredictStream.
+    static const size_t BlockRows = 4096;
+
+    lrgLinearModel(pdd &thetas, lrgLink link);
+    lrgLinearModel(pdd &thetas);
+    lrgLinearModel();
+    ~lrgLinearModel();
+
+    void SetThetas(pdd &thetas);
+
+    // Default: lrgLink::Identity.
+    void SetLink(lrgLink link);
+
+    // Default: one per core.
+    void SetThreads(unsigned int &threads);
+
+    // The fewest rows per thread; smaller batches are not worth starting a thread for. Default: 65536.
+    void SetParallelRows(size_t &rows);
+
+    pdd GetThetas() const;
+    lrgLink GetLink() const;
+    size_t GetParallelRows() const;
+
+    // One x-value.
+    double Predict(double x) const;
+
+    // count x-values into the caller's buffer y of count values. y may be x, to score in place.
+    void Predict(const double *x, size_t count, double *y) const;
+
+    // The same, resizing y to the size of x.
+    void Predict(const std::vector<double> &x, std::vector<double> &y) const;
+
+    // Scores every line of input into a line of output and returns the number of predictions.
+    size_t PredictStream(std::istream &input, std::ostream &output) const;
+
+    // The same from the file input_path to the file output_path.
+    size_t PredictFile(const std::string &input_path, const std::string &output_path) const;
+
+private:
+    // Predict on one thread.
+    void predict_range(const double *x, size_t count, double *y) const;
+
+    double m_t0;
+    double m_t1;
+    lrgLink m_link;
+    unsigned int m_threads;
+    size_t m_parallel_rows;
+};
+
+#endif
@@ -9,6 +9,7 @@ typedef std::pair<double, double> pdd;
 class lrgLinearModelSolverStrategyI
 {
 public:
+    virtual ~lrgLinearModelSolverStrategyI() {}
     virtual pdd FitData(pdd_vector vec) = 0;
 };
 
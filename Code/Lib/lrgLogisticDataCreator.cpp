@@ -0,0 +1,52 @@
+#include "lrgLogisticDataCreator.h"
+#include <random>
+#include <stdexcept>
+#include <cmath>
+
+// t0,t1 are the coefficients of the log odds: log(P(y = 1) / P(y = 0)) = t1*x + t0
+// size is the number of (x, y) pairs and vec_ptr points to the vector that hosts them.
+lrgLogisticDataCreator::lrgLogisticDataCreator(double t0, double t1, unsigned int size, shared_ptr_pdd_vector vec_ptr)
+{
+    m_t0 = t0;
+    m_t1 = t1;
+    m_size = size;
+    m_vec_ptr = std::move(vec_ptr);
+}
+
+// Empty constructor.
+lrgLogisticDataCreator::lrgLogisticDataCreator()
+{
+    m_t0 = 0;
+    m_t1 = 0;
+    m_size = 0;
+}
+
+// Destructor
+lrgLogisticDataCreator::~lrgLogisticDataCreator() {}
+
+pdd_vector lrgLogisticDataCreator::GetData()
+{
+    // The same checks as lrgLinearDataCreator.
+    if (m_t0 == 0 && m_t1 == 0 && m_size == 0)
+    {
+        throw std::invalid_argument("Class attributes have not been set correctly...");
+    }
+
+    if (m_size == 0)
+    {
+        throw std::invalid_argument("Vector size cannot be zero...");
+    }
+
+    std::mt19937_64 mt64;
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+
+    for (size_t i = 0; i < m_size; i++)
+    {
+        double x = distribution(mt64);
+        double probability = 1 / (1 + std::exp(-(m_t0 + m_t1 * x)));
+        double y = (distribution(mt64) < probability) ? 1 : 0;
+        m_vec_ptr->push_back(std::make_pair(x, y));
+    }
+
+    return (*m_vec_ptr);
+}
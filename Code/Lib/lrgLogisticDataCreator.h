@@ -0,0 +1,23 @@
+#ifndef lrgLogisticDataCreator_h
+#define lrgLogisticDataCreator_h
+#include "lrgDataCreatorI.h"
+#include "lrgLinearDataCreator.h"
+#include <memory>
+
+// Binary classification data: x is uniform in [0, 1) and y is 1 with probability sigmoid(t0 + t1 * x), else 0.
+class lrgLogisticDataCreator : public lrgDataCreatorI
+{
+public:
+    lrgLogisticDataCreator(double t0, double t1, unsigned int size, shared_ptr_pdd_vector vec_ptr);
+    lrgLogisticDataCreator();
+    ~lrgLogisticDataCreator();
+    virtual pdd_vector GetData();
+
+private:
+    unsigned int m_size;
+    double m_t0;
+    double m_t1;
+    shared_ptr_pdd_vector m_vec_ptr;
+};
+
+#endif
@@ -0,0 +1,429 @@
+#include "lrgLogisticRegressionSolverStrategy.h"
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+// The most features for which lrgLogisticMethod::Auto picks Newton's method.
+static const long newton_features = 100;
+
+lrgLogisticMethod lrgLogisticMethodFromString(const std::string &name)
+{
+    if (name == "auto")
+    {
+        return lrgLogisticMethod::Auto;
+    }
+    if (name == "newton")
+    {
+        return lrgLogisticMethod::Newton;
+    }
+    if (name == "lbfgs")
+    {
+        return lrgLogisticMethod::LBFGS;
+    }
+    throw std::invalid_argument("Invalid logistic regression method: " + name);
+}
+
+// exp(x) = 2^n * exp(r) with n = round(x / ln 2) and |r| <= ln 2 / 2.
+// Adding 1.5 * 2^52 rounds x / ln 2 to an integer that ends up in the low bits of the sum, from where it goes
+// straight into the exponent bits of 2^n. exp(r) is its Taylor polynomial of degree 11, whose error
+// r^12 / 12! < 7e-15 is below the rounding of the rest.
+static inline double fast_exp(double x)
+{
+    const double shifter = 6755399441055744.0;
+    const double ln2_hi = 6.93147180369123816490e-01;
+    const double ln2_lo = 1.90821492927058770002e-10;
+
+    // Keep 2^n a normal number.
+    x = std::min(std::max(x, -708.0), 708.0);
+    double shifted = x * 1.4426950408889634074 + shifter;
+    double n = shifted - shifter;
+    double r = (x - n * ln2_hi) - n * ln2_lo;
+
+    double p = 1.0 / 39916800;
+    p = p * r + 1.0 / 3628800;
+    p = p * r + 1.0 / 362880;
+    p = p * r + 1.0 / 40320;
+    p = p * r + 1.0 / 5040;
+    p = p * r + 1.0 / 720;
+    p = p * r + 1.0 / 120;
+    p = p * r + 1.0 / 24;
+    p = p * r + 1.0 / 6;
+    p = p * r + 0.5;
+    p = p * r + 1.0;
+    p = p * r + 1.0;
+
+    unsigned long long bits;
+    std::memcpy(&bits, &shifted, sizeof(bits));
+    bits = (bits + 1023) << 52;
+    double scale;
+    std::memcpy(&scale, &bits, sizeof(scale));
+    return p * scale;
+}
+
+// log(1 + u) for u in [0, 1] as 2 atanh(s) = 2 (s + s^3 / 3 + s^5 / 5 + ...) with s = t / (2 + t).
+// Above u = sqrt(2) - 1, log(1 + u) = ln 2 + log(1 + t) with t = (u - 1) / 2, so |s| <= 0.172 and the terms
+// after s^21 / 21 are below 3e-17 of the sum. The polynomial is written out, so the loops calling it have no
+// control flow and can be vectorised.
+static inline double fast_log1p(double u)
+{
+    bool halve = (u > 0.41421356237309505);
+    double t = halve ? (u - 1) * 0.5 : u;
+    double s = t / (2 + t);
+    double s2 = s * s;
+    double series = 1.0 / 21;
+    series = series * s2 + 1.0 / 19;
+    series = series * s2 + 1.0 / 17;
+    series = series * s2 + 1.0 / 15;
+    series = series * s2 + 1.0 / 13;
+    series = series * s2 + 1.0 / 11;
+    series = series * s2 + 1.0 / 9;
+    series = series * s2 + 1.0 / 7;
+    series = series * s2 + 1.0 / 5;
+    series = series * s2 + 1.0 / 3;
+    series = series * s2 + 1.0;
+    return (halve ? 0.69314718055994530942 : 0.0) + 2 * s * series;
+}
+
+double lrgFastExp(double x)
+{
+    return fast_exp(x);
+}
+
+// log(sigmoid(z)) = -log(1 + exp(-z)) = -(max(-z, 0) + log(1 + exp(-|z|))).
+double lrgLogSigmoid(double z)
+{
+    return -(std::max(-z, 0.0) + fast_log1p(fast_exp(-std::abs(z))));
+}
+
+// With e = exp(-|z|) <= 1 nothing overflows: sigmoid(z) is 1 / (1 + e) for z >= 0 and e / (1 + e) below,
+// sigmoid(z) * (1 - sigmoid(z)) = e / (1 + e)^2 either way, and the log loss of label y is
+// log(1 + exp(z)) - y z = max(z, 0) + log(1 + e) - y z.
+template <bool with_weights>
+static double logistic_kernel(const double *margins, const double *labels, size_t count, double *residuals,
+                              double *weights)
+{
+    double loss = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        double z = margins[i];
+        double e = fast_exp(-std::abs(z));
+        double inverse = 1 / (1 + e);
+        double probability = ((z >= 0) ? 1.0 : e) * inverse;
+        residuals[i] = probability - labels[i];
+        if (with_weights)
+        {
+            weights[i] = e * inverse * inverse;
+        }
+        loss += std::max(z, 0.0) + fast_log1p(e) - labels[i] * z;
+    }
+    return loss;
+}
+
+double lrgLogisticKernel(const double *margins, const double *labels, size_t count, double *residuals,
+                         double *weights)
+{
+    return (weights != nullptr) ? logistic_kernel<true>(margins, labels, count, residuals, weights)
+                                : logistic_kernel<false>(margins, labels, count, residuals, weights);
+}
+
+void lrgSigmoidKernel(const double *margins, size_t count, double *probabilities)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        double z = margins[i];
+        double e = fast_exp(-std::abs(z));
+        probabilities[i] = ((z >= 0) ? 1.0 : e) / (1 + e);
+    }
+}
+
+lrgLogisticRegressionSolverStrategy::lrgLogisticRegressionSolverStrategy(double &lambda)
+    : lrgLogisticRegressionSolverStrategy()
+{
+    SetLambda(lambda);
+}
+
+lrgLogisticRegressionSolverStrategy::lrgLogisticRegressionSolverStrategy()
+{
+    m_lambda = 0;
+    m_method = lrgLogisticMethod::Auto;
+    m_iterations = 0;
+    m_tolerance = 1e-8;
+    m_memory = 10;
+    m_iterations_run = 0;
+    m_loss = 0;
+}
+
+lrgLogisticRegressionSolverStrategy::~lrgLogisticRegressionSolverStrategy()
+{
+}
+
+void lrgLogisticRegressionSolverStrategy::SetLambda(double &lambda)
+{
+    if (! (lambda >= 0))
+    {
+        throw std::invalid_argument("Lambda must not be negative...");
+    }
+    m_lambda = lambda;
+}
+
+void lrgLogisticRegressionSolverStrategy::SetMethod(lrgLogisticMethod method)
+{
+    m_method = method;
+}
+
+void lrgLogisticRegressionSolverStrategy::SetIterations(unsigned int &iterations)
+{
+    m_iterations = iterations;
+}
+
+void lrgLogisticRegressionSolverStrategy::SetTolerance(const double &tolerance)
+{
+    if (! (tolerance >= 0))
+    {
+        throw std::invalid_argument("The tolerance must not be negative...");
+    }
+    m_tolerance = tolerance;
+}
+
+void lrgLogisticRegressionSolverStrategy::SetMemory(unsigned int &memory)
+{
+    if (memory == 0)
+    {
+        throw std::invalid_argument("L-BFGS needs to remember at least one step...");
+    }
+    m_memory = memory;
+}
+
+unsigned int lrgLogisticRegressionSolverStrategy::GetIterationsRun() const
+{
+    return m_iterations_run;
+}
+
+double lrgLogisticRegressionSolverStrategy::GetLoss() const
+{
+    return m_loss;
+}
+
+// X = [1, x], two non-zeros per row (a zero x is stored too, it costs nothing).
+pdd lrgLogisticRegressionSolverStrategy::FitData(pdd_vector vec)
+{
+    if (vec.empty())
+    {
+        throw std::length_error("Vector is empty...");
+    }
+    lrgSparseDataset data;
+    data.X.resize(vec.size(), 2);
+    data.X.reserve(Eigen::VectorXi::Constant(vec.size(), 2));
+    data.y.resize(vec.size());
+    for (size_t i = 0; i < vec.size(); i++)
+    {
+        data.X.insert(i, 0) = 1;
+        data.X.insert(i, 1) = vec[i].first;
+        data.y(i) = vec[i].second;
+    }
+    data.X.makeCompressed();
+
+    Eigen::VectorXd thetas = FitData(data);
+    return std::make_pair(thetas(0), thetas(1));
+}
+
+Eigen::VectorXd lrgLogisticRegressionSolverStrategy::FitData(const lrgSparseDataset &data)
+{
+    if (data.X.rows() != data.y.size() || data.X.rows() == 0)
+    {
+        throw std::invalid_argument("X and y must have the same, non-zero number of rows...");
+    }
+
+    long N = data.X.rows();
+    long p = data.X.cols();
+    Eigen::VectorXd labels(N);
+    for (long i = 0; i < N; i++)
+    {
+        if (data.y(i) == 1)
+        {
+            labels(i) = 1;
+        }
+        else if (data.y(i) == 0 || data.y(i) == -1)
+        {
+            labels(i) = 0;
+        }
+        else
+        {
+            throw std::invalid_argument("The labels must be 0 and 1 (or -1 and 1)...");
+        }
+    }
+
+    bool newton = (m_method == lrgLogisticMethod::Newton) ||
+                  (m_method == lrgLogisticMethod::Auto && p <= newton_features);
+    unsigned int max_iterations = (m_iterations > 0) ? m_iterations : (newton ? 100 : 1000);
+
+    // One pass: the margins, the kernel and, if asked for, the gradient X^T r / N + lambda * thetas.
+    Eigen::VectorXd margins(N), residuals(N), weights(N);
+    auto objective = [&](const Eigen::VectorXd &thetas, Eigen::VectorXd *gradient, bool with_weights) -> double
+    {
+        margins.noalias() = data.X * thetas;
+        double loss = lrgLogisticKernel(margins.data(), labels.data(), N, residuals.data(),
+                                        with_weights ? weights.data() : nullptr) / N;
+        loss += 0.5 * m_lambda * thetas.tail(p - 1).squaredNorm();
+        if (gradient != nullptr)
+        {
+            *gradient = data.X.transpose() * residuals / N;
+            gradient->tail(p - 1) += m_lambda * thetas.tail(p - 1);
+        }
+        return loss;
+    };
+
+    Eigen::VectorXd thetas = Eigen::VectorXd::Zero(p);
+    Eigen::VectorXd gradient(p);
+    m_iterations_run = 0;
+    m_loss = objective(thetas, &gradient, newton);
+
+    if (newton)
+    {
+        std::vector<std::pair<long, double>> row;
+        for (unsigned int iteration = 0; iteration < max_iterations; iteration++)
+        {
+            if (gradient.lpNorm<Eigen::Infinity>() <= m_tolerance)
+            {
+                break;
+            }
+            m_iterations_run++;
+
+            // The Hessian X^T W X / N + lambda, from the pairs of non-zeros of every row.
+            Eigen::MatrixXd hessian = Eigen::MatrixXd::Zero(p, p);
+            for (long i = 0; i < N; i++)
+            {
+                row.clear();
+                for (lrgSparseMatrix::InnerIterator it(data.X, i); it; ++it)
+                {
+                    row.push_back(std::make_pair(long(it.col()), it.value()));
+                }
+                for (size_t a = 0; a < row.size(); a++)
+                {
+                    double weighted = weights(i) * row[a].second;
+                    for (size_t b = a; b < row.size(); b++)
+                    {
+                        hessian(row[a].first, row[b].first) += weighted * row[b].second;
+                    }
+                }
+            }
+            Eigen::MatrixXd full = hessian.selfadjointView<Eigen::Upper>();
+            full /= N;
+            full.diagonal().tail(p - 1).array() += m_lambda;
+
+            // Without a penalty, on (almost) separable data the Hessian can be singular: then go down the gradient.
+            Eigen::VectorXd direction = -full.ldlt().solve(gradient);
+            double slope = gradient.dot(direction);
+            if (! std::isfinite(slope) || slope >= 0)
+            {
+                direction = -gradient;
+                slope = -gradient.squaredNorm();
+            }
+
+            double step = 1;
+            bool moved = false;
+            for (int trial = 0; trial < 60; trial++)
+            {
+                Eigen::VectorXd candidate = thetas + step * direction;
+                if (objective(candidate, nullptr, false) <= m_loss + 1e-4 * step * slope)
+                {
+                    thetas = candidate;
+                    moved = true;
+                    break;
+                }
+                step /= 2;
+            }
+            m_loss = objective(thetas, &gradient, true);
+            if (! moved)
+            {
+                break;
+            }
+        }
+        return thetas;
+    }
+
+    // L-BFGS: the two-loop recursion over the last m_memory steps s and gradient changes y.
+    std::deque<Eigen::VectorXd> steps, changes;
+    std::deque<double> rhos;
+    for (unsigned int iteration = 0; iteration < max_iterations; iteration++)
+    {
+        if (gradient.lpNorm<Eigen::Infinity>() <= m_tolerance)
+        {
+            break;
+        }
+        m_iterations_run++;
+
+        Eigen::VectorXd direction = gradient;
+        std::vector<double> alphas(steps.size());
+        for (size_t k = steps.size(); k-- > 0;)
+        {
+            alphas[k] = rhos[k] * steps[k].dot(direction);
+            direction -= alphas[k] * changes[k];
+        }
+        if (steps.empty())
+        {
+            // No curvature known yet: a first step of length at most 1.
+            direction /= std::max(1.0, gradient.norm());
+        }
+        else
+        {
+            direction *= steps.back().dot(changes.back()) / changes.back().squaredNorm();
+        }
+        for (size_t k = 0; k < steps.size(); k++)
+        {
+            double beta = rhos[k] * changes[k].dot(direction);
+            direction += (alphas[k] - beta) * steps[k];
+        }
+        direction = -direction;
+        double slope = gradient.dot(direction);
+        if (! (slope < 0))
+        {
+            direction = -gradient;
+            slope = -gradient.squaredNorm();
+            steps.clear();
+            changes.clear();
+            rhos.clear();
+        }
+
+        double step = 1;
+        bool moved = false;
+        Eigen::VectorXd candidate_gradient(p);
+        for (int trial = 0; trial < 60; trial++)
+        {
+            Eigen::VectorXd candidate = thetas + step * direction;
+            double loss = objective(candidate, &candidate_gradient, false);
+            if (loss <= m_loss + 1e-4 * step * slope)
+            {
+                Eigen::VectorXd s = candidate - thetas;
+                Eigen::VectorXd y = candidate_gradient - gradient;
+                double curvature = s.dot(y);
+                if (curvature > 1e-12 * s.norm() * y.norm())
+                {
+                    steps.push_back(s);
+                    changes.push_back(y);
+                    rhos.push_back(1 / curvature);
+                    if (steps.size() > m_memory)
+                    {
+                        steps.pop_front();
+                        changes.pop_front();
+                        rhos.pop_front();
+                    }
+                }
+                thetas = candidate;
+                gradient = candidate_gradient;
+                m_loss = loss;
+                moved = true;
+                break;
+            }
+            step /= 2;
+        }
+        if (! moved)
+        {
+            break;
+        }
+    }
+    return thetas;
+}
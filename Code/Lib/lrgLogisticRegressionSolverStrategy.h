@@ -0,0 +1,83 @@
+#ifndef lrgLogisticRegressionSolverStrategy_h
+#define lrgLogisticRegressionSolverStrategy_h
+#include "lrgLinearModelSolverStrategyI.h"
+#include "lrgSparseLinearModelSolverStrategyI.h"
+#include <cstddef>
+#include <string>
+
+// How the logistic regression is optimised.
+enum class lrgLogisticMethod
+{
+    Auto,   // Newton for up to 100 features, L-BFGS above
+    Newton, // Newton's method (IRLS): a p x p Hessian every iteration, few iterations
+    LBFGS   // limited-memory BFGS: O(p) per iteration besides the passes over the data
+};
+
+// Converts the command line keywords (auto, newton, lbfgs) to an lrgLogisticMethod.
+lrgLogisticMethod lrgLogisticMethodFromString(const std::string &name);
+
+// exp(x) for every x, with a relative error below 1e-13: 2^n from the exponent bits and a degree 11
+// polynomial on the rest. No branch and no library call, so loops over it can be vectorised.
+double lrgFastExp(double x);
+
+// log(sigmoid(z)) = -log(1 + exp(-z)) without overflow or cancellation for any z.
+double lrgLogSigmoid(double z);
+
+// The kernel of every pass: for the margins z = X thetas and the labels (0 or 1) of count samples it writes
+// the residuals sigmoid(z) - label and, if weights is not null, the IRLS weights sigmoid(z) * (1 - sigmoid(z)),
+// and returns the sum of the log losses -log(sigmoid(z)) or -log(1 - sigmoid(z)).
+double lrgLogisticKernel(const double *margins, const double *labels, size_t count, double *residuals,
+                         double *weights);
+
+// sigmoid(z) = 1 / (1 + exp(-z)) of count margins, in one vectorised loop. probabilities may be margins.
+void lrgSigmoidKernel(const double *margins, size_t count, double *probabilities);
+
+// Logistic regression for binary labels: P(y = 1) = sigmoid(X thetas), fitted by minimising the mean log loss
+// plus lambda / 2 times the squared thetas (all but the intercept). The labels must be 0 or 1, or -1 or 1 as in
+// most libsvm files. On separable data the thetas without a penalty grow until the gradient is small enough.
+//
+// Both methods take a backtracking line search on the loss. A pass over the data computes the margins and
+// runs lrgLogisticKernel, so the exps of all the samples are done in one vectorised loop.
+class lrgLogisticRegressionSolverStrategy : public lrgLinearModelSolverStrategyI, public lrgSparseLinearModelSolverStrategyI
+{
+private:
+    double m_lambda;
+    lrgLogisticMethod m_method;
+    unsigned int m_iterations;
+    double m_tolerance;
+    unsigned int m_memory;
+    unsigned int m_iterations_run;
+    double m_loss;
+
+public:
+    lrgLogisticRegressionSolverStrategy(double &lambda);
+    lrgLogisticRegressionSolverStrategy();
+    ~lrgLogisticRegressionSolverStrategy();
+
+    // The L2 penalty. Default: 0.
+    void SetLambda(double &lambda);
+
+    // Default: lrgLogisticMethod::Auto.
+    void SetMethod(lrgLogisticMethod method);
+
+    // The most iterations. Default: 0, which means 100 for Newton and 1000 for L-BFGS.
+    void SetIterations(unsigned int &iterations);
+
+    // Stop when no component of the gradient is larger. Default: 1e-8.
+    void SetTolerance(const double &tolerance);
+
+    // The pairs of steps and gradient changes L-BFGS remembers. Default: 10.
+    void SetMemory(unsigned int &memory);
+
+    // The iterations and the penalised mean log loss of the last fit.
+    unsigned int GetIterationsRun() const;
+    double GetLoss() const;
+
+    // One feature: the labels in the second element of the pairs, thetas = (intercept, slope).
+    virtual pdd FitData(pdd_vector vec);
+
+    // Column 0 of X is the intercept (see lrgSparseFileLoader).
+    virtual Eigen::VectorXd FitData(const lrgSparseDataset &data);
+};
+
+#endif
@@ -1,17 +1,176 @@
 #include "lrgNormalEquationSolverStrategy.h"
+#include "lrgSufficientStatistics.h"
 #include <Eigen/Dense>
 #include <unsupported/Eigen/NonLinearOptimization>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// The points summed in float before the block goes into the double totals. Short enough for the float sums
+// to keep about 6 digits, long enough for the vectorised loop to run at full speed.
+static const size_t float_block = 512;
 
 // Constructor
-lrgNormalEquationSolverStrategy::lrgNormalEquationSolverStrategy() {}
+lrgNormalEquationSolverStrategy::lrgNormalEquationSolverStrategy()
+{
+    m_precision = lrgPrecision::Double;
+    m_refinement = 10;
+    m_refinements_run = 0;
+}
 
 // Destructor
 lrgNormalEquationSolverStrategy::~lrgNormalEquationSolverStrategy() {}
 
+void lrgNormalEquationSolverStrategy::SetPrecision(lrgPrecision precision)
+{
+    m_precision = precision;
+}
+
+void lrgNormalEquationSolverStrategy::SetRefinement(unsigned int &iterations)
+{
+    m_refinement = iterations;
+}
+
+unsigned int lrgNormalEquationSolverStrategy::GetRefinementsRun() const
+{
+    return m_refinements_run;
+}
+
+// Mixed precision. Everything is relative to the first point (d = x - x0, e = y - y0), which costs nothing and
+// keeps float from losing the digits of x and y that matter when the data sit far away from zero.
+// The fit is e = a + b * d, and t1 = b, t0 = y0 + a - b * x0.
+static pdd fit_mixed(const pdd_vector &vec, unsigned int refinement, unsigned int &refinements_run)
+{
+    size_t N = vec.size();
+    double x0 = vec[0].first;
+    double y0 = vec[0].second;
+
+    // X^T X = [N, sum d; sum d, sum d^2] and X^T y = [sum e, sum d e], in float blocks of 8 lanes.
+    double sum_d = 0, sum_dd = 0, sum_e = 0, sum_de = 0, span = 0;
+    for (size_t begin = 0; begin < N; begin += float_block)
+    {
+        size_t end = std::min(begin + float_block, N);
+        float lane_d[8] = {0}, lane_dd[8] = {0}, lane_e[8] = {0}, lane_de[8] = {0}, lane_span[8] = {0};
+        size_t i = begin;
+        for (; i + 8 <= end; i += 8)
+        {
+            for (int lane = 0; lane < 8; lane++)
+            {
+                float d = float(vec[i + lane].first - x0);
+                float e = float(vec[i + lane].second - y0);
+                lane_d[lane] += d;
+                lane_dd[lane] += d * d;
+                lane_e[lane] += e;
+                lane_de[lane] += d * e;
+                lane_span[lane] = std::max(lane_span[lane], std::abs(d));
+            }
+        }
+        for (int lane = 0; i < end; i++, lane++)
+        {
+            float d = float(vec[i].first - x0);
+            float e = float(vec[i].second - y0);
+            lane_d[lane] += d;
+            lane_dd[lane] += d * d;
+            lane_e[lane] += e;
+            lane_de[lane] += d * e;
+            lane_span[lane] = std::max(lane_span[lane], std::abs(d));
+        }
+        for (int lane = 0; lane < 8; lane++)
+        {
+            sum_d += lane_d[lane];
+            sum_dd += lane_dd[lane];
+            sum_e += lane_e[lane];
+            sum_de += lane_de[lane];
+            span = std::max(span, double(lane_span[lane]));
+        }
+    }
+
+    // The float factorisation, with the columns scaled to unit diagonal so that float only sees the angle
+    // between them, not their lengths.
+    Eigen::Matrix2f gram;
+    gram << float(N), float(sum_d), float(sum_d), float(sum_dd);
+    Eigen::Vector2f scale(1 / std::sqrt(gram(0, 0)), (gram(1, 1) > 0) ? 1 / std::sqrt(gram(1, 1)) : 0);
+    Eigen::LDLT<Eigen::Matrix2f> ldlt(scale.asDiagonal() * gram * scale.asDiagonal());
+    auto solve_float = [&](double r0, double r1) -> Eigen::Vector2d
+    {
+        Eigen::Vector2f rhs((float)r0, (float)r1);
+        Eigen::Vector2f scaled = scale.cwiseProduct(ldlt.solve(scale.cwiseProduct(rhs)));
+        return scaled.cast<double>();
+    };
+
+    refinements_run = 0;
+    Eigen::Vector2d thetas = solve_float(sum_e, sum_de);
+    if (scale(1) == 0 || ! std::isfinite(thetas(0)) || ! std::isfinite(thetas(1)))
+    {
+        return std::make_pair(std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN());
+    }
+
+    // Iterative refinement: the residuals and X^T r in double, the correction from the float factors.
+    // Every step gains as many digits as float has left after the conditioning of X^T X, so it stops when a
+    // correction no longer moves the fitted values, or no longer shrinks.
+    double last_change = std::numeric_limits<double>::infinity();
+    for (unsigned int step = 0; step < refinement; step++)
+    {
+        double r_sum = 0, dr_sum = 0, rr_sum = 0;
+        for (size_t i = 0; i < N; i++)
+        {
+            double d = vec[i].first - x0;
+            double r = (vec[i].second - y0) - thetas(0) - thetas(1) * d;
+            r_sum += r;
+            dr_sum += d * r;
+            rr_sum += r * r;
+        }
+        Eigen::Vector2d correction = solve_float(r_sum, dr_sum);
+        thetas += correction;
+        refinements_run++;
+
+        // How far the correction moves the fitted values, against their size and the residuals.
+        double change = std::abs(correction(0)) + std::abs(correction(1)) * span;
+        double size = std::abs(thetas(0)) + std::abs(thetas(1)) * span + std::sqrt(rr_sum / N);
+        if (! (change > 1e-15 * size))
+        {
+            break;
+        }
+        if (! (change < 0.5 * last_change))
+        {
+            // Float cannot resolve X^T X: the corrections do not converge.
+            if (change > 1e-8 * size)
+            {
+                thetas(0) = std::numeric_limits<double>::quiet_NaN();
+            }
+            break;
+        }
+        last_change = change;
+    }
+    if (! std::isfinite(thetas(0)) || ! std::isfinite(thetas(1)))
+    {
+        return std::make_pair(std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN());
+    }
+    return std::make_pair(y0 + thetas(0) - thetas(1) * x0, thetas(1));
+}
+
 // It is more preferable that this method receives a pointer instead of the actual vector.
 // However, in the exercise sheet the method's declaration was set like this.
 pdd lrgNormalEquationSolverStrategy::FitData(pdd_vector vec)
 {
+    if (m_precision == lrgPrecision::Mixed && ! vec.empty())
+    {
+        pdd thetas = fit_mixed(vec, m_refinement, m_refinements_run);
+        if (! std::isnan(thetas.first))
+        {
+            return thetas;
+        }
+
+        // Float could not do it. The same answer as the double path below, from the centred moments in one pass.
+        lrgSufficientStatistics stats(vec);
+        if (stats.GetSxx() == 0)
+        {
+            throw std::logic_error("Invalid values for thetas...");
+        }
+        double t1 = stats.GetSxy() / stats.GetSxx();
+        return std::make_pair(stats.GetMeanY() - t1 * stats.GetMeanX(), t1);
+    }
+
     // We are going to use the size of the vector many times, so we create a variable.
     int vec_size = vec.size();
 
@@ -58,4 +217,69 @@ pdd lrgNormalEquationSolverStrategy::FitData(pdd_vector vec)
     }
 
     return thetas;
-}
\ No newline at end of file
+}
+
+// With the weighted means and co-moments the 2x2 normal equation has the closed form solution
+// t1 = Sxy / Sxx and t0 = mean_y - t1 * mean_x.
+pdd lrgNormalEquationSolverStrategy::FitData(const weighted_vector &vec)
+{
+    lrgSufficientStatistics stats(vec);
+
+    if (stats.GetWeight() == 0)
+    {
+        throw std::length_error("There are no samples with a positive weight...");
+    }
+    // All the (weighted) x-values are equal, so X^T W X is singular.
+    if (stats.GetSxx() == 0)
+    {
+        throw std::logic_error("Invalid values for thetas...");
+    }
+
+    double t1 = stats.GetSxy() / stats.GetSxx();
+    double t0 = stats.GetMeanY() - t1 * stats.GetMeanX();
+    return std::make_pair(t0, t1);
+}
+
+// On centred x the normal equation splits into Sxx * t1 = Sxy and t0 = mean_y - t1 * mean_x.
+// Sxx (the only "factorisation") does not depend on the targets, so it is computed once, and
+// Sxy = (x - mean_x)^T Y and the sums of Y come out of one product over the whole Y matrix.
+pdd_vector lrgNormalEquationSolverStrategy::FitData(const std::vector<double> &x, const std::vector<double> &targets,
+                                                    size_t target_count)
+{
+    size_t size = x.size();
+    if (size == 0)
+    {
+        throw std::length_error("Vector is empty...");
+    }
+    if (target_count == 0 || targets.size() != size * target_count)
+    {
+        throw std::invalid_argument("Every x-value needs one value of every target...");
+    }
+
+    Eigen::Map<const Eigen::VectorXd> x_vec(x.data(), size);
+    double mean_x = x_vec.mean();
+    double sxx = (x_vec.array() - mean_x).square().sum();
+
+    // All the x-values are equal, so X^T X is singular.
+    if (sxx == 0)
+    {
+        throw std::logic_error("Invalid values for thetas...");
+    }
+
+    // [1, x - mean_x]^T Y: the sums and the centred co-moments of all the targets in one pass.
+    Eigen::MatrixXd centred_x(size, 2);
+    centred_x.col(0).setOnes();
+    centred_x.col(1) = x_vec.array() - mean_x;
+    Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>> Y(targets.data(), size,
+                                                                                             target_count);
+    Eigen::MatrixXd rhs = centred_x.transpose() * Y;
+
+    pdd_vector thetas(target_count);
+    for (size_t t = 0; t < target_count; t++)
+    {
+        double t1 = rhs(1, t) / sxx;
+        double t0 = rhs(0, t) / size - t1 * mean_x;
+        thetas[t] = std::make_pair(t0, t1);
+    }
+    return thetas;
+}
@@ -1,13 +1,49 @@
 #ifndef lrgNormalEquationSolverStrategy_h
 #define lrgNormalEquationSolverStrategy_h
 #include "lrgLinearModelSolverStrategyI.h"
+#include "lrgWeightedLinearModelSolverStrategyI.h"
+#include <cstddef>
 
-class lrgNormalEquationSolverStrategy : public lrgLinearModelSolverStrategyI
+// The floating point type X^T X is formed and factorised in.
+enum class lrgPrecision
 {
+    Double, // everything in double
+    Mixed   // X^T X in float, then iterative refinement with double residuals
+};
+
+class lrgNormalEquationSolverStrategy : public lrgLinearModelSolverStrategyI, public lrgWeightedLinearModelSolverStrategyI
+{
+private:
+    lrgPrecision m_precision;
+    unsigned int m_refinement;
+    unsigned int m_refinements_run;
+
 public:
     lrgNormalEquationSolverStrategy();
     ~lrgNormalEquationSolverStrategy();
+
+    // With lrgPrecision::Mixed FitData(pdd_vector) sums X^T X and X^T y in float (twice as many values per SIMD
+    // register) and solves in float. Up to SetRefinement steps then add the float solution of
+    // X^T X d = X^T (y - X thetas), with the residuals in double, until the thetas stop changing. Data that float
+    // cannot resolve fall back to the double solution. Default: lrgPrecision::Double.
+    void SetPrecision(lrgPrecision precision);
+
+    // The most refinement steps of the mixed precision fit. Default: 10.
+    void SetRefinement(unsigned int &iterations);
+
+    // The refinement steps of the last mixed precision fit.
+    unsigned int GetRefinementsRun() const;
+
     virtual pdd FitData(pdd_vector vec);
+
+    // Weighted least squares. The weighted X^T W X and X^T W y are gathered in one pass over the samples.
+    virtual pdd FitData(const weighted_vector &vec);
+
+    // Several y columns against the same x-values. targets holds the y-values row by row
+    // (row i is y_1(x_i), ..., y_T(x_i), i.e. targets.size() = x.size() * T) and the result has the thetas of
+    // every target. The x side of the normal equation is formed and solved once, the targets only add a
+    // single pass over their values (X^T Y for all of them together).
+    pdd_vector FitData(const std::vector<double> &x, const std::vector<double> &targets, size_t target_count);
 };
 
 #endif
\ No newline at end of file
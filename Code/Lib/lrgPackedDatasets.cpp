@@ -0,0 +1,84 @@
+#include "lrgPackedDatasets.h"
+#include <stdexcept>
+
+// Empty constructor. No datasets yet.
+lrgPackedDatasets::lrgPackedDatasets()
+{
+    m_offsets.push_back(0);
+}
+
+// Takes arrays that are already packed. The offsets must start at 0, never decrease and end at the size of x and y.
+lrgPackedDatasets::lrgPackedDatasets(const std::vector<size_t> &offsets, const std::vector<double> &x,
+                                     const std::vector<double> &y)
+{
+    if (x.size() != y.size())
+    {
+        throw std::invalid_argument("x and y must have the same size...");
+    }
+    if (offsets.empty() || offsets.front() != 0 || offsets.back() != x.size())
+    {
+        throw std::invalid_argument("The offsets must go from 0 to the number of points...");
+    }
+    for (size_t k = 1; k < offsets.size(); k++)
+    {
+        if (offsets[k] < offsets[k - 1])
+        {
+            throw std::invalid_argument("The offsets must not decrease...");
+        }
+    }
+    m_offsets = offsets;
+    m_x = x;
+    m_y = y;
+}
+
+// Destructor
+lrgPackedDatasets::~lrgPackedDatasets() {}
+
+void lrgPackedDatasets::Add(const pdd_vector &vec)
+{
+    for (const auto &xy : vec)
+    {
+        m_x.push_back(xy.first);
+        m_y.push_back(xy.second);
+    }
+    m_offsets.push_back(m_x.size());
+}
+
+void lrgPackedDatasets::Add(const double *x, const double *y, size_t size)
+{
+    m_x.insert(m_x.end(), x, x + size);
+    m_y.insert(m_y.end(), y, y + size);
+    m_offsets.push_back(m_x.size());
+}
+
+void lrgPackedDatasets::Reserve(size_t count, size_t points)
+{
+    m_offsets.reserve(m_offsets.size() + count);
+    m_x.reserve(m_x.size() + points);
+    m_y.reserve(m_y.size() + points);
+}
+
+size_t lrgPackedDatasets::GetCount() const
+{
+    return m_offsets.size() - 1;
+}
+
+size_t lrgPackedDatasets::GetSize(size_t k) const
+{
+    return m_offsets[k + 1] - m_offsets[k];
+}
+
+const std::vector<size_t> &lrgPackedDatasets::GetOffsets() const
+{
+    return m_offsets;
+}
+
+const std::vector<double> &lrgPackedDatasets::GetX() const
+{
+    return m_x;
+}
+
+const std::vector<double> &lrgPackedDatasets::GetY() const
+{
+    return m_y;
+}
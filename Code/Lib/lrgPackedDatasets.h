@@ -0,0 +1,37 @@
+#ifndef lrgPackedDatasets_h
+#define lrgPackedDatasets_h
+#include "lrgLinearModelSolverStrategyI.h"
+#include <vector>
+#include <cstddef>
+
+// Many small datasets in three flat arrays: the x-values and the y-values of all the datasets one after the
+// other, and the offsets where every dataset starts. Dataset k is [offsets[k], offsets[k + 1]),
+// so there is one offset more than there are datasets. No allocation per dataset.
+class lrgPackedDatasets
+{
+public:
+    lrgPackedDatasets();
+    lrgPackedDatasets(const std::vector<size_t> &offsets, const std::vector<double> &x, const std::vector<double> &y);
+    ~lrgPackedDatasets();
+
+    // Appends one dataset.
+    void Add(const pdd_vector &vec);
+    void Add(const double *x, const double *y, size_t size);
+
+    // Reserves room for count datasets with points points in total.
+    void Reserve(size_t count, size_t points);
+
+    // The number of datasets.
+    size_t GetCount() const;
+    size_t GetSize(size_t k) const;
+    const std::vector<size_t> &GetOffsets() const;
+    const std::vector<double> &GetX() const;
+    const std::vector<double> &GetY() const;
+
+private:
+    std::vector<size_t> m_offsets;
+    std::vector<double> m_x;
+    std::vector<double> m_y;
+};
+
+#endif
@@ -0,0 +1,62 @@
+#include "lrgParallel.h"
+#include <thread>
+#include <vector>
+#include <exception>
+#include <stdexcept>
+
+unsigned int lrgDefaultThreads()
+{
+    unsigned int threads = std::thread::hardware_concurrency();
+    return (threads == 0) ? 1 : threads;
+}
+
+// The calling thread runs task(0) itself, so a single thread costs nothing extra.
+void lrgParallelRun(unsigned int threads, const std::function<void(unsigned int)> &task)
+{
+    if (threads == 0)
+    {
+        throw std::invalid_argument("At least one thread is needed...");
+    }
+
+    std::vector<std::exception_ptr> errors(threads);
+    auto guarded = [&](unsigned int thread)
+    {
+        try
+        {
+            task(thread);
+        }
+        catch (...)
+        {
+            errors[thread] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned int thread = 1; thread < threads; thread++)
+    {
+        workers.emplace_back(guarded, thread);
+    }
+    guarded(0);
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+
+    for (auto &error : errors)
+    {
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+void lrgParallelFor(unsigned int threads, size_t count, const std::function<void(unsigned int, size_t, size_t)> &task)
+{
+    lrgParallelRun(threads, [&](unsigned int thread)
+    {
+        size_t begin = count * thread / threads;
+        size_t end = count * (thread + 1) / threads;
+        task(thread, begin, end);
+    });
+}
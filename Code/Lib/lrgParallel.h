@@ -0,0 +1,16 @@
+#ifndef lrgParallel_h
+#define lrgParallel_h
+#include <functional>
+#include <cstddef>
+
+// The number of threads to use when the user does not say: one per hardware thread.
+unsigned int lrgDefaultThreads();
+
+// Runs task(thread) for thread = 0 ... threads - 1, each on its own std::thread, and waits for all of them.
+// If a task throws, the first exception is rethrown after every thread has finished.
+void lrgParallelRun(unsigned int threads, const std::function<void(unsigned int)> &task);
+
+// Splits [0, count) into threads contiguous ranges and runs task(thread, begin, end) on each in parallel.
+void lrgParallelFor(unsigned int threads, size_t count, const std::function<void(unsigned int, size_t, size_t)> &task);
+
+#endif
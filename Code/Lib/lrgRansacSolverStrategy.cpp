@@ -0,0 +1,357 @@
+#include "lrgRansacSolverStrategy.h"
+#include "lrgSufficientStatistics.h"
+#include "lrgParallel.h"
+#include <stdexcept>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+// Hypotheses per block: a thread claims a block, scores it and folds it into the search.
+static const unsigned int lrgRansacBlock = 8;
+
+// Points per tile: the x and y of a tile (32 kB) stay in cache while the block of hypotheses is scored on it.
+static const size_t lrgRansacTile = 2048;
+
+// A counter-based generator (the SplitMix64 finaliser): the counter-th random number of the stream key.
+// Any thread can draw the numbers of any hypothesis without sharing or advancing a state.
+static inline unsigned long long counter_random(unsigned long long key, unsigned long long counter)
+{
+    unsigned long long z = key + 0x9e3779b97f4a7c15ULL * (counter + 1);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// The line through the two random points of hypothesis k. Two points with the same x have no line, so up to
+// 16 pairs are tried before the hypothesis is given up (NaN thetas, which have no inliers).
+static void draw_hypothesis(const double *x, const double *y, size_t N, unsigned long long seed, unsigned long long k,
+                            double &t0, double &t1)
+{
+    for (unsigned long long attempt = 0; attempt < 16; attempt++)
+    {
+        unsigned long long counter = 2 * (16 * k + attempt);
+        size_t i = counter_random(seed, counter) % N;
+        size_t j = counter_random(seed, counter + 1) % N;
+        if (x[i] != x[j])
+        {
+            t1 = (y[j] - y[i]) / (x[j] - x[i]);
+            t0 = y[i] - t1 * x[i];
+            return;
+        }
+    }
+    t0 = std::numeric_limits<double>::quiet_NaN();
+    t1 = std::numeric_limits<double>::quiet_NaN();
+}
+
+// The inliers of count hypotheses. The inner loop has no branches and vectorises.
+static void score_block(const double *x, const double *y, size_t N, const double *t0, const double *t1,
+                        unsigned int count, double threshold, size_t *inliers)
+{
+    for (unsigned int h = 0; h < count; h++)
+    {
+        inliers[h] = 0;
+    }
+    for (size_t begin = 0; begin < N; begin += lrgRansacTile)
+    {
+        size_t end = std::min(begin + lrgRansacTile, N);
+        for (unsigned int h = 0; h < count; h++)
+        {
+            double a = t0[h];
+            double b = t1[h];
+            size_t inside = 0;
+            for (size_t i = begin; i < end; i++)
+            {
+                inside += (std::abs(y[i] - a - b * x[i]) <= threshold);
+            }
+            inliers[h] += inside;
+        }
+    }
+}
+
+// 2.5 robust scales. The scale is the least 20% quantile of the absolute residuals of the first 64 lines,
+// measured on at most 4096 points spread over the data, divided by 0.2533 (the 20% quantile of |z| for normal
+// noise). The median would break down at 50% outliers, the 20% quantile only at 80%, but with fewer inliers
+// than half of the points the outliers near the line make the scale (and the threshold) a little too wide.
+static double automatic_threshold(const double *x, const double *y, size_t N, unsigned long long seed)
+{
+    size_t M = std::min<size_t>(N, 4096);
+    size_t quantile = M / 5;
+    std::vector<double> sizes(M);
+    double least_quantile = std::numeric_limits<double>::infinity();
+    double largest = 0;
+    unsigned int lines = 0;
+    for (unsigned long long k = 0; k < 1024 && lines < 64; k++)
+    {
+        double t0, t1;
+        draw_hypothesis(x, y, N, seed, k, t0, t1);
+        if (std::isnan(t1))
+        {
+            continue;
+        }
+        lines++;
+        for (size_t m = 0; m < M; m++)
+        {
+            size_t i = m * N / M;
+            sizes[m] = std::abs(y[i] - t0 - t1 * x[i]);
+            largest = std::max(largest, std::abs(y[i]));
+        }
+        std::nth_element(sizes.begin(), sizes.begin() + quantile, sizes.end());
+        least_quantile = std::min(least_quantile, sizes[quantile]);
+    }
+    if (lines == 0)
+    {
+        throw std::logic_error("Invalid values for thetas...");
+    }
+    // More than a fifth of the points exactly on a line: anything above rounding counts as off the line.
+    double threshold = 2.5 * least_quantile / 0.2533;
+    return (threshold > 0) ? threshold : 1e-12 * (1 + largest);
+}
+
+// The centred sums of the points within the threshold of the line, gathered in parallel. The sums are split
+// into fixed chunks and merged in order, so the rounding does not depend on the number of threads.
+static lrgSufficientStatistics refit_inliers(const double *x, const double *y, size_t N, double t0, double t1,
+                                             double threshold, unsigned int threads)
+{
+    size_t chunks = (N + 65535) / 65536;
+    std::vector<lrgSufficientStatistics> partial(chunks);
+    lrgParallelFor(threads, chunks, [&](unsigned int, size_t first_chunk, size_t last_chunk)
+    {
+        for (size_t chunk = first_chunk; chunk < last_chunk; chunk++)
+        {
+            lrgSufficientStatistics local;
+            size_t end = std::min(N, (chunk + 1) * 65536);
+            for (size_t i = chunk * 65536; i < end; i++)
+            {
+                if (std::abs(y[i] - t0 - t1 * x[i]) <= threshold)
+                {
+                    local.Add(x[i], y[i]);
+                }
+            }
+            partial[chunk] = local;
+        }
+    });
+    lrgSufficientStatistics stats;
+    for (auto &part : partial)
+    {
+        stats.Merge(part);
+    }
+    return stats;
+}
+
+// 1.4826 times the median absolute residual of the points within the threshold of the line.
+static double inlier_scale(const double *x, const double *y, size_t N, double t0, double t1, double threshold)
+{
+    std::vector<double> sizes;
+    for (size_t i = 0; i < N; i++)
+    {
+        double size = std::abs(y[i] - t0 - t1 * x[i]);
+        if (size <= threshold)
+        {
+            sizes.push_back(size);
+        }
+    }
+    if (sizes.empty())
+    {
+        return 0;
+    }
+    std::nth_element(sizes.begin(), sizes.begin() + sizes.size() / 2, sizes.end());
+    return 1.4826 * sizes[sizes.size() / 2];
+}
+
+lrgRansacSolverStrategy::lrgRansacSolverStrategy(double &threshold) : lrgRansacSolverStrategy()
+{
+    if (! (threshold > 0))
+    {
+        throw std::invalid_argument("The threshold must be positive...");
+    }
+    m_threshold = threshold;
+}
+
+lrgRansacSolverStrategy::lrgRansacSolverStrategy()
+{
+    m_threshold = 0;
+    m_confidence = 0.99;
+    m_max_hypotheses = 100000;
+    m_threads = lrgDefaultThreads();
+    m_seed = 5489;
+    m_hypotheses = 0;
+    m_inliers = 0;
+    m_threshold_used = 0;
+}
+
+lrgRansacSolverStrategy::~lrgRansacSolverStrategy()
+{
+}
+
+void lrgRansacSolverStrategy::SetConfidence(double &confidence)
+{
+    if (! (confidence > 0 && confidence < 1))
+    {
+        throw std::invalid_argument("The confidence must be in (0, 1)...");
+    }
+    m_confidence = confidence;
+}
+
+void lrgRansacSolverStrategy::SetMaxHypotheses(unsigned long &hypotheses)
+{
+    if (hypotheses == 0)
+    {
+        throw std::invalid_argument("At least one hypothesis is needed...");
+    }
+    m_max_hypotheses = hypotheses;
+}
+
+void lrgRansacSolverStrategy::SetThreads(unsigned int &threads)
+{
+    if (threads == 0)
+    {
+        throw std::invalid_argument("The number of threads must be positive...");
+    }
+    m_threads = threads;
+}
+
+void lrgRansacSolverStrategy::SetSeed(unsigned long seed)
+{
+    m_seed = seed;
+}
+
+unsigned long lrgRansacSolverStrategy::GetHypotheses() const
+{
+    return m_hypotheses;
+}
+
+size_t lrgRansacSolverStrategy::GetInliers() const
+{
+    return m_inliers;
+}
+
+double lrgRansacSolverStrategy::GetThreshold() const
+{
+    return m_threshold_used;
+}
+
+pdd lrgRansacSolverStrategy::FitData(pdd_vector vec)
+{
+    std::vector<double> x(vec.size()), y(vec.size());
+    for (size_t i = 0; i < vec.size(); i++)
+    {
+        x[i] = vec[i].first;
+        y[i] = vec[i].second;
+    }
+    return FitData(x.data(), y.data(), vec.size());
+}
+
+pdd lrgRansacSolverStrategy::FitData(const double *x, const double *y, size_t count)
+{
+    if (count == 0)
+    {
+        throw std::length_error("Vector is empty...");
+    }
+
+    size_t N = count;
+    double threshold = (m_threshold > 0) ? m_threshold : automatic_threshold(x, y, N, m_seed);
+    m_threshold_used = threshold;
+
+    // The best hypothesis of every block, written by whichever thread scored it.
+    size_t blocks = (m_max_hypotheses + lrgRansacBlock - 1) / lrgRansacBlock;
+    std::vector<size_t> block_inliers(blocks, 0);
+    std::vector<unsigned long> block_best(blocks, 0);
+    std::vector<char> block_done(blocks, 0);
+
+    // The threads start once and claim blocks until the search stops. Finished blocks are folded into the best
+    // hypothesis strictly in order, so the stop (and with it the result) is the same for any number of threads;
+    // blocks claimed past the stop are simply ignored.
+    std::atomic<size_t> next_block(0);
+    std::atomic<size_t> block_limit(blocks);
+    std::mutex mutex;
+    size_t folded = 0;
+    size_t best_inliers = 0;
+    unsigned long best = 0;
+    double log_failure = std::log(1 - m_confidence);
+
+    lrgParallelRun(m_threads, [&](unsigned int)
+    {
+        double t0[lrgRansacBlock], t1[lrgRansacBlock];
+        size_t inliers[lrgRansacBlock];
+        while (true)
+        {
+            size_t block = next_block.fetch_add(1);
+            if (block >= block_limit.load())
+            {
+                break;
+            }
+            unsigned long first = block * lrgRansacBlock;
+            unsigned int size = std::min<unsigned long>(lrgRansacBlock, m_max_hypotheses - first);
+            for (unsigned int h = 0; h < size; h++)
+            {
+                draw_hypothesis(x, y, N, m_seed, first + h, t0[h], t1[h]);
+            }
+            score_block(x, y, N, t0, t1, size, threshold, inliers);
+            unsigned int winner = 0;
+            for (unsigned int h = 1; h < size; h++)
+            {
+                if (inliers[h] > inliers[winner])
+                {
+                    winner = h;
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            block_inliers[block] = inliers[winner];
+            block_best[block] = first + winner;
+            block_done[block] = 1;
+            while (folded < block_limit.load() && block_done[folded])
+            {
+                if (block_inliers[folded] > best_inliers)
+                {
+                    best_inliers = block_inliers[folded];
+                    best = block_best[folded];
+                }
+                folded++;
+                // The hypotheses needed to draw two inliers at least once with the given confidence.
+                double w = double(best_inliers) / N;
+                double needed = (w >= 1) ? 0 : log_failure / std::log1p(-w * w);
+                if (folded * lrgRansacBlock >= needed)
+                {
+                    block_limit.store(folded);
+                }
+            }
+        }
+    });
+    m_hypotheses = std::min<unsigned long>(folded * lrgRansacBlock, m_max_hypotheses);
+
+    if (best_inliers < 2)
+    {
+        throw std::logic_error("Invalid values for thetas...");
+    }
+
+    // The normal equation on the inliers of the best line. An automatic threshold was measured on lines through
+    // random points and is too wide when there are many outliers, so it is measured again (twice) on the inliers
+    // of the refitted line, and the line refitted on the new inliers.
+    double t0, t1;
+    draw_hypothesis(x, y, N, m_seed, best, t0, t1);
+    lrgSufficientStatistics stats = refit_inliers(x, y, N, t0, t1, threshold, m_threads);
+    for (int refinement = 0; refinement < 2 && m_threshold == 0 && stats.GetSxx() > 0; refinement++)
+    {
+        t1 = stats.GetSxy() / stats.GetSxx();
+        t0 = stats.GetMeanY() - t1 * stats.GetMeanX();
+        double scale = inlier_scale(x, y, N, t0, t1, threshold);
+        if (! (scale > 0))
+        {
+            break;
+        }
+        threshold = 2.5 * scale;
+        stats = refit_inliers(x, y, N, t0, t1, threshold, m_threads);
+    }
+    m_threshold_used = threshold;
+    m_inliers = size_t(stats.GetWeight());
+    if (! (stats.GetSxx() > 0))
+    {
+        throw std::logic_error("Invalid values for thetas...");
+    }
+    double slope = stats.GetSxy() / stats.GetSxx();
+    return std::make_pair(stats.GetMeanY() - slope * stats.GetMeanX(), slope);
+}
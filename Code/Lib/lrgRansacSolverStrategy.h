@@ -0,0 +1,60 @@
+#ifndef lrgRansacSolverStrategy_h
+#define lrgRansacSolverStrategy_h
+#include "lrgLinearModelSolverStrategyI.h"
+#include <cstddef>
+
+// RANSAC: draw two random points, take the line through them as a hypothesis and count its inliers
+// (the points within the threshold of the line). After enough hypotheses the best one is almost surely
+// drawn from two inliers, and its inliers are refitted with the normal equation. Half of the points
+// or more can be outliers, as long as the inliers are the largest group on a single line.
+//
+// The threads claim blocks of 8 hypotheses until the search stops. Hypothesis k draws its points from
+// a counter-based generator keyed by (seed, k), so no random state is shared between threads and the result
+// does not depend on the number of threads. A block is scored one tile of points at a time, so the tile
+// stays in cache for all 8 hypotheses, with a branch-free (vectorised) inner loop. The search stops as soon as
+// 1 - (1 - w^2)^k reaches the confidence, where w is the inlier fraction of the best hypothesis so far
+// and k the number of hypotheses drawn.
+//
+// Without a threshold it is 2.5 times a robust scale, taken from the least 20% quantile of the absolute
+// residuals of the first 64 hypotheses (on at most 4096 of the points). That scale is too wide when many of
+// the points are outliers, so after the search it is measured twice more on the inliers of the refitted line.
+class lrgRansacSolverStrategy : public lrgLinearModelSolverStrategyI
+{
+private:
+    double m_threshold;
+    double m_confidence;
+    unsigned long m_max_hypotheses;
+    unsigned int m_threads;
+    unsigned long m_seed;
+    unsigned long m_hypotheses;
+    size_t m_inliers;
+    double m_threshold_used;
+
+public:
+    lrgRansacSolverStrategy(double &threshold);
+    lrgRansacSolverStrategy();
+    ~lrgRansacSolverStrategy();
+
+    // The probability of drawing at least one pair of inliers before stopping. Default: 0.99.
+    void SetConfidence(double &confidence);
+
+    // The most hypotheses to draw, whatever the confidence. Default: 100000.
+    void SetMaxHypotheses(unsigned long &hypotheses);
+
+    // Default: one thread per hardware thread.
+    void SetThreads(unsigned int &threads);
+
+    void SetSeed(unsigned long seed);
+
+    // The hypotheses drawn, the inliers of the best one and the threshold of the last fit.
+    unsigned long GetHypotheses() const;
+    size_t GetInliers() const;
+    double GetThreshold() const;
+
+    virtual pdd FitData(pdd_vector vec);
+
+    // The same on separate arrays of x and y, without copying them.
+    pdd FitData(const double *x, const double *y, size_t count);
+};
+
+#endif
@@ -0,0 +1,88 @@
+#include "lrgRecursiveLeastSquares.h"
+#include <stdexcept>
+
+// forgetting_factor must be in (0, 1]. 1 means that nothing is forgotten.
+lrgRecursiveLeastSquares::lrgRecursiveLeastSquares(double &forgetting_factor)
+{
+    m_forgetting_factor = 1;
+    SetForgettingFactor(forgetting_factor);
+}
+
+// Empty constructor. Nothing is forgotten, the thetas are those of ordinary least squares.
+lrgRecursiveLeastSquares::lrgRecursiveLeastSquares()
+{
+    m_forgetting_factor = 1;
+}
+
+// Destructor
+lrgRecursiveLeastSquares::~lrgRecursiveLeastSquares() {}
+
+void lrgRecursiveLeastSquares::SetForgettingFactor(double &forgetting_factor)
+{
+    if (!(forgetting_factor > 0 && forgetting_factor <= 1))
+    {
+        throw std::invalid_argument("The forgetting factor must be in (0, 1]...");
+    }
+    m_forgetting_factor = forgetting_factor;
+}
+
+// Down-weight the history, then add the new point with weight one.
+void lrgRecursiveLeastSquares::Update(double x, double y)
+{
+    if (m_forgetting_factor != 1)
+    {
+        m_stats.Forget(m_forgetting_factor);
+    }
+    m_stats.Add(x, y);
+}
+
+void lrgRecursiveLeastSquares::Update(double x, double y, double weight)
+{
+    if (m_forgetting_factor != 1)
+    {
+        m_stats.Forget(m_forgetting_factor);
+    }
+    m_stats.Add(x, y, weight);
+}
+
+void lrgRecursiveLeastSquares::Reset()
+{
+    m_stats = lrgSufficientStatistics();
+}
+
+// t1 = Sxy / Sxx and the line goes through the means.
+pdd lrgRecursiveLeastSquares::GetThetas() const
+{
+    if (m_stats.GetWeight() == 0)
+    {
+        throw std::logic_error("No points have been added yet...");
+    }
+    if (m_stats.GetSxx() == 0)
+    {
+        throw std::logic_error("All x-values are equal, the slope is undefined...");
+    }
+
+    double t1 = m_stats.GetSxy() / m_stats.GetSxx();
+    double t0 = m_stats.GetMeanY() - t1 * m_stats.GetMeanX();
+    return std::make_pair(t0, t1);
+}
+
+double lrgRecursiveLeastSquares::GetWeight() const
+{
+    return m_stats.GetWeight();
+}
+
+pdd lrgRecursiveLeastSquares::FitData(pdd_vector vec)
+{
+    if (vec.size() == 0)
+    {
+        throw std::length_error("Vector is empty...");
+    }
+
+    Reset();
+    for (const auto &item : vec)
+    {
+        Update(item.first, item.second);
+    }
+    return GetThetas();
+}
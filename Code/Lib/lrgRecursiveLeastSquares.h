@@ -0,0 +1,43 @@
+#ifndef lrgRecursiveLeastSquares_h
+#define lrgRecursiveLeastSquares_h
+#include "lrgLinearModelSolverStrategyI.h"
+#include "lrgSufficientStatistics.h"
+
+// Online least squares for a stream of points. Every Update() costs O(1) no matter how long the stream is,
+// and the current thetas can be read at any moment.
+// Instead of the classic RLS update of the inverse covariance matrix, which loses precision over long
+// streams, it keeps the running (centred) sufficient statistics. Both give the same thetas.
+// With a forgetting factor f < 1 the weight of a point decays by f with every newer point,
+// so the fit follows data that change over time. The effective memory is about 1 / (1 - f) points.
+class lrgRecursiveLeastSquares : public lrgLinearModelSolverStrategyI
+{
+private:
+    double m_forgetting_factor;
+    lrgSufficientStatistics m_stats;
+
+public:
+    lrgRecursiveLeastSquares(double &forgetting_factor);
+    lrgRecursiveLeastSquares();
+    ~lrgRecursiveLeastSquares();
+    void SetForgettingFactor(double &forgetting_factor);
+
+    // Add the newest point of the stream.
+    void Update(double x, double y);
+
+    // Add the newest point with a weight, e.g. the inverse of the variance of y.
+    void Update(double x, double y, double weight);
+
+    // Forget the whole stream.
+    void Reset();
+
+    // The thetas of all the points so far. Needs at least two different x-values.
+    pdd GetThetas() const;
+
+    // The (effective) number of points the thetas are based on.
+    double GetWeight() const;
+
+    // Feeds the whole vector through Update(), starting from an empty stream.
+    virtual pdd FitData(pdd_vector vec);
+};
+
+#endif
@@ -0,0 +1,283 @@
+#include "lrgRobustSolverStrategy.h"
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+
+// Weighted sums of the points, relative to the means of x and y so that the normal equation
+// does not lose its precision when the data sit far from zero.
+struct lrgRobustSums
+{
+    double w = 0;
+    double x = 0;
+    double y = 0;
+    double xx = 0;
+    double xy = 0;
+};
+
+// The weighted line through the sums, (intercept in the shifted units, slope).
+static pdd solve_sums(const lrgRobustSums &sums)
+{
+    if (! (sums.w > 0))
+    {
+        throw std::logic_error("Invalid values for thetas...");
+    }
+    double mean_x = sums.x / sums.w;
+    double mean_y = sums.y / sums.w;
+    double sxx = sums.xx - sums.x * mean_x;
+    double sxy = sums.xy - sums.x * mean_y;
+    if (! (sxx > 0))
+    {
+        throw std::logic_error("Invalid values for thetas...");
+    }
+    double t1 = sxy / sxx;
+    return std::make_pair(mean_y - t1 * mean_x, t1);
+}
+
+// The IRLS weight of a residual r for the threshold cs = c * s.
+static inline double robust_weight(lrgRobustLoss loss, double r, double cs)
+{
+    double size = std::abs(r);
+    if (loss == lrgRobustLoss::Huber)
+    {
+        return (size <= cs) ? 1 : cs / size;
+    }
+    if (size < cs)
+    {
+        double u = r / cs;
+        return (1 - u * u) * (1 - u * u);
+    }
+    return (size == 0) ? 1 : 0;
+}
+
+// The median absolute residual, scaled to be the standard deviation for normal noise.
+static double robust_scale(std::vector<double> &sizes)
+{
+    auto middle = sizes.begin() + sizes.size() / 2;
+    std::nth_element(sizes.begin(), middle, sizes.end());
+    return *middle / 0.6745;
+}
+
+// Converts a command line keyword to the loss.
+lrgRobustLoss lrgRobustLossFromString(const std::string &name)
+{
+    if (name == "huber")
+    {
+        return lrgRobustLoss::Huber;
+    }
+    else if (name == "tukey")
+    {
+        return lrgRobustLoss::Tukey;
+    }
+    throw std::invalid_argument("Invalid loss: " + name);
+}
+
+lrgRobustSolverStrategy::lrgRobustSolverStrategy(lrgRobustLoss loss, double &tuning)
+{
+    if (! (tuning > 0))
+    {
+        throw std::invalid_argument("The tuning constant must be positive...");
+    }
+    m_loss = loss;
+    m_tuning = tuning;
+    m_iterations = 100;
+    m_tolerance = 1e-10;
+    m_low_rank = true;
+    m_iterations_run = 0;
+    m_points_updated = 0;
+    m_scale = 0;
+}
+
+// The usual tuning constant of the loss.
+lrgRobustSolverStrategy::lrgRobustSolverStrategy(lrgRobustLoss loss)
+{
+    m_loss = loss;
+    m_tuning = (loss == lrgRobustLoss::Huber) ? 1.345 : 4.685;
+    m_iterations = 100;
+    m_tolerance = 1e-10;
+    m_low_rank = true;
+    m_iterations_run = 0;
+    m_points_updated = 0;
+    m_scale = 0;
+}
+
+// Empty constructor. Huber loss.
+lrgRobustSolverStrategy::lrgRobustSolverStrategy() : lrgRobustSolverStrategy(lrgRobustLoss::Huber) {}
+
+// Destructor
+lrgRobustSolverStrategy::~lrgRobustSolverStrategy() {}
+
+void lrgRobustSolverStrategy::SetIterations(unsigned int &iterations)
+{
+    m_iterations = iterations;
+}
+
+void lrgRobustSolverStrategy::SetTolerance(double &tolerance)
+{
+    if (tolerance < 0)
+    {
+        throw std::invalid_argument("The tolerance cannot be negative...");
+    }
+    m_tolerance = tolerance;
+}
+
+void lrgRobustSolverStrategy::SetLowRankUpdates(bool low_rank)
+{
+    m_low_rank = low_rank;
+}
+
+unsigned int lrgRobustSolverStrategy::GetIterationsRun() const
+{
+    return m_iterations_run;
+}
+
+unsigned long lrgRobustSolverStrategy::GetPointsUpdated() const
+{
+    return m_points_updated;
+}
+
+double lrgRobustSolverStrategy::GetScale() const
+{
+    return m_scale;
+}
+
+const std::vector<double> &lrgRobustSolverStrategy::GetWeights() const
+{
+    return m_weights;
+}
+
+pdd lrgRobustSolverStrategy::FitData(pdd_vector vec)
+{
+    size_t size = vec.size();
+    if (size == 0)
+    {
+        throw std::length_error("Vector is empty...");
+    }
+
+    double x0 = 0, y0 = 0;
+    for (const auto &xy : vec)
+    {
+        x0 += xy.first;
+        y0 += xy.second;
+    }
+    x0 /= size;
+    y0 /= size;
+
+    // Ordinary least squares: every weight is 1.
+    lrgRobustSums sums;
+    for (const auto &xy : vec)
+    {
+        double dx = xy.first - x0;
+        double dy = xy.second - y0;
+        sums.w += 1;
+        sums.x += dx;
+        sums.y += dy;
+        sums.xx += dx * dx;
+        sums.xy += dx * dy;
+    }
+    pdd thetas = solve_sums(sums);
+    m_weights.assign(size, 1);
+    m_iterations_run = 0;
+    m_points_updated = size;
+
+    // The scale of the least squares residuals.
+    std::vector<double> sizes(size);
+    for (size_t i = 0; i < size; i++)
+    {
+        sizes[i] = std::abs(vec[i].second - y0 - thetas.first - thetas.second * (vec[i].first - x0));
+    }
+    m_scale = robust_scale(sizes);
+
+    // Tukey's loss is not convex, so it starts from the Huber fit.
+    std::vector<std::pair<lrgRobustLoss, double>> phases;
+    if (m_loss == lrgRobustLoss::Tukey)
+    {
+        phases.push_back(std::make_pair(lrgRobustLoss::Huber, 1.345));
+    }
+    phases.push_back(std::make_pair(m_loss, m_tuning));
+
+    // The median absolute residual hardly moves between iterations. The pass only keeps the residuals
+    // in a window around the last median and counts the ones below it, so the new median is selected
+    // from a few percent of the points. If it falls outside the window, the residuals are computed again.
+    std::vector<double> window(size + 1);
+
+    for (const auto &phase : phases)
+    {
+        lrgRobustLoss loss = phase.first;
+        bool low_rank = m_low_rank && loss == lrgRobustLoss::Huber;
+
+        for (unsigned int iteration = 0; iteration < m_iterations; iteration++)
+        {
+            double cs = phase.second * m_scale;
+            double intercept = thetas.first;
+            double slope = thetas.second;
+            double median = 0.6745 * m_scale;
+            double window_lower = 0.9 * median;
+            double window_upper = 1.1 * median;
+            size_t below = 0;
+            size_t inside = 0;
+
+            if (! low_rank)
+            {
+                sums = lrgRobustSums();
+            }
+
+            // The fused pass: residual, weight, weighted sums and the scale together.
+            // In low-rank mode only the change of the weight is added, and only if there is one.
+            unsigned long updated = 0;
+            for (size_t i = 0; i < size; i++)
+            {
+                double dx = vec[i].first - x0;
+                double dy = vec[i].second - y0;
+                double r = dy - intercept - slope * dx;
+                double residual = std::abs(r);
+                // Without branches: the residual is always written, but only kept if it is inside.
+                below += (residual < window_lower);
+                window[inside] = residual;
+                inside += (residual >= window_lower && residual <= window_upper);
+
+                double w = robust_weight(loss, r, cs);
+                double change = low_rank ? w - m_weights[i] : w;
+                m_weights[i] = w;
+                if (change != 0)
+                {
+                    sums.w += change;
+                    sums.x += change * dx;
+                    sums.y += change * dy;
+                    sums.xx += change * dx * dx;
+                    sums.xy += change * dx * dy;
+                    updated++;
+                }
+            }
+            m_points_updated += low_rank ? updated : size;
+
+            // The same element robust_scale() would pick.
+            size_t rank = size / 2;
+            if (rank >= below && rank - below < inside)
+            {
+                std::nth_element(window.begin(), window.begin() + (rank - below), window.begin() + inside);
+                m_scale = window[rank - below] / 0.6745;
+            }
+            else
+            {
+                for (size_t i = 0; i < size; i++)
+                {
+                    sizes[i] = std::abs(vec[i].second - y0 - intercept - slope * (vec[i].first - x0));
+                }
+                m_scale = robust_scale(sizes);
+            }
+
+            pdd previous = thetas;
+            thetas = solve_sums(sums);
+            m_iterations_run++;
+
+            double change = std::max(std::abs(thetas.first - previous.first), std::abs(thetas.second - previous.second));
+            double magnitude = std::max(std::abs(thetas.first), std::abs(thetas.second));
+            if (change <= m_tolerance * (1 + magnitude))
+            {
+                break;
+            }
+        }
+    }
+
+    return std::make_pair(y0 + thetas.first - thetas.second * x0, thetas.second);
+}
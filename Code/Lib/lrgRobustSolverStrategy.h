@@ -0,0 +1,64 @@
+#ifndef lrgRobustSolverStrategy_h
+#define lrgRobustSolverStrategy_h
+#include "lrgLinearModelSolverStrategyI.h"
+#include <string>
+#include <vector>
+
+// The loss that decides how much a point with a large residual counts.
+enum class lrgRobustLoss
+{
+    Huber, // squared error near the line, absolute error far from it (weights c * s / |r| outside c * s)
+    Tukey  // Tukey's biweight, points further than c * s from the line are ignored completely
+};
+
+// Converts the command line keywords (huber, tukey) to an lrgRobustLoss.
+lrgRobustLoss lrgRobustLossFromString(const std::string &name);
+
+// Robust regression with iteratively reweighted least squares (IRLS).
+// Starting from the ordinary least squares fit, every iteration weighs the points by their residuals
+// and solves the weighted normal equation again, until the thetas stop changing. The residuals are
+// measured in units of a robust scale s (the median absolute residual / 0.6745), taken from the
+// residuals of the previous iteration. The tuning constant c defaults to 1.345 (Huber) or 4.685 (Tukey),
+// the usual 95% efficiency on clean normal data. Tukey's loss has several minima, so it starts from the Huber fit.
+//
+// Every iteration is a single pass over the points that computes the residual and the weight and adds the
+// point to the weighted sums in one go. With the Huber loss the points inside c * s keep a weight of exactly 1,
+// so by default only the points whose weight changed are added (with the change of their weight) to the sums
+// of the previous iteration: a low-rank update of the previous normal equation.
+class lrgRobustSolverStrategy : public lrgLinearModelSolverStrategyI
+{
+private:
+    lrgRobustLoss m_loss;
+    double m_tuning;
+    unsigned int m_iterations;
+    double m_tolerance;
+    bool m_low_rank;
+    unsigned int m_iterations_run;
+    unsigned long m_points_updated;
+    double m_scale;
+    std::vector<double> m_weights;
+
+public:
+    lrgRobustSolverStrategy(lrgRobustLoss loss, double &tuning);
+    lrgRobustSolverStrategy(lrgRobustLoss loss);
+    lrgRobustSolverStrategy();
+    ~lrgRobustSolverStrategy();
+    void SetIterations(unsigned int &iterations);
+    void SetTolerance(double &tolerance);
+
+    // Switches the low-rank updates of the Huber iterations off (every iteration re-adds every point).
+    void SetLowRankUpdates(bool low_rank);
+
+    unsigned int GetIterationsRun() const;
+
+    // The number of points added to the sums over all iterations (N per full pass).
+    unsigned long GetPointsUpdated() const;
+
+    // The final robust scale s and the final weight of every point (small weights flag the outliers).
+    double GetScale() const;
+    const std::vector<double> &GetWeights() const;
+
+    virtual pdd FitData(pdd_vector vec);
+};
+
+#endif
@@ -0,0 +1,219 @@
+#include "lrgSketchSolverStrategy.h"
+#include <Eigen/Dense>
+#include <stdexcept>
+#include <cmath>
+#include <vector>
+
+// SplitMix64 of (key, counter): a random 64-bit number for every point without any state.
+static inline unsigned long long counter_random(unsigned long long key, unsigned long long counter)
+{
+    unsigned long long z = key + 0x9e3779b97f4a7c15ULL * (counter + 1);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+lrgSketchSolverStrategy::lrgSketchSolverStrategy(unsigned int &sketch_rows) : lrgSketchSolverStrategy()
+{
+    SetSketchRows(sketch_rows);
+}
+
+lrgSketchSolverStrategy::lrgSketchSolverStrategy()
+{
+    m_sketch_rows = 4096;
+    m_refinement = 0;
+    m_tolerance = 1e-12;
+    m_seed = 5489;
+    m_iterations_run = 0;
+}
+
+lrgSketchSolverStrategy::~lrgSketchSolverStrategy()
+{
+}
+
+void lrgSketchSolverStrategy::SetSketchRows(unsigned int &sketch_rows)
+{
+    if (sketch_rows < 2)
+    {
+        throw std::invalid_argument("The sketch needs at least 2 rows...");
+    }
+    m_sketch_rows = sketch_rows;
+}
+
+void lrgSketchSolverStrategy::SetRefinement(unsigned int &iterations)
+{
+    m_refinement = iterations;
+}
+
+void lrgSketchSolverStrategy::SetTolerance(const double &tolerance)
+{
+    if (! (tolerance >= 0))
+    {
+        throw std::invalid_argument("The tolerance must not be negative...");
+    }
+    m_tolerance = tolerance;
+}
+
+void lrgSketchSolverStrategy::SetSeed(unsigned long seed)
+{
+    m_seed = seed;
+}
+
+unsigned int lrgSketchSolverStrategy::GetIterationsRun() const
+{
+    return m_iterations_run;
+}
+
+pdd lrgSketchSolverStrategy::FitData(pdd_vector vec)
+{
+    std::vector<double> x(vec.size()), y(vec.size());
+    for (size_t i = 0; i < vec.size(); i++)
+    {
+        x[i] = vec[i].first;
+        y[i] = vec[i].second;
+    }
+    return FitData(x.data(), y.data(), vec.size());
+}
+
+pdd lrgSketchSolverStrategy::FitData(const double *x, const double *y, size_t count)
+{
+    if (count == 0)
+    {
+        throw std::length_error("Vector is empty...");
+    }
+    size_t N = count;
+    unsigned long long m = m_sketch_rows;
+    m_iterations_run = 0;
+
+    // The sketch of [1, x, y], row by row. The upper 32 bits of the hash pick the row with a multiply and
+    // shift (no division), the lowest bit is the sign.
+    std::vector<double> sketch(3 * m, 0.0);
+    for (size_t i = 0; i < N; i++)
+    {
+        unsigned long long hash = counter_random(m_seed, i);
+        double *row = &sketch[3 * (((hash >> 32) * m) >> 32)];
+        double sign = (hash & 1) ? 1.0 : -1.0;
+        row[0] += sign;
+        row[1] += sign * x[i];
+        row[2] += sign * y[i];
+    }
+
+    Eigen::MatrixXd SX(m, 2);
+    Eigen::VectorXd Sy(m);
+    for (unsigned long long k = 0; k < m; k++)
+    {
+        SX(k, 0) = sketch[3 * k];
+        SX(k, 1) = sketch[3 * k + 1];
+        Sy(k) = sketch[3 * k + 2];
+    }
+    Eigen::HouseholderQR<Eigen::MatrixXd> qr(SX);
+    Eigen::Matrix2d R = qr.matrixQR().topLeftCorner(2, 2).triangularView<Eigen::Upper>();
+
+    // Every x-value the same (or a sketch that lost all but one direction): the line has no slope.
+    if (! (std::abs(R(1, 1)) > 1e-14 * (std::abs(R(0, 0)) + std::abs(R(0, 1)))))
+    {
+        throw std::logic_error("Invalid values for thetas...");
+    }
+    Eigen::Vector2d thetas = qr.solve(Sy);
+    if (m_refinement == 0)
+    {
+        return std::make_pair(thetas(0), thetas(1));
+    }
+
+    // LSQR on B = X R^-1 and the residual of the sketched line. u is kept unscaled (u_true = u * u_scale),
+    // so that every iteration needs a single pass: u = B v - alpha u, |u| and X^T u together.
+    auto solve_R = [&R](const Eigen::Vector2d &v) -> Eigen::Vector2d
+    {
+        return R.triangularView<Eigen::Upper>().solve(v);
+    };
+    auto solve_RT = [&R](const Eigen::Vector2d &v) -> Eigen::Vector2d
+    {
+        return R.transpose().triangularView<Eigen::Lower>().solve(v);
+    };
+
+    std::vector<double> u(N);
+    double beta = 0;
+    Eigen::Vector2d Xt_u(0, 0);
+    for (size_t i = 0; i < N; i++)
+    {
+        u[i] = y[i] - thetas(0) - thetas(1) * x[i];
+        beta += u[i] * u[i];
+        Xt_u(0) += u[i];
+        Xt_u(1) += x[i] * u[i];
+    }
+    beta = std::sqrt(beta);
+    if (beta == 0)
+    {
+        return std::make_pair(thetas(0), thetas(1));
+    }
+    double u_scale = 1 / beta;
+
+    Eigen::Vector2d v = solve_RT(Xt_u) * u_scale;
+    double alpha = v.norm();
+    if (alpha == 0)
+    {
+        return std::make_pair(thetas(0), thetas(1));
+    }
+    v /= alpha;
+
+    Eigen::Vector2d z(0, 0);
+    Eigen::Vector2d w = v;
+    double phibar = beta;
+    double rhobar = alpha;
+    double anorm = 0;
+
+    for (unsigned int iteration = 0; iteration < m_refinement; iteration++)
+    {
+        m_iterations_run++;
+
+        // u = B v - alpha u
+        Eigen::Vector2d direction = solve_R(v);
+        double decay = alpha * u_scale;
+        beta = 0;
+        Xt_u.setZero();
+        for (size_t i = 0; i < N; i++)
+        {
+            u[i] = direction(0) + direction(1) * x[i] - decay * u[i];
+            beta += u[i] * u[i];
+            Xt_u(0) += u[i];
+            Xt_u(1) += x[i] * u[i];
+        }
+        beta = std::sqrt(beta);
+        anorm = std::sqrt(anorm * anorm + alpha * alpha + beta * beta);
+        if (beta == 0)
+        {
+            z += (phibar / rhobar) * w;
+            break;
+        }
+        u_scale = 1 / beta;
+
+        // v = B^T u - beta v
+        v = solve_RT(Xt_u) * u_scale - beta * v;
+        alpha = v.norm();
+        if (alpha > 0)
+        {
+            v /= alpha;
+        }
+
+        // The plane rotation that keeps the bidiagonal system triangular.
+        double rho = std::sqrt(rhobar * rhobar + beta * beta);
+        double c = rhobar / rho;
+        double s = beta / rho;
+        double theta = s * alpha;
+        rhobar = -c * alpha;
+        double phi = c * phibar;
+        phibar = s * phibar;
+
+        z += (phi / rho) * w;
+        w = v - (theta / rho) * w;
+
+        // |B^T r| = phibar * alpha * |c|, and phibar is |r|.
+        if (alpha == 0 || phibar * alpha * std::abs(c) <= m_tolerance * anorm * phibar)
+        {
+            break;
+        }
+    }
+
+    thetas += solve_R(z);
+    return std::make_pair(thetas(0), thetas(1));
+}
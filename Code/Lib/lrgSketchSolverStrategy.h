@@ -0,0 +1,54 @@
+#ifndef lrgSketchSolverStrategy_h
+#define lrgSketchSolverStrategy_h
+#include "lrgLinearModelSolverStrategyI.h"
+#include <cstddef>
+
+// Sketch-and-solve least squares for very tall data, when an approximate line is good enough.
+//
+// A CountSketch S compresses the N rows of X = [1, x] and y into m rows: every point is added, with a random
+// sign, to one random row of SX and Sy. That is a single pass with one hash per point and no
+// multiplication, and the small m x 2 problem min |SX thetas - Sy| is then solved by QR. Its thetas are
+// off the exact least squares thetas by about 1 / sqrt(m) of the spread of the residuals, whatever N is.
+//
+// The sketch also makes a preconditioner: R from SX = QR makes X R^-1 almost orthonormal. With refinement
+// iterations LSQR (Paige & Saunders) solves min |X R^-1 z - r| for the residual r of the sketched line,
+// and on such a well conditioned matrix every iteration (one pass over the points) gains several digits, so
+// a few of them reach the exact solution even when x lies far from zero.
+//
+// The bucket and the sign of point i come from a counter-based hash of (seed, i), so the same seed always
+// gives the same sketch.
+class lrgSketchSolverStrategy : public lrgLinearModelSolverStrategyI
+{
+private:
+    unsigned int m_sketch_rows;
+    unsigned int m_refinement;
+    double m_tolerance;
+    unsigned long m_seed;
+    unsigned int m_iterations_run;
+
+public:
+    lrgSketchSolverStrategy(unsigned int &sketch_rows);
+    lrgSketchSolverStrategy();
+    ~lrgSketchSolverStrategy();
+
+    // The rows m of the sketch, at least 2. Default: 4096.
+    void SetSketchRows(unsigned int &sketch_rows);
+
+    // The most LSQR iterations after the sketch. Default: 0, the sketched solution as it is.
+    void SetRefinement(unsigned int &iterations);
+
+    // LSQR stops when |X^T r| <= tolerance * |X R^-1| * |r|. Default: 1e-12.
+    void SetTolerance(const double &tolerance);
+
+    void SetSeed(unsigned long seed);
+
+    // The LSQR iterations of the last fit.
+    unsigned int GetIterationsRun() const;
+
+    virtual pdd FitData(pdd_vector vec);
+
+    // The same on separate arrays of x and y, without copying them.
+    pdd FitData(const double *x, const double *y, size_t count);
+};
+
+#endif
@@ -0,0 +1,142 @@
+#include "lrgSlidingWindowRegression.h"
+#include <stdexcept>
+
+// window is the number of points W in every fit.
+lrgSlidingWindowRegression::lrgSlidingWindowRegression(unsigned int &window)
+{
+    m_window = 0;
+    m_custom_reanchor = false;
+    SetWindow(window);
+}
+
+// Empty constructor. A window of 100 points.
+lrgSlidingWindowRegression::lrgSlidingWindowRegression()
+{
+    unsigned int window = 100;
+    m_window = 0;
+    m_custom_reanchor = false;
+    SetWindow(window);
+}
+
+// Destructor
+lrgSlidingWindowRegression::~lrgSlidingWindowRegression() {}
+
+// Changing the window starts a new series. Unless an interval was set, re-anchoring follows the new window.
+void lrgSlidingWindowRegression::SetWindow(unsigned int &window)
+{
+    if (window < 2)
+    {
+        throw std::invalid_argument("The window needs at least 2 points...");
+    }
+    m_window = window;
+    if (! m_custom_reanchor)
+    {
+        m_reanchor_interval = window;
+    }
+    Reset();
+}
+
+void lrgSlidingWindowRegression::SetReanchorInterval(unsigned int &interval)
+{
+    m_reanchor_interval = interval;
+    m_custom_reanchor = true;
+}
+
+void lrgSlidingWindowRegression::Reset()
+{
+    m_points.clear();
+    m_points.reserve(m_window);
+    m_oldest = 0;
+    m_since_reanchor = 0;
+    m_stats = lrgSufficientStatistics();
+}
+
+// Statistics of the points in the window from scratch, oldest first.
+void lrgSlidingWindowRegression::Reanchor()
+{
+    m_stats = lrgSufficientStatistics();
+    for (size_t i = 0; i < m_points.size(); i++)
+    {
+        const lrgWeightedSample &point = m_points[(m_oldest + i) % m_points.size()];
+        m_stats.Add(point.x, point.y, point.weight);
+    }
+    m_since_reanchor = 0;
+}
+
+void lrgSlidingWindowRegression::Add(double x, double y)
+{
+    Add(x, y, 1);
+}
+
+void lrgSlidingWindowRegression::Add(double x, double y, double weight)
+{
+    lrgWeightedSample sample = {x, y, weight};
+    if (m_points.size() < m_window)
+    {
+        m_stats.Add(x, y, weight);
+        m_points.push_back(sample);
+        return;
+    }
+
+    // The window is full: the newest point takes the place of the oldest one.
+    lrgWeightedSample &oldest = m_points[m_oldest];
+    m_stats.Remove(oldest.x, oldest.y, oldest.weight);
+    m_stats.Add(x, y, weight);
+    oldest = sample;
+    m_oldest = (m_oldest + 1) % m_window;
+
+    m_since_reanchor++;
+    if (m_reanchor_interval != 0 && m_since_reanchor >= m_reanchor_interval)
+    {
+        Reanchor();
+    }
+}
+
+unsigned int lrgSlidingWindowRegression::GetSize() const
+{
+    return m_points.size();
+}
+
+bool lrgSlidingWindowRegression::IsFull() const
+{
+    return m_points.size() == m_window;
+}
+
+// t1 = Sxy / Sxx and the line goes through the means.
+pdd lrgSlidingWindowRegression::GetThetas() const
+{
+    if (m_points.size() == 0)
+    {
+        throw std::logic_error("The window is empty...");
+    }
+    if (m_stats.GetSxx() == 0)
+    {
+        throw std::logic_error("All x-values in the window are equal, the slope is undefined...");
+    }
+
+    double t1 = m_stats.GetSxy() / m_stats.GetSxx();
+    double t0 = m_stats.GetMeanY() - t1 * m_stats.GetMeanX();
+    return std::make_pair(t0, t1);
+}
+
+// Starts a new series, so the first fit is the one of the first W points.
+pdd_vector lrgSlidingWindowRegression::FitWindows(const pdd_vector &vec)
+{
+    if (vec.size() < m_window)
+    {
+        throw std::length_error("The vector is shorter than the window...");
+    }
+
+    Reset();
+    pdd_vector thetas;
+    thetas.reserve(vec.size() - m_window + 1);
+    for (const auto &item : vec)
+    {
+        Add(item.first, item.second);
+        if (IsFull())
+        {
+            thetas.push_back(GetThetas());
+        }
+    }
+    return thetas;
+}
@@ -0,0 +1,55 @@
+#ifndef lrgSlidingWindowRegression_h
+#define lrgSlidingWindowRegression_h
+#include "lrgLinearModelSolverStrategyI.h"
+#include "lrgSufficientStatistics.h"
+#include <cstddef>
+
+// Fits a line to the last W points of a series. Add() puts the newest point in and takes the oldest
+// one out of the statistics in O(1), so sliding the window by one point costs the same for any W.
+// Every removal leaves a little rounding error behind. To stop it from piling up over a long series,
+// the statistics are rebuilt from the points in the window every so often (re-anchoring). By default
+// that happens once every W additions, which keeps the cost per point O(1) on average.
+class lrgSlidingWindowRegression
+{
+private:
+    unsigned int m_window;
+    unsigned int m_reanchor_interval;
+    bool m_custom_reanchor; // set by SetReanchorInterval(), otherwise the interval is the window
+    unsigned int m_since_reanchor;
+    weighted_vector m_points; // ring buffer with the points of the window
+    size_t m_oldest;     // position of the oldest point in m_points
+    lrgSufficientStatistics m_stats;
+
+    void Reanchor();
+
+public:
+    lrgSlidingWindowRegression(unsigned int &window);
+    lrgSlidingWindowRegression();
+    ~lrgSlidingWindowRegression();
+    void SetWindow(unsigned int &window);
+
+    // Rebuild the statistics every interval additions. 0 switches re-anchoring off.
+    // Default: the current window. An interval set here is kept when the window changes.
+    void SetReanchorInterval(unsigned int &interval);
+
+    // Add the newest point. Once the window is full, the oldest point leaves.
+    void Add(double x, double y);
+
+    // Same with a weight. The window still holds W points, whatever their weights.
+    void Add(double x, double y, double weight);
+
+    // Forget all the points.
+    void Reset();
+
+    // The number of points in the window (at most W).
+    unsigned int GetSize() const;
+    bool IsFull() const;
+
+    // The thetas of the points in the window. Needs at least two different x-values.
+    pdd GetThetas() const;
+
+    // The thetas of all the N - W + 1 windows of vec, in one pass over the data.
+    pdd_vector FitWindows(const pdd_vector &vec);
+};
+
+#endif
@@ -0,0 +1,121 @@
+#include "lrgSparseFileLoader.h"
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+
+// filepath is the path of the file that contains the data.
+lrgSparseFileLoader::lrgSparseFileLoader(std::string &filepath) : m_filepath(filepath)
+{
+}
+
+// Destructor
+lrgSparseFileLoader::~lrgSparseFileLoader()
+{
+}
+
+// A method that reads the file line by line and builds the sparse matrix from (row, column, value) triplets.
+// Only the non-zeros are stored, so a file with millions of features takes as much memory as it has entries.
+lrgSparseDataset lrgSparseFileLoader::GetData()
+{
+    std::ifstream m_file;
+    m_file.open(m_filepath, std::ios::in);
+
+    // We manually throw an exception if the file doesn't exist.
+    if (! m_file)
+    {
+        throw std::ios_base::failure("Reading file failed...");
+    }
+
+    std::vector<Eigen::Triplet<double>> triplets;
+    std::vector<double> labels;
+    long columns = 1;
+
+    std::string line;
+    std::string entry;
+    std::vector<long> indices;
+    while (std::getline(m_file, line))
+    {
+        // Blank lines (and the empty line after a trailing newline) are skipped.
+        if (line.find_first_not_of(" \t\r") == std::string::npos)
+        {
+            continue;
+        }
+
+        std::istringstream line_stream(line);
+        double label;
+        if (! (line_stream >> label))
+        {
+            throw std::ios_base::failure("Invalid line in the input file: " + line);
+        }
+
+        long row = labels.size();
+        labels.push_back(label);
+
+        // The intercept.
+        triplets.push_back(Eigen::Triplet<double>(row, 0, 1.0));
+
+        indices.clear();
+        while (line_stream >> entry)
+        {
+            std::size_t colon = entry.find(':');
+            if (colon == std::string::npos)
+            {
+                throw std::ios_base::failure("Invalid entry in the input file: " + entry);
+            }
+
+            // Both sides of the colon have to be numbers as a whole, so "1.5:3" is not read as index 1.
+            std::string index_text = entry.substr(0, colon);
+            std::string value_text = entry.substr(colon + 1);
+            long index;
+            double value;
+            std::size_t index_end = 0;
+            std::size_t value_end = 0;
+            try
+            {
+                index = std::stol(index_text, &index_end);
+                value = std::stod(value_text, &value_end);
+            }
+            catch (std::exception &e)
+            {
+                throw std::ios_base::failure("Invalid entry in the input file: " + entry);
+            }
+            if (index_end != index_text.size() || value_end != value_text.size())
+            {
+                throw std::ios_base::failure("Invalid entry in the input file: " + entry);
+            }
+
+            if (index < 1)
+            {
+                throw std::ios_base::failure("Feature indices must start from 1: " + entry);
+            }
+
+            triplets.push_back(Eigen::Triplet<double>(row, index, value));
+            columns = std::max(columns, index + 1);
+            indices.push_back(index);
+        }
+
+        // setFromTriplets() would silently add up a feature given twice on the same line.
+        std::sort(indices.begin(), indices.end());
+        if (std::adjacent_find(indices.begin(), indices.end()) != indices.end())
+        {
+            throw std::ios_base::failure("Feature index given twice in the input file: " + line);
+        }
+    }
+
+    m_file.close();
+
+    // If the reading failed then there are no samples.
+    if (labels.empty())
+    {
+        throw std::length_error("File is empty. Something went wrong when reading the input file...");
+    }
+
+    lrgSparseDataset data;
+    data.X.resize(labels.size(), columns);
+    data.X.setFromTriplets(triplets.begin(), triplets.end());
+    data.y = Eigen::Map<Eigen::VectorXd>(labels.data(), labels.size());
+
+    return data;
+}
@@ -0,0 +1,20 @@
+#ifndef lrgSparseFileLoader_h
+#define lrgSparseFileLoader_h
+#include "lrgSparseLinearModelSolverStrategyI.h"
+#include <string>
+
+// Reads files in the sparse text format of libsvm. Every line is one sample:
+// label index:value index:value ...
+// Indices start from 1 and only the non-zero features are listed. Column 0 of X is filled with ones.
+class lrgSparseFileLoader
+{
+private:
+    std::string m_filepath;
+
+public:
+    lrgSparseFileLoader(std::string &filepath);
+    ~lrgSparseFileLoader();
+    lrgSparseDataset GetData();
+};
+
+#endif
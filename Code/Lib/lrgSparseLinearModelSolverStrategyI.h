@@ -0,0 +1,24 @@
+#ifndef lrgSparseLinearModelSolverStrategyI_h
+#define lrgSparseLinearModelSolverStrategyI_h
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+
+// Compressed sparse row matrix, i.e. the non-zeros of every sample are stored next to each other.
+typedef Eigen::SparseMatrix<double, Eigen::RowMajor> lrgSparseMatrix;
+
+// A data set with many (mostly zero) features.
+// Each row of X is one sample and column 0 is the column of ones for the intercept.
+struct lrgSparseDataset
+{
+    lrgSparseMatrix X;
+    Eigen::VectorXd y;
+};
+
+class lrgSparseLinearModelSolverStrategyI
+{
+public:
+    virtual ~lrgSparseLinearModelSolverStrategyI() {}
+    virtual Eigen::VectorXd FitData(const lrgSparseDataset &data) = 0;
+};
+
+#endif
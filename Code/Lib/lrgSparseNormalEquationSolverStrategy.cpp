@@ -0,0 +1,39 @@
+#include "lrgSparseNormalEquationSolverStrategy.h"
+#include <Eigen/SparseCholesky>
+#include <stdexcept>
+
+// Constructor
+lrgSparseNormalEquationSolverStrategy::lrgSparseNormalEquationSolverStrategy() {}
+
+// Destructor
+lrgSparseNormalEquationSolverStrategy::~lrgSparseNormalEquationSolverStrategy() {}
+
+// Two features only meet in X^T X if they are non-zero in the same sample,
+// so for one-hot or bag-of-words data X^T X stays sparse as well.
+Eigen::VectorXd lrgSparseNormalEquationSolverStrategy::FitData(const lrgSparseDataset &data)
+{
+    if (data.X.rows() != data.y.size() || data.X.rows() == 0)
+    {
+        throw std::invalid_argument("X and y must have the same, non-zero number of rows...");
+    }
+
+    Eigen::SparseMatrix<double> gram = data.X.transpose() * data.X;
+    Eigen::VectorXd rhs = data.X.transpose() * data.y;
+
+    // The fill-reducing ordering (AMD by default) keeps the factor sparse.
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> ldlt(gram);
+
+    // A feature that never appears (or a linear dependency between features) makes X^T X singular.
+    if (ldlt.info() != Eigen::Success || !(ldlt.vectorD().array().abs() > 1e-12 * ldlt.vectorD().cwiseAbs().maxCoeff()).all())
+    {
+        throw std::logic_error("X^T X is singular...");
+    }
+
+    Eigen::VectorXd thetas = ldlt.solve(rhs);
+    if (!thetas.allFinite())
+    {
+        throw std::logic_error("Invalid values for thetas...");
+    }
+
+    return thetas;
+}
@@ -0,0 +1,15 @@
+#ifndef lrgSparseNormalEquationSolverStrategy_h
+#define lrgSparseNormalEquationSolverStrategy_h
+#include "lrgSparseLinearModelSolverStrategyI.h"
+
+// The normal equation for sparse data. X^T X is accumulated as a sparse matrix
+// and factorised with a sparse Cholesky (LDL^T) decomposition.
+class lrgSparseNormalEquationSolverStrategy : public lrgSparseLinearModelSolverStrategyI
+{
+public:
+    lrgSparseNormalEquationSolverStrategy();
+    ~lrgSparseNormalEquationSolverStrategy();
+    virtual Eigen::VectorXd FitData(const lrgSparseDataset &data);
+};
+
+#endif
@@ -0,0 +1,78 @@
+#include "lrgSparseStochasticGradientSolverStrategy.h"
+#include <random>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+
+// eta is the step size of every update.
+// epochs is the number of passes over the whole data set.
+lrgSparseStochasticGradientSolverStrategy::lrgSparseStochasticGradientSolverStrategy(double &eta, unsigned int &epochs)
+{
+    m_eta = eta;
+    m_epochs = epochs;
+}
+
+// Empty constructor
+lrgSparseStochasticGradientSolverStrategy::lrgSparseStochasticGradientSolverStrategy()
+{
+    m_eta = 0;
+    m_epochs = 0;
+}
+
+// Destructor
+lrgSparseStochasticGradientSolverStrategy::~lrgSparseStochasticGradientSolverStrategy() {}
+
+// Setters
+void lrgSparseStochasticGradientSolverStrategy::SetEta(double &eta)
+{
+    m_eta = eta;
+}
+
+void lrgSparseStochasticGradientSolverStrategy::SetEpochs(unsigned int &epochs)
+{
+    m_epochs = epochs;
+}
+
+// For one sample the gradient of the squared error is 2 * (x^T thetas - y) * x.
+// We walk through the samples in a new random order in every epoch and
+// only touch the thetas of the sample's non-zero features.
+Eigen::VectorXd lrgSparseStochasticGradientSolverStrategy::FitData(const lrgSparseDataset &data)
+{
+    // Same check as in lrgGradientDescentSolverStrategy.
+    if (m_eta == 0 || m_epochs == 0)
+    {
+        throw std::invalid_argument("Invalid arguments for eta and/or epochs...");
+    }
+    if (data.X.rows() != data.y.size() || data.X.rows() == 0)
+    {
+        throw std::invalid_argument("X and y must have the same, non-zero number of rows...");
+    }
+
+    Eigen::VectorXd thetas = Eigen::VectorXd::Zero(data.X.cols());
+
+    std::vector<long> order(data.X.rows());
+    std::iota(order.begin(), order.end(), 0);
+    std::mt19937_64 mt64;
+
+    for (size_t epoch = 0; epoch < m_epochs; epoch++)
+    {
+        std::shuffle(order.begin(), order.end(), mt64);
+
+        for (long row : order)
+        {
+            double prediction = 0;
+            for (lrgSparseMatrix::InnerIterator it(data.X, row); it; ++it)
+            {
+                prediction += it.value() * thetas(it.col());
+            }
+
+            double step = 2.0 * m_eta * (prediction - data.y(row));
+            for (lrgSparseMatrix::InnerIterator it(data.X, row); it; ++it)
+            {
+                thetas(it.col()) -= step * it.value();
+            }
+        }
+    }
+
+    return thetas;
+}
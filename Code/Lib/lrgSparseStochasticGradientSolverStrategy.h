@@ -0,0 +1,23 @@
+#ifndef lrgSparseStochasticGradientSolverStrategy_h
+#define lrgSparseStochasticGradientSolverStrategy_h
+#include "lrgSparseLinearModelSolverStrategyI.h"
+
+// Stochastic gradient descent for sparse data.
+// The gradient of one sample is only non-zero where the sample has non-zero features,
+// so every update costs O(non-zeros of the sample) instead of O(number of features).
+class lrgSparseStochasticGradientSolverStrategy : public lrgSparseLinearModelSolverStrategyI
+{
+private:
+    double m_eta;
+    unsigned int m_epochs;
+
+public:
+    lrgSparseStochasticGradientSolverStrategy(double &eta, unsigned int &epochs);
+    lrgSparseStochasticGradientSolverStrategy();
+    ~lrgSparseStochasticGradientSolverStrategy();
+    void SetEta(double &eta);
+    void SetEpochs(unsigned int &epochs);
+    virtual Eigen::VectorXd FitData(const lrgSparseDataset &data);
+};
+
+#endif
@@ -0,0 +1,251 @@
+#include "lrgSufficientStatistics.h"
+#include <algorithm>
+#include <stdexcept>
+
+// Constructor. Empty statistics.
+lrgSufficientStatistics::lrgSufficientStatistics()
+{
+    m_weight = 0;
+    m_mean_x = 0;
+    m_mean_y = 0;
+    m_sxx = 0;
+    m_sxy = 0;
+    m_syy = 0;
+}
+
+// Constructor that gathers the statistics of a whole vector in one pass.
+lrgSufficientStatistics::lrgSufficientStatistics(const pdd_vector &vec) : lrgSufficientStatistics()
+{
+    for (const auto &item : vec)
+    {
+        Add(item.first, item.second);
+    }
+}
+
+// Same for weighted samples. The weights go into the same single pass.
+lrgSufficientStatistics::lrgSufficientStatistics(const weighted_vector &vec) : lrgSufficientStatistics()
+{
+    for (const auto &item : vec)
+    {
+        Add(item.x, item.y, item.weight);
+    }
+}
+
+// Destructor
+lrgSufficientStatistics::~lrgSufficientStatistics() {}
+
+// Welford's update. The means move towards the new point and the co-moments
+// grow by the product of the distances before and after the move.
+void lrgSufficientStatistics::Add(double x, double y)
+{
+    m_weight += 1;
+
+    double dx = x - m_mean_x;
+    double dy = y - m_mean_y;
+
+    m_mean_x += dx / m_weight;
+    m_mean_y += dy / m_weight;
+
+    m_sxx += dx * (x - m_mean_x);
+    m_sxy += dx * (y - m_mean_y);
+    m_syy += dy * (y - m_mean_y);
+}
+
+// The weighted version of Welford's update (West, 1979): the means move by weight / total weight
+// of the distance, and the co-moments grow by weight times the product of the distances.
+void lrgSufficientStatistics::Add(double x, double y, double weight)
+{
+    if (!(weight >= 0))
+    {
+        throw std::invalid_argument("Weights cannot be negative...");
+    }
+    if (weight == 0)
+    {
+        return;
+    }
+
+    m_weight += weight;
+
+    double dx = x - m_mean_x;
+    double dy = y - m_mean_y;
+    double share = weight / m_weight;
+
+    m_mean_x += share * dx;
+    m_mean_y += share * dy;
+
+    m_sxx += weight * dx * (x - m_mean_x);
+    m_sxy += weight * dx * (y - m_mean_y);
+    m_syy += weight * dy * (y - m_mean_y);
+}
+
+// Welford's update run backwards. With the means before (a) and after (b) the removal,
+// mean_a = mean_b - (x - mean_b) / W_a and the co-moments shrink by (x - mean_a) * (x - mean_b).
+// Removing the last point gives empty statistics, and Sxx/Syy are never allowed to become negative.
+void lrgSufficientStatistics::Remove(double x, double y)
+{
+    if (m_weight <= 1)
+    {
+        *this = lrgSufficientStatistics();
+        return;
+    }
+
+    double dx = x - m_mean_x;
+    double dy = y - m_mean_y;
+
+    m_weight -= 1;
+    m_mean_x -= dx / m_weight;
+    m_mean_y -= dy / m_weight;
+
+    m_sxx = std::max(m_sxx - dx * (x - m_mean_x), 0.0);
+    m_sxy -= dx * (y - m_mean_y);
+    m_syy = std::max(m_syy - dy * (y - m_mean_y), 0.0);
+}
+
+// Same for a weighted pair: mean_a = mean_b - weight * (x - mean_b) / W_a.
+void lrgSufficientStatistics::Remove(double x, double y, double weight)
+{
+    if (!(weight >= 0))
+    {
+        throw std::invalid_argument("Weights cannot be negative...");
+    }
+    if (weight == 0)
+    {
+        return;
+    }
+    // Nothing (or only rounding errors) left.
+    if (m_weight - weight <= 1e-12 * m_weight)
+    {
+        *this = lrgSufficientStatistics();
+        return;
+    }
+
+    double dx = x - m_mean_x;
+    double dy = y - m_mean_y;
+
+    m_weight -= weight;
+    double share = weight / m_weight;
+    m_mean_x -= share * dx;
+    m_mean_y -= share * dy;
+
+    m_sxx = std::max(m_sxx - weight * dx * (x - m_mean_x), 0.0);
+    m_sxy -= weight * dx * (y - m_mean_y);
+    m_syy = std::max(m_syy - weight * dy * (y - m_mean_y), 0.0);
+}
+
+// Chan et al.: the co-moments of the union are the co-moments of the parts plus
+// a term for the distance between the two means.
+void lrgSufficientStatistics::Merge(const lrgSufficientStatistics &other)
+{
+    if (other.m_weight == 0)
+    {
+        return;
+    }
+    if (m_weight == 0)
+    {
+        *this = other;
+        return;
+    }
+
+    double weight = m_weight + other.m_weight;
+    double dx = other.m_mean_x - m_mean_x;
+    double dy = other.m_mean_y - m_mean_y;
+    double factor = m_weight * other.m_weight / weight;
+
+    m_mean_x += dx * other.m_weight / weight;
+    m_mean_y += dy * other.m_weight / weight;
+    m_sxx += other.m_sxx + dx * dx * factor;
+    m_sxy += other.m_sxy + dx * dy * factor;
+    m_syy += other.m_syy + dy * dy * factor;
+    m_weight = weight;
+}
+
+// Chan's merge run backwards.
+void lrgSufficientStatistics::Subtract(const lrgSufficientStatistics &other)
+{
+    if (other.m_weight == 0)
+    {
+        return;
+    }
+    // Nothing (or only rounding errors) left.
+    if (m_weight - other.m_weight <= 1e-12 * m_weight)
+    {
+        *this = lrgSufficientStatistics();
+        return;
+    }
+
+    // The rest merged with other gives this.
+    double weight = m_weight - other.m_weight;
+    double mean_x = m_mean_x + (m_mean_x - other.m_mean_x) * other.m_weight / weight;
+    double mean_y = m_mean_y + (m_mean_y - other.m_mean_y) * other.m_weight / weight;
+    double dx = other.m_mean_x - mean_x;
+    double dy = other.m_mean_y - mean_y;
+    double factor = weight * other.m_weight / m_weight;
+
+    m_sxx = std::max(m_sxx - other.m_sxx - dx * dx * factor, 0.0);
+    m_sxy -= other.m_sxy + dx * dy * factor;
+    m_syy = std::max(m_syy - other.m_syy - dy * dy * factor, 0.0);
+    m_mean_x = mean_x;
+    m_mean_y = mean_y;
+    m_weight = weight;
+}
+
+// Down-weighting all the points by the same factor does not move the means.
+void lrgSufficientStatistics::Forget(double factor)
+{
+    m_weight *= factor;
+    m_sxx *= factor;
+    m_sxy *= factor;
+    m_syy *= factor;
+}
+
+// Getters
+double lrgSufficientStatistics::GetWeight() const
+{
+    return m_weight;
+}
+
+double lrgSufficientStatistics::GetMeanX() const
+{
+    return m_mean_x;
+}
+
+double lrgSufficientStatistics::GetMeanY() const
+{
+    return m_mean_y;
+}
+
+double lrgSufficientStatistics::GetSxx() const
+{
+    return m_sxx;
+}
+
+double lrgSufficientStatistics::GetSxy() const
+{
+    return m_sxy;
+}
+
+double lrgSufficientStatistics::GetSyy() const
+{
+    return m_syy;
+}
+
+// X^T X / N = | 1       mean_x              |     X^T y / N = | mean_y                   |
+//             | mean_x  Sxx/N + mean_x^2    |                 | Sxy/N + mean_x * mean_y  |
+void lrgSufficientStatistics::GetScaledNormalEquation(double gram[2][2], double rhs[2]) const
+{
+    gram[0][0] = 1;
+    gram[0][1] = m_mean_x;
+    gram[1][0] = m_mean_x;
+    gram[1][1] = m_sxx / m_weight + m_mean_x * m_mean_x;
+
+    rhs[0] = m_mean_y;
+    rhs[1] = m_sxy / m_weight + m_mean_x * m_mean_y;
+}
+
+// sum w (y - t0 - t1 x)^2 = W (mean_y - t0 - t1 mean_x)^2 + Syy - 2 t1 Sxy + t1^2 Sxx
+double lrgSufficientStatistics::GetSquaredError(const pdd &thetas) const
+{
+    double offset = m_mean_y - thetas.first - thetas.second * m_mean_x;
+    double error = m_weight * offset * offset + m_syy - 2 * thetas.second * m_sxy + thetas.second * thetas.second * m_sxx;
+    return std::max(error, 0.0);
+}
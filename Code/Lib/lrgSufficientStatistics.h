@@ -0,0 +1,64 @@
+#ifndef lrgSufficientStatistics_h
+#define lrgSufficientStatistics_h
+#include "lrgLinearModelSolverStrategyI.h"
+#include "lrgWeightedLinearModelSolverStrategyI.h"
+
+// Everything a straight-line fit needs to know about the data, gathered in a single pass.
+// Instead of raw sums (sum of x, sum of x^2, ...) we keep the means and the centred co-moments,
+// because raw sums lose all their precision when the data sit far away from zero.
+class lrgSufficientStatistics
+{
+public:
+    lrgSufficientStatistics();
+    explicit lrgSufficientStatistics(const pdd_vector &vec);
+    explicit lrgSufficientStatistics(const weighted_vector &vec);
+    ~lrgSufficientStatistics();
+
+    // Add one (x, y) pair to the statistics.
+    void Add(double x, double y);
+
+    // Add one (x, y) pair with a (non-negative) weight.
+    void Add(double x, double y, double weight);
+
+    // Take back a pair that was added before (downdating). Exact in exact arithmetic,
+    // but every removal adds a little rounding error, see lrgSlidingWindowRegression.
+    void Remove(double x, double y);
+    void Remove(double x, double y, double weight);
+
+    // Add all the pairs of other, as if they had been added one by one.
+    // Statistics gathered in parallel on parts of the data can be merged at the end.
+    void Merge(const lrgSufficientStatistics &other);
+
+    // Take back all the pairs of other, which must have been added (or merged) before: the inverse of Merge.
+    // The statistics of all the data minus those of a part are the statistics of the rest.
+    void Subtract(const lrgSufficientStatistics &other);
+
+    // Multiply the weight of every point seen so far by factor (exponential forgetting).
+    // The means stay where they are, the weight and the co-moments shrink.
+    void Forget(double factor);
+
+    // Getters
+    double GetWeight() const;
+    double GetMeanX() const;
+    double GetMeanY() const;
+    double GetSxx() const;
+    double GetSxy() const;
+    double GetSyy() const;
+
+    // The normal equation X^T X thetas = X^T y, divided by the total weight.
+    // X has a column of ones and a column of x-values, so both sides are always 2x2 and 2x1.
+    void GetScaledNormalEquation(double gram[2][2], double rhs[2]) const;
+
+    // The (weighted) sum of the squared residuals y - t0 - t1 * x of the pairs, from the moments alone.
+    double GetSquaredError(const pdd &thetas) const;
+
+private:
+    double m_weight;
+    double m_mean_x;
+    double m_mean_y;
+    double m_sxx;
+    double m_sxy;
+    double m_syy;
+};
+
+#endif
@@ -0,0 +1,417 @@
+#include "lrgTheilSenSolverStrategy.h"
+#include "lrgParallel.h"
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+// A point on the slope axis: just below t (after = false) or just above t (after = true),
+// so that the slopes equal to t fall on one side or the other. t can be -inf or +inf.
+struct lrgSlopeBound
+{
+    double t;
+    bool after;
+};
+
+// The points in the order of u = y - t * x at a bound. Equal u (a pair with slope t) is ordered by x
+// ascending below t and descending above it, so the pair is only inverted once the bound has passed t.
+// Points with the same x never swap, whatever the bound, so their pairs are never counted.
+static void sort_at_bound(const std::vector<double> &x, const std::vector<double> &y, const lrgSlopeBound &bound,
+                          std::vector<double> &u, std::vector<size_t> &order)
+{
+    size_t N = x.size();
+    for (size_t i = 0; i < N; i++)
+    {
+        order[i] = i;
+    }
+    if (std::isinf(bound.t))
+    {
+        // At -inf the order is x ascending and at +inf it is x descending, then y ascending.
+        bool descending = bound.t > 0;
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b)
+        {
+            if (x[a] != x[b])
+            {
+                return descending ? x[a] > x[b] : x[a] < x[b];
+            }
+            if (y[a] != y[b])
+            {
+                return y[a] < y[b];
+            }
+            return a < b;
+        });
+    }
+    else
+    {
+        for (size_t i = 0; i < N; i++)
+        {
+            u[i] = y[i] - bound.t * x[i];
+        }
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b)
+        {
+            if (u[a] != u[b])
+            {
+                return u[a] < u[b];
+            }
+            if (x[a] != x[b])
+            {
+                return bound.after ? x[a] > x[b] : x[a] < x[b];
+            }
+            return a < b;
+        });
+    }
+}
+
+// Merge sorts the sequence into the order of the upper bound (given as the rank of every point in that order)
+// and calls visit(b, left, count) whenever b overtakes the count points left[0 ... count - 1]. These are the
+// inversions: every pair of slope between the bound of the starting order and the upper bound, exactly once.
+// Returns the number of inversions.
+template <typename Visit>
+static unsigned long long merge_inversions(std::vector<size_t> &sequence, const std::vector<size_t> &rank,
+                                           std::vector<size_t> &buffer, Visit visit)
+{
+    size_t N = sequence.size();
+    unsigned long long total = 0;
+    for (size_t width = 1; width < N; width *= 2)
+    {
+        for (size_t begin = 0; begin < N; begin += 2 * width)
+        {
+            size_t middle = std::min(begin + width, N);
+            size_t end = std::min(begin + 2 * width, N);
+            size_t i = begin, j = middle, k = begin;
+            while (i < middle && j < end)
+            {
+                if (rank[sequence[j]] < rank[sequence[i]])
+                {
+                    visit(sequence[j], &sequence[i], middle - i, total);
+                    total += middle - i;
+                    buffer[k++] = sequence[j++];
+                }
+                else
+                {
+                    buffer[k++] = sequence[i++];
+                }
+            }
+            while (i < middle)
+            {
+                buffer[k++] = sequence[i++];
+            }
+            while (j < end)
+            {
+                buffer[k++] = sequence[j++];
+            }
+        }
+        sequence.swap(buffer);
+    }
+    return total;
+}
+
+// The slopes between two bounds: counted, sampled or listed with one pass of merge_inversions.
+class lrgSlopeCounter
+{
+private:
+    const std::vector<double> &m_x;
+    const std::vector<double> &m_y;
+    std::vector<double> m_u;
+    std::vector<size_t> m_lower_order;
+    std::vector<size_t> m_upper_order;
+    std::vector<size_t> m_rank;
+    std::vector<size_t> m_buffer;
+    std::vector<size_t> m_x_order;
+
+    // Leaves the points in the lower order in m_lower_order and the ranks in the upper order in m_rank.
+    void prepare(const lrgSlopeBound &lower, const lrgSlopeBound &upper, bool from_x_order)
+    {
+        size_t N = m_x.size();
+        if (from_x_order)
+        {
+            m_lower_order = m_x_order;
+        }
+        else
+        {
+            sort_at_bound(m_x, m_y, lower, m_u, m_lower_order);
+        }
+        sort_at_bound(m_x, m_y, upper, m_u, m_upper_order);
+        for (size_t i = 0; i < N; i++)
+        {
+            m_rank[m_upper_order[i]] = i;
+        }
+    }
+
+public:
+    lrgSlopeCounter(const std::vector<double> &x, const std::vector<double> &y)
+        : m_x(x), m_y(y), m_u(x.size()), m_lower_order(x.size()), m_upper_order(x.size()), m_rank(x.size()),
+          m_buffer(x.size()), m_x_order(x.size())
+    {
+        lrgSlopeBound lowest{-std::numeric_limits<double>::infinity(), false};
+        sort_at_bound(m_x, m_y, lowest, m_u, m_x_order);
+    }
+
+    double Slope(size_t a, size_t b) const
+    {
+        return (m_y[b] - m_y[a]) / (m_x[b] - m_x[a]);
+    }
+
+    // The number of slopes below the bound.
+    unsigned long long Below(const lrgSlopeBound &bound)
+    {
+        if (std::isinf(bound.t) && bound.t < 0)
+        {
+            return 0;
+        }
+        prepare(bound, bound, true);
+        return merge_inversions(m_lower_order, m_rank, m_buffer, [](size_t, const size_t *, size_t, unsigned long long) {});
+    }
+
+    // The slopes of the pairs number targets[0] <= targets[1] <= ... in the enumeration between the bounds.
+    void Sample(const lrgSlopeBound &lower, const lrgSlopeBound &upper, const std::vector<unsigned long long> &targets,
+                std::vector<double> &slopes)
+    {
+        prepare(lower, upper, std::isinf(lower.t) && lower.t < 0);
+        slopes.clear();
+        size_t next = 0;
+        merge_inversions(m_lower_order, m_rank, m_buffer, [&](size_t b, const size_t *left, size_t count, unsigned long long total)
+        {
+            while (next < targets.size() && targets[next] < total + count)
+            {
+                slopes.push_back(Slope(left[targets[next] - total], b));
+                next++;
+            }
+        });
+    }
+
+    // The slopes of all the pairs between the bounds.
+    void List(const lrgSlopeBound &lower, const lrgSlopeBound &upper, std::vector<double> &slopes)
+    {
+        prepare(lower, upper, std::isinf(lower.t) && lower.t < 0);
+        slopes.clear();
+        merge_inversions(m_lower_order, m_rank, m_buffer, [&](size_t b, const size_t *left, size_t count, unsigned long long)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                slopes.push_back(Slope(left[i], b));
+            }
+        });
+    }
+};
+
+// The slopes of rank first and first + 1 (0 based) among all of them.
+static std::pair<double, double> select_slopes(lrgSlopeCounter &counter, unsigned long long total, unsigned long long first,
+                                               size_t N, unsigned long seed, unsigned int &rounds)
+{
+    lrgSlopeBound lower{-std::numeric_limits<double>::infinity(), false};
+    lrgSlopeBound upper{std::numeric_limits<double>::infinity(), false};
+    unsigned long long below_lower = 0;
+    unsigned long long below_upper = total;
+    unsigned long long last = std::min(first + 1, total - 1);
+
+    // Few enough slopes to list: O(N) of them. The sample is of the same size, so each round cuts the
+    // interval to about 1 / sqrt(N) of what it was and two or three rounds are usually enough.
+    unsigned long long budget = std::max<unsigned long long>(4 * N, 4096);
+    size_t samples = std::max<size_t>(N, 1024);
+    std::mt19937_64 mt64(seed);
+    std::vector<unsigned long long> targets;
+    std::vector<double> slopes;
+    rounds = 0;
+    while (below_upper - below_lower > budget && lower.t != upper.t && rounds < 64)
+    {
+        rounds++;
+        unsigned long long count = below_upper - below_lower;
+        std::uniform_int_distribution<unsigned long long> distribution(0, count - 1);
+        targets.resize(samples);
+        for (auto &target : targets)
+        {
+            target = distribution(mt64);
+        }
+        std::sort(targets.begin(), targets.end());
+        counter.Sample(lower, upper, targets, slopes);
+        std::sort(slopes.begin(), slopes.end());
+        // Rounding can leave the merge a few pairs short of the counts.
+        size_t sampled = slopes.size();
+        if (sampled == 0)
+        {
+            break;
+        }
+
+        // The wanted ranks sit at these fractions of the sample, give or take about sqrt(samples) / 2 slopes.
+        double margin = 3 * std::sqrt(double(sampled));
+        double low_index = double(first - below_lower) / count * sampled - margin;
+        double high_index = double(last + 1 - below_lower) / count * sampled + margin;
+
+        // Each side only moves if the wanted ranks are still inside, otherwise the next sample tries again.
+        if (low_index >= 0)
+        {
+            lrgSlopeBound bound{slopes[size_t(low_index)], false};
+            unsigned long long below = counter.Below(bound);
+            if (below <= first)
+            {
+                lower = bound;
+                below_lower = below;
+            }
+        }
+        if (high_index < sampled)
+        {
+            lrgSlopeBound bound{slopes[size_t(high_index)], true};
+            unsigned long long below = counter.Below(bound);
+            if (below > last)
+            {
+                upper = bound;
+                below_upper = below;
+            }
+        }
+    }
+
+    // Every slope left is the same (for instance points on a perfect line).
+    if (lower.t == upper.t)
+    {
+        return std::make_pair(lower.t, lower.t);
+    }
+
+    counter.List(lower, upper, slopes);
+    if (slopes.empty())
+    {
+        throw std::logic_error("Invalid values for thetas...");
+    }
+    auto first_slope = slopes.begin() + std::min<unsigned long long>(first - below_lower, slopes.size() - 1);
+    std::nth_element(slopes.begin(), first_slope, slopes.end());
+    double first_value = *first_slope;
+    double last_value = first_value;
+    if (last != first && first_slope + 1 != slopes.end())
+    {
+        last_value = *std::min_element(first_slope + 1, slopes.end());
+    }
+    return std::make_pair(first_value, last_value);
+}
+
+// The median of the slopes of random pairs, drawn in parallel with one random stream per thread.
+static double sampled_slope(const std::vector<double> &x, const std::vector<double> &y, unsigned long pairs,
+                            unsigned int threads, unsigned long seed)
+{
+    size_t N = x.size();
+    std::vector<std::vector<double>> slopes(threads);
+    lrgParallelRun(threads, [&](unsigned int thread)
+    {
+        std::mt19937_64 mt64(seed + 0x9e3779b97f4a7c15ULL * (thread + 1));
+        std::uniform_int_distribution<size_t> distribution(0, N - 1);
+        unsigned long share = pairs / threads + (thread < pairs % threads ? 1 : 0);
+        auto &local = slopes[thread];
+        local.reserve(share);
+        // Pairs with the same x have no slope. A cap on the draws stops the loop on (almost) constant x.
+        unsigned long draws = 0;
+        while (local.size() < share && draws < 64 * share)
+        {
+            size_t a = distribution(mt64);
+            size_t b = distribution(mt64);
+            draws++;
+            if (x[a] != x[b])
+            {
+                local.push_back((y[b] - y[a]) / (x[b] - x[a]));
+            }
+        }
+    });
+
+    std::vector<double> all;
+    for (auto &local : slopes)
+    {
+        all.insert(all.end(), local.begin(), local.end());
+    }
+    if (all.empty())
+    {
+        throw std::logic_error("Invalid values for thetas...");
+    }
+    auto middle = all.begin() + all.size() / 2;
+    std::nth_element(all.begin(), middle, all.end());
+    if (all.size() % 2 == 1)
+    {
+        return *middle;
+    }
+    return (*middle + *std::max_element(all.begin(), middle)) / 2;
+}
+
+lrgTheilSenSolverStrategy::lrgTheilSenSolverStrategy()
+{
+    m_sampled_pairs = 0;
+    m_threads = lrgDefaultThreads();
+    m_seed = 5489;
+    m_rounds = 0;
+}
+
+lrgTheilSenSolverStrategy::~lrgTheilSenSolverStrategy()
+{
+}
+
+void lrgTheilSenSolverStrategy::SetSampledPairs(unsigned long &pairs)
+{
+    m_sampled_pairs = pairs;
+}
+
+void lrgTheilSenSolverStrategy::SetThreads(unsigned int &threads)
+{
+    if (threads == 0)
+    {
+        throw std::invalid_argument("The number of threads must be positive...");
+    }
+    m_threads = threads;
+}
+
+void lrgTheilSenSolverStrategy::SetSeed(unsigned long seed)
+{
+    m_seed = seed;
+}
+
+unsigned int lrgTheilSenSolverStrategy::GetRounds() const
+{
+    return m_rounds;
+}
+
+pdd lrgTheilSenSolverStrategy::FitData(pdd_vector vec)
+{
+    if (vec.empty())
+    {
+        throw std::length_error("Vector is empty...");
+    }
+
+    size_t N = vec.size();
+    std::vector<double> x(N), y(N);
+    for (size_t i = 0; i < N; i++)
+    {
+        x[i] = vec[i].first;
+        y[i] = vec[i].second;
+    }
+
+    double t1;
+    m_rounds = 0;
+    if (m_sampled_pairs > 0)
+    {
+        t1 = sampled_slope(x, y, m_sampled_pairs, m_threads, m_seed);
+    }
+    else
+    {
+        lrgSlopeCounter counter(x, y);
+        lrgSlopeBound highest{std::numeric_limits<double>::infinity(), false};
+        unsigned long long total = counter.Below(highest);
+        if (total == 0)
+        {
+            throw std::logic_error("Invalid values for thetas...");
+        }
+        // The middle slope, or the mean of the two middle ones.
+        std::pair<double, double> middle = select_slopes(counter, total, (total - 1) / 2, N, m_seed, m_rounds);
+        t1 = (total % 2 == 1) ? middle.first : (middle.first + middle.second) / 2;
+    }
+
+    // The intercept is the median of y - t1 * x.
+    std::vector<double> intercepts(N);
+    for (size_t i = 0; i < N; i++)
+    {
+        intercepts[i] = y[i] - t1 * x[i];
+    }
+    auto middle = intercepts.begin() + N / 2;
+    std::nth_element(intercepts.begin(), middle, intercepts.end());
+    double t0 = *middle;
+    if (N % 2 == 0)
+    {
+        t0 = (t0 + *std::max_element(intercepts.begin(), middle)) / 2;
+    }
+    return std::make_pair(t0, t1);
+}
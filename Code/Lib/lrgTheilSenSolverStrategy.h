@@ -0,0 +1,44 @@
+#ifndef lrgTheilSenSolverStrategy_h
+#define lrgTheilSenSolverStrategy_h
+#include "lrgLinearModelSolverStrategyI.h"
+
+// The Theil-Sen estimator: t1 is the median of the slopes (y_j - y_i) / (x_j - x_i) of all the pairs
+// of points with different x, and t0 is the median of y - t1 * x. Up to 29% of the points can be
+// outliers before the line breaks down.
+//
+// The exact version never lists all the O(N^2) slopes. For points sorted by x, a pair has a slope below t
+// exactly when the order of u = y - t * x is inverted, so counting the slopes below t is counting inversions,
+// O(N log N) with a merge sort. The search keeps an interval of slopes that holds the median, draws random
+// pairs from inside it (the same merge sort can pick the k-th inversion), and narrows the interval to the
+// sampled slopes around the median. After a few rounds only O(N) slopes are left and they are listed and
+// selected directly. The random pairs only change the running time, never the result.
+//
+// With SetSampledPairs() the median is taken over that many random pairs instead, drawn in parallel.
+class lrgTheilSenSolverStrategy : public lrgLinearModelSolverStrategyI
+{
+private:
+    unsigned long m_sampled_pairs;
+    unsigned int m_threads;
+    unsigned long m_seed;
+    unsigned int m_rounds;
+
+public:
+    lrgTheilSenSolverStrategy();
+    ~lrgTheilSenSolverStrategy();
+
+    // The number of random pairs of the approximate mode. 0 (default) is the exact estimator.
+    void SetSampledPairs(unsigned long &pairs);
+
+    // The threads of the approximate mode. Default: one per hardware thread.
+    void SetThreads(unsigned int &threads);
+
+    // The seed of the random pairs. The approximate result is the same for the same seed and threads.
+    void SetSeed(unsigned long seed);
+
+    // The rounds of interval narrowing of the last exact fit.
+    unsigned int GetRounds() const;
+
+    virtual pdd FitData(pdd_vector vec);
+};
+
+#endif
@@ -0,0 +1,54 @@
+#include "lrgWarmStartFitter.h"
+#include <stdexcept>
+
+// strategy is the iterative solver that does the actual fitting.
+lrgWarmStartFitter::lrgWarmStartFitter(std::shared_ptr<lrgIterativeSolverStrategyI> strategy)
+{
+    if (! strategy)
+    {
+        throw std::invalid_argument("The fitter needs a solver strategy...");
+    }
+    m_strategy = strategy;
+    m_has_thetas = false;
+    m_thetas = std::make_pair(0.0, 0.0);
+}
+
+// Destructor
+lrgWarmStartFitter::~lrgWarmStartFitter() {}
+
+// The first fit starts from the strategy's default, every later one from the previous solution.
+pdd lrgWarmStartFitter::FitData(pdd_vector vec)
+{
+    if (m_has_thetas)
+    {
+        m_strategy->SetInitialThetas(m_thetas);
+    }
+    else
+    {
+        m_strategy->ClearInitialThetas();
+    }
+
+    m_thetas = m_strategy->FitData(vec);
+    m_has_thetas = true;
+    return m_thetas;
+}
+
+bool lrgWarmStartFitter::HasThetas() const
+{
+    return m_has_thetas;
+}
+
+// The thetas of the last fit.
+pdd lrgWarmStartFitter::GetThetas() const
+{
+    if (! m_has_thetas)
+    {
+        throw std::logic_error("Nothing has been fitted yet...");
+    }
+    return m_thetas;
+}
+
+void lrgWarmStartFitter::Reset()
+{
+    m_has_thetas = false;
+}
@@ -0,0 +1,27 @@
+#ifndef lrgWarmStartFitter_h
+#define lrgWarmStartFitter_h
+#include "lrgIterativeSolverStrategyI.h"
+#include <memory>
+
+// Keeps the solution of the last fit and starts the next fit from it.
+// Refitting a model after a small change in the data then only needs a few iterations.
+// It is a solver strategy itself, so it can be used wherever lrgLinearModelSolverStrategyI is expected.
+class lrgWarmStartFitter : public lrgLinearModelSolverStrategyI
+{
+private:
+    std::shared_ptr<lrgIterativeSolverStrategyI> m_strategy;
+    bool m_has_thetas;
+    pdd m_thetas;
+
+public:
+    lrgWarmStartFitter(std::shared_ptr<lrgIterativeSolverStrategyI> strategy);
+    ~lrgWarmStartFitter();
+    virtual pdd FitData(pdd_vector vec);
+    bool HasThetas() const;
+    pdd GetThetas() const;
+
+    // Forget the last solution, the next fit starts from the strategy's own starting point.
+    void Reset();
+};
+
+#endif
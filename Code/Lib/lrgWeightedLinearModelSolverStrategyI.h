@@ -0,0 +1,24 @@
+#ifndef lrgWeightedLinearModelSolverStrategyI_h
+#define lrgWeightedLinearModelSolverStrategyI_h
+#include <vector>
+
+// One sample with its weight, e.g. the inverse of the variance of y or a decay with age.
+// A weight of 2 counts the same as two copies of the sample, a weight of 0 ignores it.
+struct lrgWeightedSample
+{
+    double x;
+    double y;
+    double weight;
+};
+
+typedef std::vector<lrgWeightedSample> weighted_vector;
+
+// Weighted least squares: minimise the sum of weight * (y - t0 - t1 * x)^2.
+class lrgWeightedLinearModelSolverStrategyI
+{
+public:
+    virtual ~lrgWeightedLinearModelSolverStrategyI() {}
+    virtual std::pair<double, double> FitData(const weighted_vector &vec) = 0;
+};
+
+#endif
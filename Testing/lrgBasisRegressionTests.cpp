@@ -0,0 +1,244 @@
+/*=============================================================================
+
+  PHAS0100ASSIGNMENT1: PHAS0100 Assignment 1 Linear Regression
+
+  Copyright (c) University College London (UCL). All rights reserved.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even
+  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  See LICENSE.txt in the top level directory for details.
+
+=============================================================================*/
+
+#include "catch.hpp"
+#include "lrgCatchMain.h"
+#include "lrgNormalEquationSolverStrategy.h"
+#include "lrgBasisRegression.h"
+#include "lrgFileLoaderDataCreator.h"
+#include <Eigen/Dense>
+#include <cmath>
+#include <random>
+
+// size points with x uniform in [lower, upper) and y = func(x) + noise * N(0, 1).
+static pdd_vector sample(int size, double lower, double upper, const std::function<double(double)> &func, double noise)
+{
+  std::mt19937_64 mt64;
+  std::uniform_real_distribution<double> uniform(lower, upper);
+  std::normal_distribution<double> distribution(0.0, 1.0);
+
+  pdd_vector vec;
+  for (int i = 0; i < size; i++)
+  {
+    double x = uniform(mt64);
+    vec.push_back(std::make_pair(x, func(x) + noise * distribution(mt64)));
+  }
+  return vec;
+}
+
+// The reference: the expanded matrix built in full and the normal equation solved with Eigen.
+static Eigen::VectorXd materialised_fit(const lrgBasisExpansion &basis, const pdd_vector &vec)
+{
+  Eigen::MatrixXd X = Eigen::MatrixXd::Zero(vec.size(), basis.GetSize());
+  Eigen::VectorXd y(vec.size());
+  double values[32];
+  for (size_t i = 0; i < vec.size(); i++)
+  {
+    size_t first = basis.Evaluate(vec[i].first, values);
+    for (size_t a = 0; a < basis.GetWidth(); a++)
+    {
+      X(i, first + a) = values[a];
+    }
+    y(i) = vec[i].second;
+  }
+  return (X.transpose() * X).ldlt().solve(X.transpose() * y);
+}
+
+TEST_CASE("lrgBasisExpansion: polynomial features", "[lrgBasisRegression]")
+{
+  unsigned int degree = 4;
+  unsigned int knots = 0;
+  double lower = -1;
+  double upper = 3;
+  lrgBasisExpansion basis(lrgBasis::Polynomial, degree, knots, lower, upper);
+  REQUIRE(basis.GetSize() == 5);
+  REQUIRE(basis.GetWidth() == 5);
+
+  // x = 2 is u = 0.5 on [-1, 1]. T_2 = 2u^2 - 1, T_3 = 4u^3 - 3u, T_4 = 8u^4 - 8u^2 + 1.
+  double values[5];
+  REQUIRE(basis.Evaluate(2, values) == 0);
+  REQUIRE(values[0] == 1);
+  REQUIRE(std::abs(values[1] - 0.5) < 1e-15);
+  REQUIRE(std::abs(values[2] + 0.5) < 1e-15);
+  REQUIRE(std::abs(values[3] + 1) < 1e-15);
+  REQUIRE(std::abs(values[4] + 0.5) < 1e-15);
+}
+
+TEST_CASE("lrgBasisExpansion: B-splines are a partition of unity", "[lrgBasisRegression]")
+{
+  unsigned int knots = 5;
+  double lower = 2;
+  double upper = 8;
+  for (unsigned int degree = 0; degree <= 5; degree++)
+  {
+    lrgBasisExpansion basis(lrgBasis::BSpline, degree, knots, lower, upper);
+    REQUIRE(basis.GetSize() == knots + degree + 1);
+
+    double values[32];
+    for (double x = lower; x <= upper; x += 0.0625)
+    {
+      size_t first = basis.Evaluate(x, values);
+      REQUIRE(first + basis.GetWidth() <= basis.GetSize());
+      double sum = 0;
+      for (size_t a = 0; a < basis.GetWidth(); a++)
+      {
+        REQUIRE(values[a] >= -1e-15);
+        sum += values[a];
+      }
+      REQUIRE(std::abs(sum - 1) < 1e-12);
+    }
+  }
+
+  // The piecewise linear features are hats: 1 at their own knot, 0 at all the others.
+  unsigned int degree = 3;
+  lrgBasisExpansion hats(lrgBasis::PiecewiseLinear, degree, knots, lower, upper);
+  REQUIRE(hats.GetSize() == 7);
+  REQUIRE(hats.GetWidth() == 2);
+  double values[2];
+  for (size_t k = 0; k < 7; k++)
+  {
+    size_t first = hats.Evaluate(lower + k, values);
+    REQUIRE(std::abs((first == k ? values[0] : values[1]) - 1) < 1e-15);
+  }
+}
+
+TEST_CASE("lrgBasisRegression: a straight line is the normal equation, TestData1.txt", "[lrgBasisRegression]")
+{
+  pdd_vector vec;
+  auto vec_ptr = std::make_shared<pdd_vector>(vec);
+  std::string filepath = "../../Testing/TestFiles/TestData1.txt";
+  lrgFileLoaderDataCreator data(filepath, std::move(vec_ptr));
+  vec = data.GetData();
+
+  lrgNormalEquationSolverStrategy normal;
+  pdd expected = normal.FitData(vec);
+
+  lrgBasisRegression regression;
+  std::vector<double> thetas = regression.FitData(vec);
+  REQUIRE(thetas.size() == 2);
+  for (double x = -1; x <= 2; x += 0.5)
+  {
+    REQUIRE(std::abs(regression.GetBasis().Predict(thetas, x) - (expected.first + expected.second * x)) < 1e-8);
+  }
+}
+
+TEST_CASE("lrgBasisRegression: every basis matches the materialised normal equation", "[lrgBasisRegression]")
+{
+  pdd_vector vec = sample(5000, -2, 3, [](double x) { return std::sin(2 * x) + 0.1 * x * x; }, 0.05);
+
+  unsigned int knots = 8;
+  double lower = -2;
+  double upper = 3;
+  const lrgBasis bases[] = {lrgBasis::Polynomial, lrgBasis::BSpline, lrgBasis::PiecewiseLinear};
+  for (lrgBasis kind : bases)
+  {
+    for (unsigned int degree = 1; degree <= 10; degree += 3)
+    {
+      lrgBasisExpansion basis(kind, degree, knots, lower, upper);
+      lrgBasisRegression regression(basis);
+      std::vector<double> thetas = regression.FitData(vec);
+      Eigen::VectorXd expected = materialised_fit(basis, vec);
+      REQUIRE(thetas.size() == basis.GetSize());
+
+      // High-degree splines are ill-conditioned, so compare the fitted functions rather than the thetas.
+      std::vector<double> expected_thetas(expected.data(), expected.data() + expected.size());
+      for (double x = -2; x <= 3; x += 0.125)
+      {
+        REQUIRE(std::abs(basis.Predict(thetas, x) - basis.Predict(expected_thetas, x)) < 1e-8);
+      }
+
+      // Several threads and point-by-point additions give the same thetas.
+      unsigned int threads = 4;
+      regression.SetThreads(threads);
+      std::vector<double> parallel = regression.FitData(vec);
+      regression.Reset();
+      for (auto &xy : vec)
+      {
+        regression.Add(xy.first, xy.second);
+      }
+      REQUIRE(regression.GetCount() == vec.size());
+      std::vector<double> incremental = regression.GetThetas();
+      for (size_t k = 0; k < thetas.size(); k++)
+      {
+        REQUIRE(std::abs(parallel[k] - thetas[k]) < 1e-8 * (1 + std::abs(thetas[k])));
+        REQUIRE(std::abs(incremental[k] - thetas[k]) < 1e-8 * (1 + std::abs(thetas[k])));
+      }
+    }
+  }
+}
+
+TEST_CASE("lrgBasisRegression: exact polynomials and broken lines are recovered", "[lrgBasisRegression]")
+{
+  auto cubic = [](double x) { return 1 - 2 * x + 0.5 * x * x * x; };
+  pdd_vector vec = sample(200, -3, 2, cubic, 0);
+
+  // A polynomial of degree 3 and cubic splines both contain the cubic.
+  unsigned int degree = 3;
+  unsigned int knots = 4;
+  double lower = -3;
+  double upper = 2;
+  const lrgBasis bases[] = {lrgBasis::Polynomial, lrgBasis::BSpline};
+  for (lrgBasis kind : bases)
+  {
+    lrgBasisExpansion basis(kind, degree, knots, lower, upper);
+    lrgBasisRegression regression(basis);
+    std::vector<double> thetas = regression.FitData(vec);
+    for (double x = -3; x <= 2; x += 0.25)
+    {
+      REQUIRE(std::abs(basis.Predict(thetas, x) - cubic(x)) < 1e-9);
+    }
+  }
+
+  // A broken line with its corners at the knots -2, -1, 0 and 1.
+  auto broken = [](double x) { return std::abs(x + 1) - 2 * std::max(x, 0.0) + 0.5 * x; };
+  vec = sample(300, -3, 2, broken, 0);
+  lrgBasisExpansion hats(lrgBasis::PiecewiseLinear, degree, knots, lower, upper);
+  lrgBasisRegression regression(hats);
+  std::vector<double> thetas = regression.FitData(vec);
+  for (double x = -3; x <= 2; x += 0.25)
+  {
+    REQUIRE(std::abs(hats.Predict(thetas, x) - broken(x)) < 1e-9);
+  }
+}
+
+TEST_CASE("lrgBasisRegression: negative tests", "[lrgBasisRegression]")
+{
+  REQUIRE_THROWS_AS(lrgBasisFromString("fourier"), std::invalid_argument);
+  REQUIRE(lrgBasisFromString("bspline") == lrgBasis::BSpline);
+
+  unsigned int degree = 3;
+  unsigned int knots = 2;
+  double lower = 1;
+  double upper = 1;
+  REQUIRE_THROWS_AS(lrgBasisExpansion(lrgBasis::Polynomial, degree, knots, lower, upper), std::invalid_argument);
+  upper = 2;
+  degree = 31;
+  REQUIRE_THROWS_AS(lrgBasisExpansion(lrgBasis::BSpline, degree, knots, lower, upper), std::invalid_argument);
+
+  degree = 3;
+  lrgBasisExpansion basis(lrgBasis::Polynomial, degree, knots, lower, upper);
+  REQUIRE_THROWS_AS(basis.Predict(std::vector<double>(3, 0.0), 1.5), std::invalid_argument);
+
+  lrgBasisRegression regression(basis);
+  REQUIRE_THROWS_AS(regression.GetThetas(), std::length_error);
+
+  // Three points cannot fix a cubic.
+  regression.Add(1.0, 1.0);
+  regression.Add(1.5, 2.0);
+  regression.Add(2.0, 1.0);
+  REQUIRE_THROWS_AS(regression.GetThetas(), std::logic_error);
+
+  unsigned int threads = 0;
+  REQUIRE_THROWS_AS(regression.SetThreads(threads), std::invalid_argument);
+}
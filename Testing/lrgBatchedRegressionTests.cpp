@@ -0,0 +1,169 @@
+/*=============================================================================
+
+  PHAS0100ASSIGNMENT1: PHAS0100 Assignment 1 Linear Regression
+
+  Copyright (c) University College London (UCL). All rights reserved.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even
+  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  See LICENSE.txt in the top level directory for details.
+
+=============================================================================*/
+
+#include "catch.hpp"
+#include "lrgCatchMain.h"
+#include "lrgNormalEquationSolverStrategy.h"
+#include "lrgBatchedRegression.h"
+#include "lrgFileLoaderDataCreator.h"
+#include <cmath>
+#include <random>
+
+// count datasets of random size in [min_size, max_size], dataset k follows y = k + (k % 5) * x + noise
+// with x in [offset, offset + 1).
+static std::vector<pdd_vector> random_datasets(int count, int min_size, int max_size, double offset)
+{
+  std::mt19937_64 mt64;
+  std::uniform_int_distribution<int> sizes(min_size, max_size);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  std::normal_distribution<double> noise(0.0, 0.1);
+
+  std::vector<pdd_vector> datasets(count);
+  for (int k = 0; k < count; k++)
+  {
+    int size = sizes(mt64);
+    for (int i = 0; i < size; i++)
+    {
+      double x = offset + uniform(mt64);
+      datasets[k].push_back(std::make_pair(x, k + (k % 5) * x + noise(mt64)));
+    }
+  }
+  return datasets;
+}
+
+TEST_CASE("lrgPackedDatasets: offsets", "[lrgBatchedRegression]")
+{
+  lrgPackedDatasets packed;
+  REQUIRE(packed.GetCount() == 0);
+
+  pdd_vector vec = {std::make_pair(1.0, 2.0), std::make_pair(3.0, 4.0)};
+  packed.Add(vec);
+  double x[] = {5, 6, 7};
+  double y[] = {8, 9, 10};
+  packed.Add(x, y, 3);
+
+  REQUIRE(packed.GetCount() == 2);
+  REQUIRE(packed.GetSize(0) == 2);
+  REQUIRE(packed.GetSize(1) == 3);
+  REQUIRE(packed.GetOffsets() == std::vector<size_t>({0, 2, 5}));
+  REQUIRE(packed.GetX()[2] == 5);
+  REQUIRE(packed.GetY()[1] == 4);
+
+  // Arrays that are already packed.
+  lrgPackedDatasets copy(packed.GetOffsets(), packed.GetX(), packed.GetY());
+  REQUIRE(copy.GetCount() == 2);
+  REQUIRE(copy.GetSize(1) == 3);
+}
+
+TEST_CASE("lrgBatchedRegression: every dataset matches the normal equation", "[lrgBatchedRegression]")
+{
+  // 1001 is not a multiple of the lanes and the sizes differ inside the batches.
+  std::vector<pdd_vector> datasets = random_datasets(1001, 2, 300, 0);
+  lrgPackedDatasets packed;
+  for (auto &vec : datasets)
+  {
+    packed.Add(vec);
+  }
+
+  unsigned int threads = 1;
+  lrgBatchedRegression batched(threads);
+  pdd_vector thetas = batched.FitData(packed);
+  REQUIRE(thetas.size() == datasets.size());
+
+  lrgNormalEquationSolverStrategy normal;
+  for (size_t k = 0; k < datasets.size(); k++)
+  {
+    pdd expected = normal.FitData(datasets[k]);
+    REQUIRE(std::abs(thetas[k].first - expected.first) < 1e-8);
+    REQUIRE(std::abs(thetas[k].second - expected.second) < 1e-8);
+  }
+
+  // The threads only share out the batches, every fit is computed in the same way.
+  threads = 3;
+  batched.SetThreads(threads);
+  std::vector<double> t0(datasets.size()), t1(datasets.size());
+  batched.FitData(packed, t0.data(), t1.data());
+  for (size_t k = 0; k < datasets.size(); k++)
+  {
+    REQUIRE(t0[k] == thetas[k].first);
+    REQUIRE(t1[k] == thetas[k].second);
+  }
+}
+
+TEST_CASE("lrgBatchedRegression: TestData1.txt and data far from zero", "[lrgBatchedRegression]")
+{
+  pdd_vector vec;
+  auto vec_ptr = std::make_shared<pdd_vector>(vec);
+  std::string filepath = "../../Testing/TestFiles/TestData1.txt";
+  lrgFileLoaderDataCreator data(filepath, std::move(vec_ptr));
+  vec = data.GetData();
+
+  lrgPackedDatasets packed;
+  packed.Add(vec);
+
+  // x in [1e6, 1e6 + 1): raw sums of x^2 would lose every digit of the slope.
+  std::vector<pdd_vector> far = random_datasets(3, 50, 50, 1e6);
+  for (auto &dataset : far)
+  {
+    packed.Add(dataset);
+  }
+
+  lrgBatchedRegression batched;
+  pdd_vector thetas = batched.FitData(packed);
+
+  lrgNormalEquationSolverStrategy normal;
+  pdd expected = normal.FitData(vec);
+  REQUIRE(std::abs(thetas[0].first - expected.first) < 1e-8);
+  REQUIRE(std::abs(thetas[0].second - expected.second) < 1e-8);
+  for (int k = 0; k < 3; k++)
+  {
+    REQUIRE(std::abs(thetas[k + 1].second - k % 5) < 0.2);
+  }
+}
+
+TEST_CASE("lrgBatchedRegression: datasets without a fit", "[lrgBatchedRegression]")
+{
+  lrgPackedDatasets packed;
+  packed.Add(pdd_vector());
+  packed.Add(pdd_vector({std::make_pair(1.0, 2.0)}));
+  packed.Add(pdd_vector({std::make_pair(1.0, 2.0), std::make_pair(1.0, 3.0)}));
+  packed.Add(pdd_vector({std::make_pair(0.0, 1.0), std::make_pair(1.0, 3.0)}));
+
+  lrgBatchedRegression batched;
+  pdd_vector thetas = batched.FitData(packed);
+  for (int k = 0; k < 3; k++)
+  {
+    REQUIRE(std::isnan(thetas[k].second));
+  }
+  REQUIRE(std::abs(thetas[3].first - 1) < 1e-12);
+  REQUIRE(std::abs(thetas[3].second - 2) < 1e-12);
+}
+
+TEST_CASE("lrgBatchedRegression: negative tests", "[lrgBatchedRegression]")
+{
+  unsigned int threads = 0;
+  REQUIRE_THROWS_AS(lrgBatchedRegression(threads), std::invalid_argument);
+
+  lrgBatchedRegression batched;
+  lrgPackedDatasets empty;
+  REQUIRE_THROWS_AS(batched.FitData(empty), std::length_error);
+
+  std::vector<double> x = {1, 2, 3};
+  std::vector<double> y = {1, 2};
+  REQUIRE_THROWS_AS(lrgPackedDatasets({0, 3}, x, y), std::invalid_argument);
+  y.push_back(3);
+  REQUIRE_THROWS_AS(lrgPackedDatasets({0, 2}, x, y), std::invalid_argument);
+  REQUIRE_THROWS_AS(lrgPackedDatasets({1, 3}, x, y), std::invalid_argument);
+  REQUIRE_THROWS_AS(lrgPackedDatasets({0, 2, 1, 3}, x, y), std::invalid_argument);
+}
@@ -0,0 +1,152 @@
+/*=============================================================================
+
+  PHAS0100ASSIGNMENT1: PHAS0100 Assignment 1 Linear Regression
+
+  Copyright (c) University College London (UCL). All rights reserved.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even
+  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  See LICENSE.txt in the top level directory for details.
+
+=============================================================================*/
+
+#include "catch.hpp"
+#include "lrgCatchMain.h"
+#include "lrgTestData.h"
+#include "lrgBootstrap.h"
+#include "lrgSufficientStatistics.h"
+#include <cmath>
+#include <random>
+
+TEST_CASE("lrgBootstrap: the estimate and the standard errors", "[lrgBootstrap]")
+{
+  pdd_vector vec = linear_data(2000);
+
+  unsigned int replicates = 2000;
+  lrgBootstrap bootstrap(replicates);
+  pdd thetas = bootstrap.FitData(vec);
+  REQUIRE(bootstrap.GetReplicates().size() == 2000);
+
+  // The estimate is the least squares line.
+  lrgSufficientStatistics stats(vec);
+  double t1 = stats.GetSxy() / stats.GetSxx();
+  REQUIRE(std::abs(thetas.second - t1) < 1e-10);
+  REQUIRE(std::abs(thetas.first - (stats.GetMeanY() - t1 * stats.GetMeanX())) < 1e-10);
+
+  // For normal noise the bootstrap standard errors are close to the textbook ones.
+  double s2 = (stats.GetSyy() - t1 * stats.GetSxy()) / (vec.size() - 2);
+  double se_t1 = std::sqrt(s2 / stats.GetSxx());
+  double se_t0 = std::sqrt(s2 * (1.0 / vec.size() + stats.GetMeanX() * stats.GetMeanX() / stats.GetSxx()));
+  pdd errors = bootstrap.GetStandardErrors();
+  REQUIRE(std::abs(errors.first / se_t0 - 1) < 0.1);
+  REQUIRE(std::abs(errors.second / se_t1 - 1) < 0.1);
+}
+
+TEST_CASE("lrgBootstrap: percentile and BCa intervals", "[lrgBootstrap]")
+{
+  pdd_vector vec = linear_data(1000);
+  lrgBootstrap bootstrap;
+  pdd thetas = bootstrap.FitData(vec);
+
+  std::pair<pdd, pdd> percentile = bootstrap.GetPercentileIntervals(0.95);
+  std::pair<pdd, pdd> bca = bootstrap.GetBCaIntervals(0.95);
+  for (auto intervals : {percentile, bca})
+  {
+    REQUIRE((intervals.first.first < thetas.first && thetas.first < intervals.first.second));
+    REQUIRE((intervals.second.first < thetas.second && thetas.second < intervals.second.second));
+    // The data were made with t0 = 2 and t1 = 3.
+    REQUIRE((intervals.first.first < 2 && 2 < intervals.first.second));
+    REQUIRE((intervals.second.first < 3 && 3 < intervals.second.second));
+  }
+
+  // The percentile interval of t1 is about +-1.96 standard errors, and BCa is close to it for symmetric noise.
+  pdd errors = bootstrap.GetStandardErrors();
+  double width = percentile.second.second - percentile.second.first;
+  REQUIRE(std::abs(width / (2 * 1.96 * errors.second) - 1) < 0.1);
+  REQUIRE(std::abs(bca.second.first - percentile.second.first) < 0.2 * width);
+  REQUIRE(std::abs(bca.second.second - percentile.second.second) < 0.2 * width);
+
+  // A higher level is a wider interval.
+  std::pair<pdd, pdd> wider = bootstrap.GetBCaIntervals(0.99);
+  REQUIRE(wider.second.first < bca.second.first);
+  REQUIRE(wider.second.second > bca.second.second);
+}
+
+TEST_CASE("lrgBootstrap: BCa follows a skewed distribution", "[lrgBootstrap]")
+{
+  // Exponential noise and a few points with large x: the replicated slope is skewed, the BCa interval
+  // leans with it.
+  std::mt19937_64 mt64(3);
+  std::exponential_distribution<double> noise(1.0);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  pdd_vector vec;
+  for (int i = 0; i < 200; i++)
+  {
+    double x = (i % 20 == 0) ? 5 + uniform(mt64) : uniform(mt64);
+    vec.push_back(std::make_pair(x, 1 + x + noise(mt64) * noise(mt64)));
+  }
+  unsigned int replicates = 4000;
+  lrgBootstrap bootstrap(replicates);
+  pdd thetas = bootstrap.FitData(vec);
+
+  std::pair<pdd, pdd> percentile = bootstrap.GetPercentileIntervals(0.9);
+  std::pair<pdd, pdd> bca = bootstrap.GetBCaIntervals(0.9);
+  REQUIRE((bca.second.first < thetas.second && thetas.second < bca.second.second));
+  REQUIRE(bca.second.first != percentile.second.first);
+  REQUIRE(bca.second.second != percentile.second.second);
+}
+
+TEST_CASE("lrgBootstrap: the replicates do not depend on the threads", "[lrgBootstrap]")
+{
+  pdd_vector vec = linear_data(500);
+
+  unsigned int replicates = 101;
+  unsigned int threads = 1;
+  lrgBootstrap single(replicates);
+  single.SetThreads(threads);
+  single.FitData(vec);
+
+  for (threads = 2; threads <= 4; threads++)
+  {
+    lrgBootstrap parallel(replicates);
+    parallel.SetThreads(threads);
+    parallel.FitData(vec);
+    REQUIRE(parallel.GetReplicates() == single.GetReplicates());
+  }
+
+  // Another seed gives other replicates.
+  lrgBootstrap reseeded(replicates);
+  reseeded.SetSeed(2024);
+  reseeded.FitData(vec);
+  REQUIRE(reseeded.GetReplicates() != single.GetReplicates());
+  REQUIRE(reseeded.GetReplicates().size() == 101);
+}
+
+TEST_CASE("lrgBootstrap: negative tests", "[lrgBootstrap]")
+{
+  unsigned int replicates = 0;
+  REQUIRE_THROWS_AS(lrgBootstrap(replicates), std::invalid_argument);
+
+  lrgBootstrap bootstrap;
+  unsigned int threads = 0;
+  REQUIRE_THROWS_AS(bootstrap.SetThreads(threads), std::invalid_argument);
+  REQUIRE_THROWS_AS(bootstrap.GetPercentileIntervals(0.95), std::logic_error);
+  REQUIRE_THROWS_AS(bootstrap.GetStandardErrors(), std::logic_error);
+
+  pdd_vector empty;
+  REQUIRE_THROWS_AS(bootstrap.FitData(empty), std::length_error);
+  pdd_vector vertical = {{1, 1}, {1, 2}, {1, 3}};
+  REQUIRE_THROWS_AS(bootstrap.FitData(vertical), std::logic_error);
+
+  bootstrap.FitData(linear_data(100));
+  REQUIRE_THROWS_AS(bootstrap.GetPercentileIntervals(1), std::invalid_argument);
+  REQUIRE_THROWS_AS(bootstrap.GetBCaIntervals(0), std::invalid_argument);
+
+  // Two points: most resamples draw one of them twice and have no line, those are left out.
+  pdd_vector pair = {{0, 0}, {1, 1}};
+  bootstrap.FitData(pair);
+  REQUIRE(bootstrap.GetReplicates().size() < 1000);
+  REQUIRE(bootstrap.GetReplicates().size() > 300);
+}
@@ -0,0 +1,149 @@
+/*=============================================================================
+
+  PHAS0100ASSIGNMENT1: PHAS0100 Assignment 1 Linear Regression
+
+  Copyright (c) University College London (UCL). All rights reserved.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even
+  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  See LICENSE.txt in the top level directory for details.
+
+=============================================================================*/
+
+#include "catch.hpp"
+#include "lrgCatchMain.h"
+#include "lrgNormalEquationSolverStrategy.h"
+#include "lrgConjugateGradientSolverStrategy.h"
+#include "lrgFileLoaderDataCreator.h"
+#include <cmath>
+#include <random>
+
+TEST_CASE("lrgConjugateGradientSolverStrategy: check FitData(), TestData1.txt", "[lrgConjugateGradientSolverStrategy]")
+{
+  pdd_vector vec;
+  auto vec_ptr = std::make_shared<pdd_vector>(vec);
+
+  std::string filepath = "../../Testing/TestFiles/TestData1.txt";
+  lrgFileLoaderDataCreator data(filepath, std::move(vec_ptr));
+  vec = data.GetData();
+
+  lrgNormalEquationSolverStrategy normal;
+  pdd expected = normal.FitData(vec);
+
+  // With two thetas CG converges in (at most) two iterations.
+  lrgConjugateGradientSolverStrategy strategy;
+  std::unique_ptr<lrgLinearModelSolverStrategyI> solver = std::make_unique<lrgConjugateGradientSolverStrategy>(strategy);
+  pdd thetas = solver->FitData(vec);
+  REQUIRE((std::abs(thetas.first - expected.first) < 1e-8 && std::abs(thetas.second - expected.second) < 1e-8));
+
+  strategy.SetPreconditioning(true);
+  thetas = strategy.FitData(vec);
+  REQUIRE(strategy.GetIterationsRun() <= 3);
+  REQUIRE((std::abs(thetas.first - expected.first) < 1e-8 && std::abs(thetas.second - expected.second) < 1e-8));
+}
+
+TEST_CASE("lrgConjugateGradientSolverStrategy: many features, badly scaled columns", "[lrgConjugateGradientSolverStrategy]")
+{
+  int N = 400;
+  int p = 40;
+
+  std::mt19937_64 mt64;
+  std::normal_distribution<double> distribution(0.0, 1.0);
+
+  // Column j is scaled by 10^(j % 4), so X^T X has a wide spread of eigenvalues.
+  Eigen::MatrixXd X(N, p);
+  Eigen::VectorXd true_thetas(p);
+  for (int j = 0; j < p; j++)
+  {
+    true_thetas(j) = distribution(mt64);
+    for (int i = 0; i < N; i++)
+    {
+      X(i, j) = (j == 0) ? 1 : distribution(mt64) * std::pow(10.0, j % 4);
+    }
+  }
+  Eigen::VectorXd y = X * true_thetas;
+  for (int i = 0; i < N; i++)
+  {
+    y(i) += 0.1 * distribution(mt64);
+  }
+
+  // Reference solution from the normal equation.
+  Eigen::VectorXd expected = (X.transpose() * X).ldlt().solve(X.transpose() * y);
+
+  unsigned int iterations = 10000;
+  double tolerance = 1e-12;
+  lrgConjugateGradientSolverStrategy strategy(iterations, tolerance);
+
+  Eigen::VectorXd thetas = strategy.FitData(X, y);
+  unsigned int plain_iterations = strategy.GetIterationsRun();
+  REQUIRE((thetas - expected).cwiseAbs().maxCoeff() < 1e-6);
+
+  // Unit-length columns need fewer iterations.
+  strategy.SetPreconditioning(true);
+  thetas = strategy.FitData(X, y);
+  unsigned int cold_iterations = strategy.GetIterationsRun();
+  REQUIRE(cold_iterations < plain_iterations);
+  REQUIRE((thetas - expected).cwiseAbs().maxCoeff() < 1e-6);
+
+  // After a small change of y, starting from the old solution saves iterations.
+  for (int i = 0; i < N; i++)
+  {
+    y(i) += 1e-6 * distribution(mt64);
+  }
+  expected = (X.transpose() * X).ldlt().solve(X.transpose() * y);
+  strategy.SetInitialThetas(thetas);
+  thetas = strategy.FitData(X, y);
+  REQUIRE(strategy.GetIterationsRun() < cold_iterations);
+  REQUIRE((thetas - expected).cwiseAbs().maxCoeff() < 1e-6);
+
+  // Initial thetas of the wrong size.
+  strategy.SetInitialThetas(Eigen::VectorXd::Zero(p + 1));
+  REQUIRE_THROWS_AS(strategy.FitData(X, y), std::invalid_argument);
+  strategy.ClearInitialThetas();
+  REQUIRE_NOTHROW(strategy.FitData(X, y));
+}
+
+TEST_CASE("lrgConjugateGradientSolverStrategy: y orthogonal to X with a warm start", "[lrgConjugateGradientSolverStrategy]")
+{
+  // X^T y = 0, so the least squares answer is zero.
+  Eigen::MatrixXd X(4, 2);
+  X << 1, 1,
+       1, -1,
+       1, 1,
+       1, -1;
+  Eigen::VectorXd y(4);
+  y << 1, 1, -1, -1;
+
+  lrgConjugateGradientSolverStrategy strategy;
+  Eigen::VectorXd initial(2);
+  initial << 2.5, -1.5;
+  strategy.SetInitialThetas(initial);
+  for (bool preconditioning : {false, true})
+  {
+    strategy.SetPreconditioning(preconditioning);
+    Eigen::VectorXd thetas = strategy.FitData(X, y);
+    REQUIRE(thetas.cwiseAbs().maxCoeff() == 0);
+  }
+}
+
+TEST_CASE("lrgConjugateGradientSolverStrategy: negative tests", "[lrgConjugateGradientSolverStrategy]")
+{
+  pdd_vector vec;
+  lrgConjugateGradientSolverStrategy strategy;
+
+  // Empty vector.
+  CHECK_THROWS(strategy.FitData(vec));
+
+  // X and y of different length.
+  Eigen::MatrixXd X = Eigen::MatrixXd::Ones(10, 2);
+  Eigen::VectorXd y = Eigen::VectorXd::Ones(9);
+  CHECK_THROWS(strategy.FitData(X, y));
+
+  // No iterations.
+  unsigned int iterations = 0;
+  strategy.SetIterations(iterations);
+  vec.push_back(std::make_pair(1.0, 2.0));
+  CHECK_THROWS(strategy.FitData(vec));
+}
@@ -0,0 +1,239 @@
+/*=============================================================================
+
+  PHAS0100ASSIGNMENT1: PHAS0100 Assignment 1 Linear Regression
+
+  Copyright (c) University College London (UCL). All rights reserved.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even
+  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  See LICENSE.txt in the top level directory for details.
+
+=============================================================================*/
+
+#include "catch.hpp"
+#include "lrgCatchMain.h"
+#include "lrgNormalEquationSolverStrategy.h"
+#include "lrgCoordinateDescentSolverStrategy.h"
+#include "lrgFileLoaderDataCreator.h"
+#include <cmath>
+#include <random>
+
+// y = 1 + sum_j (j + 1) * x_j + noise for the first `relevant` columns, the rest are pure noise.
+static void sparse_problem(int N, int p, int relevant, Eigen::MatrixXd &X, Eigen::VectorXd &y)
+{
+  std::mt19937_64 mt64;
+  std::normal_distribution<double> distribution(0.0, 1.0);
+
+  X.resize(N, p);
+  y.resize(N);
+  for (int i = 0; i < N; i++)
+  {
+    y(i) = 1 + 0.1 * distribution(mt64);
+    for (int j = 0; j < p; j++)
+    {
+      X(i, j) = distribution(mt64);
+      if (j < relevant)
+      {
+        y(i) += (j + 1) * X(i, j);
+      }
+    }
+  }
+}
+
+TEST_CASE("lrgCoordinateDescentSolverStrategy: lambda = 0 is least squares, TestData1.txt", "[lrgCoordinateDescentSolverStrategy]")
+{
+  pdd_vector vec;
+  auto vec_ptr = std::make_shared<pdd_vector>(vec);
+
+  std::string filepath = "../../Testing/TestFiles/TestData1.txt";
+  lrgFileLoaderDataCreator data(filepath, std::move(vec_ptr));
+  vec = data.GetData();
+
+  lrgNormalEquationSolverStrategy normal;
+  pdd expected = normal.FitData(vec);
+
+  lrgCoordinateDescentSolverStrategy strategy;
+  std::unique_ptr<lrgLinearModelSolverStrategyI> solver = std::make_unique<lrgCoordinateDescentSolverStrategy>(strategy);
+  pdd thetas = solver->FitData(vec);
+  REQUIRE((std::abs(thetas.first - expected.first) < 1e-8 && std::abs(thetas.second - expected.second) < 1e-8));
+}
+
+TEST_CASE("lrgCoordinateDescentSolverStrategy: one feature is a soft threshold", "[lrgCoordinateDescentSolverStrategy]")
+{
+  pdd_vector vec;
+  auto vec_ptr = std::make_shared<pdd_vector>(vec);
+
+  std::string filepath = "../../Testing/TestFiles/TestData1.txt";
+  lrgFileLoaderDataCreator data(filepath, std::move(vec_ptr));
+  vec = data.GetData();
+
+  // Covariances of the data.
+  double N = vec.size();
+  double mean_x = 0, mean_y = 0;
+  for (auto &xy : vec)
+  {
+    mean_x += xy.first / N;
+    mean_y += xy.second / N;
+  }
+  double sxx = 0, sxy = 0;
+  for (auto &xy : vec)
+  {
+    sxx += (xy.first - mean_x) * (xy.first - mean_x) / N;
+    sxy += (xy.first - mean_x) * (xy.second - mean_y) / N;
+  }
+
+  // Lasso shrinks |sxy| by lambda, ridge divides by (sxx + lambda), elastic net does both.
+  double lambda = 0.3 * std::abs(sxy);
+  double alpha = 0.5;
+  lrgCoordinateDescentSolverStrategy strategy(lambda, alpha);
+  pdd thetas = strategy.FitData(vec);
+  double expected = (std::abs(sxy) - lambda * alpha) / (sxx + lambda * (1 - alpha)) * (sxy > 0 ? 1 : -1);
+  REQUIRE(std::abs(thetas.second - expected) < 1e-10);
+  REQUIRE(std::abs(thetas.first - (mean_y - expected * mean_x)) < 1e-8);
+
+  // Above lambda_max = |sxy| / alpha the slope is zero and the intercept is the mean of y.
+  lambda = 2.01 * std::abs(sxy);
+  strategy.SetLambda(lambda);
+  thetas = strategy.FitData(vec);
+  REQUIRE(thetas.second == 0);
+  REQUIRE(std::abs(thetas.first - mean_y) < 1e-10);
+}
+
+TEST_CASE("lrgCoordinateDescentSolverStrategy: ridge matches the closed form", "[lrgCoordinateDescentSolverStrategy]")
+{
+  Eigen::MatrixXd X;
+  Eigen::VectorXd y;
+  sparse_problem(200, 15, 5, X, y);
+
+  double lambda = 0.5;
+  double alpha = 0;
+  lrgCoordinateDescentSolverStrategy strategy(lambda, alpha);
+  Eigen::VectorXd thetas = strategy.FitData(X, y);
+
+  // (Xc^T Xc / N + lambda I) thetas = Xc^T yc / N on the centred data.
+  Eigen::MatrixXd centred_x = X.rowwise() - X.colwise().mean();
+  Eigen::VectorXd centred_y = y.array() - y.mean();
+  Eigen::MatrixXd gram = centred_x.transpose() * centred_x / 200.0 + lambda * Eigen::MatrixXd::Identity(15, 15);
+  Eigen::VectorXd expected = gram.ldlt().solve(centred_x.transpose() * centred_y / 200.0);
+
+  REQUIRE((thetas.tail(15) - expected).cwiseAbs().maxCoeff() < 1e-8);
+  REQUIRE(std::abs(thetas(0) - (y.mean() - X.colwise().mean().dot(expected))) < 1e-8);
+}
+
+TEST_CASE("lrgCoordinateDescentSolverStrategy: active set agrees with the full sweep", "[lrgCoordinateDescentSolverStrategy]")
+{
+  int p = 200;
+  Eigen::MatrixXd X;
+  Eigen::VectorXd y;
+  sparse_problem(400, p, 5, X, y);
+
+  double lambda = 0.5;
+  double alpha = 1;
+  lrgCoordinateDescentSolverStrategy naive(lambda, alpha);
+  naive.SetActiveSet(false);
+  lrgCoordinateDescentSolverStrategy active(lambda, alpha);
+
+  Eigen::VectorXd naive_thetas = naive.FitData(X, y);
+  Eigen::VectorXd active_thetas = active.FitData(X, y);
+
+  REQUIRE((naive_thetas - active_thetas).cwiseAbs().maxCoeff() < 1e-8);
+  REQUIRE(active.GetCoordinateUpdates() < naive.GetCoordinateUpdates());
+
+  // The lasso picks the relevant features and drops (most of) the noise.
+  for (int j = 0; j < 5; j++)
+  {
+    REQUIRE(active_thetas(j + 1) > 0);
+  }
+  REQUIRE((active_thetas.tail(p).array() != 0).count() < 20);
+
+  // Every feature satisfies the optimality conditions: the correlation with the residuals is
+  // lambda * sign(theta) for the non-zero thetas and at most lambda for the zero ones.
+  Eigen::MatrixXd centred_x = X.rowwise() - X.colwise().mean();
+  Eigen::VectorXd residuals = y - (X * active_thetas.tail(p)).array().matrix() - Eigen::VectorXd::Constant(400, active_thetas(0));
+  Eigen::VectorXd correlations = centred_x.transpose() * residuals / 400.0;
+  for (int j = 0; j < p; j++)
+  {
+    if (active_thetas(j + 1) != 0)
+    {
+      REQUIRE(std::abs(correlations(j) - lambda * (active_thetas(j + 1) > 0 ? 1 : -1)) < 1e-6);
+    }
+    else
+    {
+      REQUIRE(std::abs(correlations(j)) <= lambda + 1e-6);
+    }
+  }
+}
+
+TEST_CASE("lrgCoordinateDescentSolverStrategy: regularisation path", "[lrgCoordinateDescentSolverStrategy]")
+{
+  int p = 100;
+  Eigen::MatrixXd X;
+  Eigen::VectorXd y;
+  sparse_problem(300, p, 5, X, y);
+
+  double alpha = 0.9;
+  Eigen::VectorXd lambdas = lrgCoordinateDescentSolverStrategy::LambdaGrid(X, y, alpha, 30, 1e-3);
+  REQUIRE(lambdas.size() == 30);
+  REQUIRE(std::abs(lambdas(29) / lambdas(0) - 1e-3) < 1e-12);
+
+  lrgCoordinateDescentSolverStrategy strategy;
+  strategy.SetAlpha(alpha);
+  Eigen::MatrixXd path = strategy.FitPath(X, y, lambdas);
+  unsigned long path_updates = strategy.GetCoordinateUpdates();
+  REQUIRE(path.rows() == p + 1);
+  REQUIRE(path.cols() == 30);
+
+  // lambda_max gives no features at all, the intercept is the mean of y.
+  REQUIRE(path.col(0).tail(p).cwiseAbs().maxCoeff() == 0);
+  REQUIRE(std::abs(path(0, 0) - y.mean()) < 1e-10);
+
+  // Every column is the same as an independent (cold-started) fit, but the whole path is cheaper.
+  unsigned long independent_updates = 0;
+  for (int k = 0; k < 30; k++)
+  {
+    double lambda = lambdas(k);
+    lrgCoordinateDescentSolverStrategy single(lambda, alpha);
+    Eigen::VectorXd thetas = single.FitData(X, y);
+    independent_updates += single.GetCoordinateUpdates();
+    REQUIRE((thetas - path.col(k)).cwiseAbs().maxCoeff() < 1e-7);
+  }
+  REQUIRE(path_updates < independent_updates);
+
+  // A single fit warm-started from its neighbour on the path gives the same answer for less work.
+  double lambda = lambdas(20);
+  lrgCoordinateDescentSolverStrategy single(lambda, alpha);
+  single.FitData(X, y);
+  unsigned long cold_updates = single.GetCoordinateUpdates();
+  single.SetInitialThetas(Eigen::VectorXd(path.col(19)));
+  Eigen::VectorXd thetas = single.FitData(X, y);
+  REQUIRE(single.GetCoordinateUpdates() < cold_updates);
+  REQUIRE((thetas - path.col(20)).cwiseAbs().maxCoeff() < 1e-7);
+}
+
+TEST_CASE("lrgCoordinateDescentSolverStrategy: negative tests", "[lrgCoordinateDescentSolverStrategy]")
+{
+  double lambda = -1;
+  double alpha = 0.5;
+  REQUIRE_THROWS_AS(lrgCoordinateDescentSolverStrategy(lambda, alpha), std::invalid_argument);
+
+  lambda = 1;
+  alpha = 1.5;
+  REQUIRE_THROWS_AS(lrgCoordinateDescentSolverStrategy(lambda, alpha), std::invalid_argument);
+
+  lrgCoordinateDescentSolverStrategy strategy;
+  pdd_vector empty;
+  REQUIRE_THROWS_AS(strategy.FitData(empty), std::length_error);
+
+  Eigen::MatrixXd X = Eigen::MatrixXd::Ones(10, 3);
+  Eigen::VectorXd y = Eigen::VectorXd::Ones(9);
+  REQUIRE_THROWS_AS(strategy.FitData(X, y), std::invalid_argument);
+
+  y = Eigen::VectorXd::Ones(10);
+  Eigen::VectorXd lambdas(2);
+  lambdas << 1, -1;
+  REQUIRE_THROWS_AS(strategy.FitPath(X, y, lambdas), std::invalid_argument);
+  REQUIRE_THROWS_AS(lrgCoordinateDescentSolverStrategy::LambdaGrid(X, y, 1, 0, 0.1), std::invalid_argument);
+  REQUIRE_THROWS_AS(lrgCoordinateDescentSolverStrategy::LambdaGrid(X, y, 1, 10, 1.5), std::invalid_argument);
+}
@@ -0,0 +1,187 @@
+/*=============================================================================
+
+  PHAS0100ASSIGNMENT1: PHAS0100 Assignment 1 Linear Regression
+
+  Copyright (c) University College London (UCL). All rights reserved.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even
+  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  See LICENSE.txt in the top level directory for details.
+
+=============================================================================*/
+
+#include "catch.hpp"
+#include "lrgCatchMain.h"
+#include "lrgCrossValidation.h"
+#include "lrgSufficientStatistics.h"
+#include "lrgNormalEquationSolverStrategy.h"
+#include "lrgFileLoaderDataCreator.h"
+#include <cmath>
+
+static pdd_vector test_data()
+{
+  pdd_vector vec;
+  auto vec_ptr = std::make_shared<pdd_vector>(vec);
+  std::string filepath = "../../Testing/TestFiles/TestData1.txt";
+  lrgFileLoaderDataCreator data(filepath, std::move(vec_ptr));
+  return data.GetData();
+}
+
+// Fits every fold from scratch on the other folds and sums its squared errors on the fold.
+static double naive_k_fold(const pdd_vector &vec, const std::vector<unsigned int> &folds, unsigned int K,
+                           std::vector<pdd> &thetas)
+{
+  lrgNormalEquationSolverStrategy normal;
+  double squared_error = 0;
+  thetas.clear();
+  for (unsigned int k = 0; k < K; k++)
+  {
+    pdd_vector training;
+    for (size_t i = 0; i < vec.size(); i++)
+    {
+      if (folds[i] != k)
+      {
+        training.push_back(vec[i]);
+      }
+    }
+    pdd fit = normal.FitData(training);
+    thetas.push_back(fit);
+    for (size_t i = 0; i < vec.size(); i++)
+    {
+      if (folds[i] == k)
+      {
+        double residual = vec[i].second - fit.first - fit.second * vec[i].first;
+        squared_error += residual * residual;
+      }
+    }
+  }
+  return squared_error / vec.size();
+}
+
+TEST_CASE("lrgSufficientStatistics: Subtract undoes Merge and the squared error", "[lrgCrossValidation]")
+{
+  pdd_vector vec = test_data();
+  pdd_vector head(vec.begin(), vec.begin() + 300);
+  pdd_vector tail(vec.begin() + 300, vec.end());
+
+  lrgSufficientStatistics all(vec);
+  lrgSufficientStatistics first(head);
+  lrgSufficientStatistics rest = all;
+  rest.Subtract(first);
+  lrgSufficientStatistics expected(tail);
+  REQUIRE(rest.GetWeight() == expected.GetWeight());
+  REQUIRE(std::abs(rest.GetMeanX() - expected.GetMeanX()) < 1e-12);
+  REQUIRE(std::abs(rest.GetMeanY() - expected.GetMeanY()) < 1e-12);
+  REQUIRE(std::abs(rest.GetSxx() - expected.GetSxx()) < 1e-9 * expected.GetSxx());
+  REQUIRE(std::abs(rest.GetSxy() - expected.GetSxy()) < 1e-9 * std::abs(expected.GetSxy()));
+  REQUIRE(std::abs(rest.GetSyy() - expected.GetSyy()) < 1e-9 * expected.GetSyy());
+
+  // Everything taken away leaves nothing.
+  rest.Subtract(expected);
+  REQUIRE(rest.GetWeight() == 0);
+
+  pdd thetas = std::make_pair(2.5, 1.5);
+  double squared_error = 0;
+  for (auto &xy : tail)
+  {
+    squared_error += (xy.second - 2.5 - 1.5 * xy.first) * (xy.second - 2.5 - 1.5 * xy.first);
+  }
+  REQUIRE(std::abs(expected.GetSquaredError(thetas) - squared_error) < 1e-9 * squared_error);
+}
+
+TEST_CASE("lrgCrossValidation: K-fold matches refitting every fold, TestData1.txt", "[lrgCrossValidation]")
+{
+  pdd_vector vec = test_data();
+
+  for (unsigned int K : {2u, 5u, 10u})
+  {
+    lrgCrossValidation validation(K);
+    double error = validation.KFold(vec);
+
+    std::vector<unsigned int> folds(vec.size());
+    for (size_t i = 0; i < vec.size(); i++)
+    {
+      folds[i] = (unsigned int)(i * K / vec.size());
+    }
+    std::vector<pdd> thetas;
+    double expected = naive_k_fold(vec, folds, K, thetas);
+    REQUIRE(std::abs(error - expected) < 1e-9 * expected);
+
+    const std::vector<lrgFoldFit> &fits = validation.GetFoldFits();
+    REQUIRE(fits.size() == K);
+    double weight = 0;
+    for (unsigned int k = 0; k < K; k++)
+    {
+      REQUIRE(std::abs(fits[k].thetas.first - thetas[k].first) < 1e-9);
+      REQUIRE(std::abs(fits[k].thetas.second - thetas[k].second) < 1e-9);
+      weight += fits[k].weight;
+    }
+    REQUIRE(weight == vec.size());
+  }
+
+  // Folds given point by point (here every third point).
+  unsigned int K = 3;
+  std::vector<unsigned int> folds(vec.size());
+  for (size_t i = 0; i < vec.size(); i++)
+  {
+    folds[i] = i % 3;
+  }
+  lrgCrossValidation validation(K);
+  std::vector<pdd> thetas;
+  double expected = naive_k_fold(vec, folds, K, thetas);
+  REQUIRE(std::abs(validation.KFold(vec, folds) - expected) < 1e-9 * expected);
+}
+
+TEST_CASE("lrgCrossValidation: leave-one-out from the hat matrix", "[lrgCrossValidation]")
+{
+  pdd_vector vec = test_data();
+  vec.resize(200);
+
+  lrgNormalEquationSolverStrategy normal;
+  double press = 0;
+  for (size_t i = 0; i < vec.size(); i++)
+  {
+    pdd_vector others = vec;
+    others.erase(others.begin() + i);
+    pdd fit = normal.FitData(others);
+    double residual = vec[i].second - fit.first - fit.second * vec[i].first;
+    press += residual * residual;
+  }
+  press /= vec.size();
+
+  lrgCrossValidation validation;
+  double error = validation.LeaveOneOut(vec);
+  REQUIRE(std::abs(error - press) < 1e-9 * press);
+
+  // N folds of one point each are leave-one-out as well.
+  unsigned int K = vec.size();
+  lrgCrossValidation every_point(K);
+  REQUIRE(std::abs(every_point.KFold(vec) - press) < 1e-9 * press);
+}
+
+TEST_CASE("lrgCrossValidation: negative tests", "[lrgCrossValidation]")
+{
+  unsigned int K = 1;
+  REQUIRE_THROWS_AS(lrgCrossValidation(K), std::invalid_argument);
+
+  lrgCrossValidation validation;
+  pdd_vector empty;
+  REQUIRE_THROWS_AS(validation.LeaveOneOut(empty), std::length_error);
+  REQUIRE_THROWS_AS(validation.KFold(empty, std::vector<unsigned int>()), std::length_error);
+
+  // Fewer points than folds, folds out of range and empty folds.
+  pdd_vector vec = {{1, 2}, {2, 3}, {3, 5}, {4, 4}};
+  REQUIRE_THROWS_AS(validation.KFold(vec), std::invalid_argument);
+  K = 2;
+  lrgCrossValidation two(K);
+  REQUIRE_THROWS_AS(two.KFold(vec, {0, 1, 2, 0}), std::invalid_argument);
+  REQUIRE_THROWS_AS(two.KFold(vec, {0, 0, 0, 0}), std::invalid_argument);
+  REQUIRE_THROWS_AS(two.KFold(vec, {0, 1}), std::invalid_argument);
+
+  // A training set at a single x has no line, and neither has a point that decides the line alone.
+  pdd_vector vertical = {{1, 1}, {1, 2}, {2, 3}, {2, 4}};
+  REQUIRE_THROWS_AS(two.KFold(vertical), std::logic_error);
+  REQUIRE_THROWS_AS(validation.LeaveOneOut(pdd_vector{{1, 1}, {2, 3}}), std::logic_error);
+}
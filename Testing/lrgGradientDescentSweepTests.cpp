@@ -0,0 +1,143 @@
+/*=============================================================================
+
+  PHAS0100ASSIGNMENT1: PHAS0100 Assignment 1 Linear Regression
+
+  Copyright (c) University College London (UCL). All rights reserved.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even
+  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  See LICENSE.txt in the top level directory for details.
+
+=============================================================================*/
+
+#include "catch.hpp"
+#include "lrgCatchMain.h"
+#include "lrgTestData.h"
+#include "lrgGradientDescentSweep.h"
+#include "lrgSufficientStatistics.h"
+#include <cmath>
+
+TEST_CASE("lrgGradientDescentSweep: the best configuration reaches the least squares line", "[lrgGradientDescentSweep]")
+{
+  pdd_vector vec = linear_data(2000);
+  lrgSufficientStatistics stats(vec);
+  pdd expected = least_squares(stats);
+
+  // eta = 5 diverges for every rule on x in [0, 1), eta = 0.001 is far too slow for 2000 iterations.
+  auto configurations = lrgGradientDescentSweep::Grid({0.001, 0.02, 0.1, 0.5, 5}, {2000},
+                                                      {lrgUpdateRule::Plain, lrgUpdateRule::Momentum, lrgUpdateRule::Nesterov});
+  REQUIRE(configurations.size() == 15);
+
+  lrgGradientDescentSweep sweep;
+  auto &leaderboard = sweep.Run(vec, configurations);
+  REQUIRE(leaderboard.size() == 15);
+
+  const lrgSweepResult &best = sweep.GetBest();
+  REQUIRE(! best.diverged);
+  REQUIRE(best.iterations_run == 2000);
+  REQUIRE(std::abs(best.thetas.first - expected.first) < 1e-6);
+  REQUIRE(std::abs(best.thetas.second - expected.second) < 1e-6);
+  REQUIRE(std::abs(best.loss - stats.GetSquaredError(expected) / stats.GetWeight()) < 1e-9);
+
+  // The diverged configurations are flagged and sorted last, the others by rung and loss.
+  for (size_t i = 0; i < leaderboard.size(); i++)
+  {
+    bool diverging = (leaderboard[i].configuration.eta == 5);
+    REQUIRE(leaderboard[i].diverged == diverging);
+    REQUIRE(leaderboard[i].diverged == (i >= 12));
+    if (i > 0 && ! leaderboard[i].diverged)
+    {
+      REQUIRE(leaderboard[i - 1].rung >= leaderboard[i].rung);
+      if (leaderboard[i - 1].rung == leaderboard[i].rung)
+      {
+        REQUIRE(leaderboard[i - 1].loss <= leaderboard[i].loss);
+      }
+    }
+  }
+
+  // The diverged ones dropped out after rung 0, the slowest one soon after.
+  REQUIRE(leaderboard.back().rung == 0);
+  REQUIRE(leaderboard[11].rung < best.rung);
+
+  // Halving spends far fewer iterations than running every configuration to the end.
+  REQUIRE(sweep.GetTotalIterations() < 15 * 2000 / 2);
+}
+
+TEST_CASE("lrgGradientDescentSweep: a result is the same as running the configuration alone", "[lrgGradientDescentSweep]")
+{
+  pdd_vector vec = linear_data(500);
+  lrgSufficientStatistics stats(vec);
+
+  auto configurations = lrgGradientDescentSweep::Grid({0.01, 0.05, 0.2}, {300},
+                                                      {lrgUpdateRule::Plain, lrgUpdateRule::Adam},
+                                                      {lrgPreconditioner::None, lrgPreconditioner::Standardise});
+  lrgGradientDescentSweep sweep;
+  sweep.Run(stats, configurations);
+
+  for (auto &result : sweep.GetLeaderboard())
+  {
+    double eta = result.configuration.eta;
+    unsigned int iterations = result.iterations_run;
+    lrgGradientDescentSolverStrategy solver(eta, iterations);
+    solver.SetUpdateRule(result.configuration.rule);
+    solver.SetPreconditioner(result.configuration.preconditioner);
+    solver.SetInitialThetas(std::make_pair(0.0, 0.0));
+    pdd thetas = solver.FitData(stats);
+    REQUIRE(thetas.first == result.thetas.first);
+    REQUIRE(thetas.second == result.thetas.second);
+  }
+}
+
+TEST_CASE("lrgGradientDescentSweep: the leaderboard does not depend on the threads", "[lrgGradientDescentSweep]")
+{
+  pdd_vector vec = linear_data(1000);
+  auto configurations = lrgGradientDescentSweep::Grid({0.005, 0.01, 0.05, 0.1, 0.3, 0.6, 0.9}, {500, 1000},
+                                                      {lrgUpdateRule::Plain, lrgUpdateRule::Nesterov, lrgUpdateRule::BarzilaiBorwein});
+
+  unsigned int one = 1, four = 4, three = 3;
+  lrgGradientDescentSweep serial, parallel;
+  serial.SetThreads(one);
+  parallel.SetThreads(four);
+  serial.SetReduction(three);
+  parallel.SetReduction(three);
+  auto &a = serial.Run(vec, configurations);
+  auto &b = parallel.Run(vec, configurations);
+
+  REQUIRE(a.size() == b.size());
+  for (size_t i = 0; i < a.size(); i++)
+  {
+    REQUIRE(a[i].configuration.eta == b[i].configuration.eta);
+    REQUIRE(a[i].configuration.rule == b[i].configuration.rule);
+    REQUIRE(a[i].configuration.iterations == b[i].configuration.iterations);
+    REQUIRE(a[i].rung == b[i].rung);
+    REQUIRE(a[i].thetas.first == b[i].thetas.first);
+    REQUIRE(a[i].thetas.second == b[i].thetas.second);
+  }
+  REQUIRE(serial.GetTotalIterations() == parallel.GetTotalIterations());
+}
+
+TEST_CASE("lrgGradientDescentSweep: negative tests", "[lrgGradientDescentSweep]")
+{
+  pdd_vector vec = linear_data(100);
+  auto configurations = lrgGradientDescentSweep::Grid({0.1}, {100}, {lrgUpdateRule::Plain});
+  lrgGradientDescentSweep sweep;
+
+  unsigned int zero = 0, one = 1;
+  REQUIRE_THROWS_AS(sweep.SetThreads(zero), std::invalid_argument);
+  REQUIRE_THROWS_AS(sweep.SetReduction(one), std::invalid_argument);
+  REQUIRE_THROWS_AS(sweep.GetBest(), std::logic_error);
+  REQUIRE_THROWS_AS(sweep.Run(vec, {}), std::invalid_argument);
+
+  pdd_vector empty;
+  REQUIRE_THROWS_AS(sweep.Run(empty, configurations), std::length_error);
+
+  // Every configuration is checked before anything runs.
+  configurations.push_back({0.0, 100, lrgUpdateRule::Plain, lrgPreconditioner::None, lrgStepSize::Fixed, 0.9});
+  REQUIRE_THROWS_AS(sweep.Run(vec, configurations), std::invalid_argument);
+  configurations.back() = {0.1, 100, lrgUpdateRule::Adam, lrgPreconditioner::None, lrgStepSize::Auto, 0.9};
+  REQUIRE_THROWS_AS(sweep.Run(vec, configurations), std::invalid_argument);
+  configurations.back() = {0.1, 100, lrgUpdateRule::Momentum, lrgPreconditioner::None, lrgStepSize::Fixed, 1.0};
+  REQUIRE_THROWS_AS(sweep.Run(vec, configurations), std::invalid_argument);
+}
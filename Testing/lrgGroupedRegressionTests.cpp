@@ -0,0 +1,211 @@
+/*=============================================================================
+
+  PHAS0100ASSIGNMENT1: PHAS0100 Assignment 1 Linear Regression
+
+  Copyright (c) University College London (UCL). All rights reserved.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even
+  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  See LICENSE.txt in the top level directory for details.
+
+=============================================================================*/
+
+#include "catch.hpp"
+#include "lrgCatchMain.h"
+#include "lrgNormalEquationSolverStrategy.h"
+#include "lrgGroupedRegression.h"
+#include "lrgFileLoaderDataCreator.h"
+#include <cmath>
+#include <map>
+#include <random>
+#include <sstream>
+
+// count points for every key in [0, keys), group k follows y = k + (k % 7) * x + noise.
+// The points of the groups are shuffled together.
+static void grouped_problem(int keys, int count, std::vector<long long> &key_vec, pdd_vector &vec)
+{
+  std::mt19937_64 mt64;
+  std::uniform_real_distribution<double> uniform(-5.0, 5.0);
+  std::normal_distribution<double> noise(0.0, 0.1);
+
+  std::vector<int> order;
+  for (int k = 0; k < keys; k++)
+  {
+    for (int i = 0; i < count; i++)
+    {
+      order.push_back(k);
+    }
+  }
+  std::shuffle(order.begin(), order.end(), mt64);
+
+  key_vec.clear();
+  vec.clear();
+  for (int k : order)
+  {
+    double x = uniform(mt64);
+    key_vec.push_back(1000003LL * k);
+    vec.push_back(std::make_pair(x, k + (k % 7) * x + noise(mt64)));
+  }
+}
+
+TEST_CASE("lrgSufficientStatistics: Merge is the same as adding the points one by one", "[lrgGroupedRegression]")
+{
+  std::vector<long long> keys;
+  pdd_vector vec;
+  grouped_problem(1, 1000, keys, vec);
+
+  lrgSufficientStatistics all(vec);
+  lrgSufficientStatistics first, second;
+  for (size_t i = 0; i < vec.size(); i++)
+  {
+    (i < 300 ? first : second).Add(vec[i].first, vec[i].second);
+  }
+  first.Merge(second);
+
+  REQUIRE(first.GetWeight() == all.GetWeight());
+  REQUIRE(std::abs(first.GetMeanX() - all.GetMeanX()) < 1e-12);
+  REQUIRE(std::abs(first.GetMeanY() - all.GetMeanY()) < 1e-12);
+  REQUIRE(std::abs(first.GetSxx() - all.GetSxx()) < 1e-9);
+  REQUIRE(std::abs(first.GetSxy() - all.GetSxy()) < 1e-9);
+  REQUIRE(std::abs(first.GetSyy() - all.GetSyy()) < 1e-9);
+
+  // Merging into (or from) empty statistics changes nothing.
+  lrgSufficientStatistics empty;
+  empty.Merge(all);
+  REQUIRE(std::abs(empty.GetSxy() - all.GetSxy()) < 1e-12);
+  all.Merge(lrgSufficientStatistics());
+  REQUIRE(std::abs(empty.GetSxy() - all.GetSxy()) < 1e-12);
+}
+
+TEST_CASE("lrgGroupStatisticsTable: grows and merges without losing keys", "[lrgGroupedRegression]")
+{
+  lrgGroupStatisticsTable first(4), second;
+  for (long long key = 0; key < 10000; key++)
+  {
+    first.Get(key * 64).Add(1, key);
+    second.Get(-key * 64).Add(2, key);
+  }
+  REQUIRE(first.GetSize() == 10000);
+  REQUIRE(first.GetEntries().size() >= 2 * first.GetSize());
+  REQUIRE(first.Get(640).GetWeight() == 1);
+  REQUIRE(first.Get(640).GetMeanY() == 10);
+
+  // Key 0 is in both tables, every other key in one of them.
+  first.Merge(second);
+  REQUIRE(first.GetSize() == 19999);
+  REQUIRE(first.Get(0).GetWeight() == 2);
+  REQUIRE(first.Get(0).GetMeanX() == 1.5);
+  REQUIRE(first.Get(-640).GetMeanX() == 2);
+}
+
+TEST_CASE("lrgGroupedRegression: every group matches its own normal equation", "[lrgGroupedRegression]")
+{
+  std::vector<long long> keys;
+  pdd_vector vec;
+  grouped_problem(500, 20, keys, vec);
+
+  std::map<long long, pdd_vector> groups;
+  for (size_t i = 0; i < vec.size(); i++)
+  {
+    groups[keys[i]].push_back(vec[i]);
+  }
+
+  unsigned int threads = 1;
+  lrgGroupedRegression grouped(threads);
+  std::vector<lrgGroupFit> fits = grouped.FitData(keys, vec);
+  REQUIRE(fits.size() == 500);
+
+  lrgNormalEquationSolverStrategy normal;
+  size_t g = 0;
+  for (auto &group : groups)
+  {
+    // Sorted by key.
+    REQUIRE(fits[g].key == group.first);
+    REQUIRE(fits[g].weight == 20);
+    pdd expected = normal.FitData(group.second);
+    REQUIRE(std::abs(fits[g].t0 - expected.first) < 1e-8);
+    REQUIRE(std::abs(fits[g].t1 - expected.second) < 1e-8);
+    g++;
+  }
+
+  // More threads give the same groups and the same fits (up to the order of the additions).
+  threads = 4;
+  grouped.SetThreads(threads);
+  std::vector<lrgGroupFit> parallel_fits = grouped.FitData(keys, vec);
+  REQUIRE(parallel_fits.size() == fits.size());
+  for (size_t k = 0; k < fits.size(); k++)
+  {
+    REQUIRE(parallel_fits[k].key == fits[k].key);
+    REQUIRE(parallel_fits[k].weight == fits[k].weight);
+    REQUIRE(std::abs(parallel_fits[k].t0 - fits[k].t0) < 1e-10);
+    REQUIRE(std::abs(parallel_fits[k].t1 - fits[k].t1) < 1e-10);
+  }
+}
+
+TEST_CASE("lrgGroupedRegression: text input, TestData1.txt", "[lrgGroupedRegression]")
+{
+  pdd_vector vec;
+  auto vec_ptr = std::make_shared<pdd_vector>(vec);
+  std::string filepath = "../../Testing/TestFiles/TestData1.txt";
+  lrgFileLoaderDataCreator data(filepath, std::move(vec_ptr));
+  vec = data.GetData();
+
+  // Two copies of the file under two keys, interleaved, plus a group with a single point.
+  std::ostringstream text;
+  text.precision(17);
+  for (auto &xy : vec)
+  {
+    text << "7 " << xy.first << " " << xy.second << "\n";
+    text << "-2\t" << xy.first << "  " << xy.second << "\r\n";
+  }
+  text << "\n42 1.0 2.0";
+
+  lrgNormalEquationSolverStrategy normal;
+  pdd expected = normal.FitData(vec);
+
+  for (unsigned int threads = 1; threads <= 3; threads++)
+  {
+    lrgGroupedRegression grouped(threads);
+    std::vector<lrgGroupFit> fits = grouped.FitText(text.str());
+    REQUIRE(fits.size() == 3);
+    REQUIRE(fits[0].key == -2);
+    REQUIRE(fits[1].key == 7);
+    REQUIRE(fits[2].key == 42);
+    for (int g = 0; g < 2; g++)
+    {
+      REQUIRE(fits[g].weight == vec.size());
+      REQUIRE(std::abs(fits[g].t0 - expected.first) < 1e-8);
+      REQUIRE(std::abs(fits[g].t1 - expected.second) < 1e-8);
+    }
+
+    // One point has no slope.
+    REQUIRE(fits[2].weight == 1);
+    REQUIRE(std::isnan(fits[2].t1));
+  }
+}
+
+TEST_CASE("lrgGroupedRegression: negative tests", "[lrgGroupedRegression]")
+{
+  unsigned int threads = 0;
+  REQUIRE_THROWS_AS(lrgGroupedRegression(threads), std::invalid_argument);
+
+  lrgGroupedRegression grouped;
+  std::vector<long long> keys = {1, 2};
+  pdd_vector vec = {std::make_pair(1.0, 1.0)};
+  REQUIRE_THROWS_AS(grouped.FitData(keys, vec), std::invalid_argument);
+
+  keys.clear();
+  vec.clear();
+  REQUIRE_THROWS_AS(grouped.FitData(keys, vec), std::length_error);
+  REQUIRE_THROWS_AS(grouped.FitText(""), std::length_error);
+
+  // Missing values, too many values and values that are not numbers.
+  REQUIRE_THROWS_AS(grouped.FitText("1 2.0 3.0\n1 2.0\n"), std::ios_base::failure);
+  REQUIRE_THROWS_AS(grouped.FitText("1 2.0 3.0 4.0\n"), std::ios_base::failure);
+  REQUIRE_THROWS_AS(grouped.FitText("a 2.0 3.0\n"), std::ios_base::failure);
+  REQUIRE_THROWS_AS(grouped.FitText("1 x 3.0\n"), std::ios_base::failure);
+
+  REQUIRE_THROWS_AS(grouped.FitFile("../../Testing/TestFiles/TestData100.txt"), std::ios_base::failure);
+}
@@ -4,6 +4,9 @@
 #include "lrgNormalEquationSolverStrategy.h"
 #include "lrgGradientDescentSolverStrategy.h"
 #include "lrgFileLoaderDataCreator.h"
+#include "lrgWarmStartFitter.h"
+#include "lrgSufficientStatistics.h"
+#include <cmath>
 
 // To check different cases of FitData() (lrgNormalEquationSolverStrategy class) we need to use the same code again and again.
 // So, it is better to create a function
@@ -527,6 +530,509 @@ TEST_CASE("lrgGradientDescentSolverStrategy: negative test, check FitData() empt
 
 }
 
+TEST_CASE("lrgGradientDescentSolverStrategy: update rules converge, size: 100", "[lrgGradientDescentSolverStrategy]")
+{
+  pdd_vector vec;
+  auto vec_ptr = std::make_shared<pdd_vector>(vec);
+
+  double t0 = 4.3;
+  double t1 = 6.7;
+  unsigned int size = 100;
+
+  lrgLinearDataCreator data(t0, t1, size, std::move(vec_ptr));
+  vec = data.GetData();
+
+  double eta = 0.1;
+  unsigned int iterations = 100000;
+  lrgGradientDescentSolverStrategy strategy(eta, iterations);
+
+  // Every rule should end up at the same answer as the normal equation.
+  lrgNormalEquationSolverStrategy normal;
+  pdd expected = normal.FitData(vec);
+
+  lrgUpdateRule rules[] = {lrgUpdateRule::Plain, lrgUpdateRule::Momentum, lrgUpdateRule::Nesterov,
+                           lrgUpdateRule::Adam, lrgUpdateRule::BarzilaiBorwein};
+  for (auto rule : rules)
+  {
+    strategy.SetUpdateRule(rule);
+    strategy.SetTolerance(1e-8);
+    pdd thetas = strategy.FitData(vec);
+    REQUIRE((std::abs(thetas.first - expected.first) < 1e-4 && std::abs(thetas.second - expected.second) < 1e-4));
+    REQUIRE(strategy.GetIterationsRun() < iterations);
+  }
+}
+
+TEST_CASE("lrgGradientDescentSolverStrategy: accelerated rules need fewer iterations on ill-conditioned data", "[lrgGradientDescentSolverStrategy]")
+{
+  pdd_vector vec;
+  auto vec_ptr = std::make_shared<pdd_vector>(vec);
+
+  double t0 = 2;
+  double t1 = 3;
+  unsigned int size = 100;
+
+  lrgLinearDataCreator data(t0, t1, size, std::move(vec_ptr));
+  vec = data.GetData();
+
+  // Move x far away from zero. X^T X becomes badly conditioned.
+  for (auto &item : vec)
+  {
+    item.first += 10;
+    item.second += t1 * 10;
+  }
+
+  double eta = 0.004;
+  unsigned int iterations = 10000000;
+  double tolerance = 1e-6;
+
+  lrgGradientDescentSolverStrategy strategy(eta, iterations);
+  strategy.SetTolerance(tolerance);
+
+  strategy.SetUpdateRule(lrgUpdateRule::Plain);
+  strategy.FitData(vec);
+  unsigned int plain_iterations = strategy.GetIterationsRun();
+
+  strategy.SetUpdateRule(lrgUpdateRule::Momentum);
+  strategy.FitData(vec);
+  REQUIRE(strategy.GetIterationsRun() < plain_iterations);
+
+  strategy.SetUpdateRule(lrgUpdateRule::Nesterov);
+  strategy.FitData(vec);
+  REQUIRE(strategy.GetIterationsRun() < plain_iterations);
+
+  strategy.SetUpdateRule(lrgUpdateRule::BarzilaiBorwein);
+  pdd thetas = strategy.FitData(vec);
+  REQUIRE(strategy.GetIterationsRun() < plain_iterations);
+
+  // The intercept is far away from the data, so we compare with the normal equation instead of t0, t1.
+  lrgNormalEquationSolverStrategy normal;
+  pdd expected = normal.FitData(vec);
+  REQUIRE((std::abs(thetas.first - expected.first) < 1e-2 && std::abs(thetas.second - expected.second) < 1e-3));
+}
+
+TEST_CASE("lrgGradientDescentSolverStrategy: negative test, update rule keywords and momentum", "[lrgGradientDescentSolverStrategy]")
+{
+  REQUIRE(lrgUpdateRuleFromString("nesterov") == lrgUpdateRule::Nesterov);
+  REQUIRE(lrgUpdateRuleFromString("bb") == lrgUpdateRule::BarzilaiBorwein);
+  CHECK_THROWS(lrgUpdateRuleFromString("newton"));
+
+  lrgGradientDescentSolverStrategy strategy;
+  double momentum = 1.0;
+  CHECK_THROWS(strategy.SetMomentum(momentum));
+}
+
+TEST_CASE("lrgGradientDescentSolverStrategy: preconditioning, TestData2.txt", "[lrgGradientDescentSolverStrategy]")
+{
+  pdd_vector vec;
+  auto vec_ptr = std::make_shared<pdd_vector>(vec);
+
+  std::string filepath = "../../Testing/TestFiles/TestData2.txt";
+  lrgFileLoaderDataCreator data(filepath, std::move(vec_ptr));
+  vec = data.GetData();
+
+  lrgNormalEquationSolverStrategy normal;
+  pdd expected = normal.FitData(vec);
+
+  double eta = 0.1;
+  unsigned int iterations = 100000;
+  lrgGradientDescentSolverStrategy strategy(eta, iterations);
+  strategy.SetTolerance(1e-8);
+
+  strategy.FitData(vec);
+  unsigned int plain_iterations = strategy.GetIterationsRun();
+
+  // Both preconditioners must give the same thetas in the original units with fewer iterations.
+  lrgPreconditioner preconditioners[] = {lrgPreconditioner::Standardise, lrgPreconditioner::Jacobi};
+  for (auto preconditioner : preconditioners)
+  {
+    strategy.SetPreconditioner(preconditioner);
+    pdd thetas = strategy.FitData(vec);
+    REQUIRE((std::abs(thetas.first - expected.first) < 1e-6 && std::abs(thetas.second - expected.second) < 1e-6));
+    REQUIRE(strategy.GetIterationsRun() < plain_iterations);
+  }
+
+  // After standardisation X^T X / N is the identity, so eta = 0.5 solves it in one step.
+  eta = 0.5;
+  strategy.SetEta(eta);
+  strategy.SetPreconditioner(lrgPreconditioner::Standardise);
+  pdd thetas = strategy.FitData(vec);
+  REQUIRE(strategy.GetIterationsRun() <= 2);
+  REQUIRE((std::abs(thetas.first - expected.first) < 1e-6 && std::abs(thetas.second - expected.second) < 1e-6));
+}
+
+TEST_CASE("lrgGradientDescentSolverStrategy: automatic step size on ill-conditioned data", "[lrgGradientDescentSolverStrategy]")
+{
+  pdd_vector vec;
+  auto vec_ptr = std::make_shared<pdd_vector>(vec);
+
+  double t0 = 2;
+  double t1 = 3;
+  unsigned int size = 100;
+
+  lrgLinearDataCreator data(t0, t1, size, std::move(vec_ptr));
+  vec = data.GetData();
+
+  for (auto &item : vec)
+  {
+    item.first += 10;
+    item.second += t1 * 10;
+  }
+
+  lrgNormalEquationSolverStrategy normal;
+  pdd expected = normal.FitData(vec);
+
+  // eta = 0.1 is fine for x in [0, 1) but diverges once x sits around 10.
+  double eta = 0.1;
+  unsigned int iterations = 1000;
+  lrgGradientDescentSolverStrategy strategy(eta, iterations);
+  pdd thetas = strategy.FitData(vec);
+  REQUIRE(!(std::abs(thetas.second - expected.second) < 1));
+
+  // The automatic step ignores the given eta and stays stable.
+  iterations = 10000000;
+  strategy.SetIterations(iterations);
+  strategy.SetTolerance(1e-8);
+  strategy.SetStepSize(lrgStepSize::Auto);
+  thetas = strategy.FitData(vec);
+  REQUIRE((std::abs(thetas.first - expected.first) < 1e-4 && std::abs(thetas.second - expected.second) < 1e-5));
+
+  // Combined with standardisation the automatic step solves the problem almost at once.
+  strategy.SetPreconditioner(lrgPreconditioner::Standardise);
+  thetas = strategy.FitData(vec);
+  REQUIRE(strategy.GetIterationsRun() <= 2);
+  REQUIRE((std::abs(thetas.first - expected.first) < 1e-6 && std::abs(thetas.second - expected.second) < 1e-6));
+
+  // The line search starts from the (too large) eta and shrinks it when the loss does not decrease.
+  strategy.SetPreconditioner(lrgPreconditioner::None);
+  strategy.SetStepSize(lrgStepSize::Backtracking);
+  thetas = strategy.FitData(vec);
+  REQUIRE((std::abs(thetas.first - expected.first) < 1e-4 && std::abs(thetas.second - expected.second) < 1e-5));
+}
+
+TEST_CASE("lrgGradientDescentSolverStrategy: negative test, step size modes", "[lrgGradientDescentSolverStrategy]")
+{
+  pdd_vector vec;
+  auto vec_ptr = std::make_shared<pdd_vector>(vec);
+
+  double t0 = 2.1;
+  double t1 = 4.7;
+  unsigned int size = 15;
+
+  lrgLinearDataCreator data(t0, t1, size, std::move(vec_ptr));
+  vec = data.GetData();
+
+  // Without eta the automatic step is allowed, the fixed one is not.
+  double eta = 0;
+  unsigned int iterations = 1000;
+  lrgGradientDescentSolverStrategy strategy(eta, iterations);
+  CHECK_THROWS(strategy.FitData(vec));
+  strategy.SetStepSize(lrgStepSize::Auto);
+  CHECK_NOTHROW(strategy.FitData(vec));
+
+  // Adam has no use for the automatic step and the line search only works with the plain rule.
+  strategy.SetUpdateRule(lrgUpdateRule::Adam);
+  CHECK_THROWS(strategy.FitData(vec));
+  strategy.SetUpdateRule(lrgUpdateRule::Momentum);
+  strategy.SetStepSize(lrgStepSize::Backtracking);
+  CHECK_THROWS(strategy.FitData(vec));
+}
+
+TEST_CASE("lrgGradientDescentSolverStrategy: initial thetas", "[lrgGradientDescentSolverStrategy]")
+{
+  pdd_vector vec;
+  auto vec_ptr = std::make_shared<pdd_vector>(vec);
+
+  std::string filepath = "../../Testing/TestFiles/TestData1.txt";
+  lrgFileLoaderDataCreator data(filepath, std::move(vec_ptr));
+  vec = data.GetData();
+
+  lrgNormalEquationSolverStrategy normal;
+  pdd expected = normal.FitData(vec);
+
+  double eta = 0.1;
+  unsigned int iterations = 100000;
+  lrgGradientDescentSolverStrategy strategy(eta, iterations);
+  strategy.SetTolerance(1e-6);
+  strategy.FitData(vec);
+  REQUIRE(strategy.GetIterationsRun() > 100);
+
+  // Starting at the solution there is nothing left to do, with or without preconditioning.
+  lrgPreconditioner preconditioners[] = {lrgPreconditioner::None, lrgPreconditioner::Standardise, lrgPreconditioner::Jacobi};
+  for (auto preconditioner : preconditioners)
+  {
+    strategy.SetPreconditioner(preconditioner);
+    strategy.SetInitialThetas(expected);
+    pdd thetas = strategy.FitData(vec);
+    REQUIRE(strategy.GetIterationsRun() == 0);
+    REQUIRE((std::abs(thetas.first - expected.first) < 1e-10 && std::abs(thetas.second - expected.second) < 1e-10));
+  }
+
+  // Back to random initial thetas.
+  strategy.SetPreconditioner(lrgPreconditioner::None);
+  strategy.ClearInitialThetas();
+  strategy.FitData(vec);
+  REQUIRE(strategy.GetIterationsRun() > 100);
+}
+
+TEST_CASE("lrgWarmStartFitter: refits on slowly changing data", "[lrgWarmStartFitter]")
+{
+  pdd_vector vec;
+  auto vec_ptr = std::make_shared<pdd_vector>(vec);
+
+  std::string filepath = "../../Testing/TestFiles/TestData1.txt";
+  lrgFileLoaderDataCreator data(filepath, std::move(vec_ptr));
+  vec = data.GetData();
+
+  double eta = 0.1;
+  unsigned int iterations = 100000;
+  auto strategy = std::make_shared<lrgGradientDescentSolverStrategy>(eta, iterations);
+  strategy->SetTolerance(1e-6);
+
+  lrgWarmStartFitter fitter(strategy);
+  REQUIRE(! fitter.HasThetas());
+  fitter.FitData(vec);
+  unsigned int cold_iterations = strategy->GetIterationsRun();
+
+  // The data drifts a little between fits. Every refit starts next to its solution.
+  lrgNormalEquationSolverStrategy normal;
+  for (int step = 0; step < 5; step++)
+  {
+    for (auto &item : vec)
+    {
+      item.second += 0.001 * item.first;
+    }
+    pdd thetas = fitter.FitData(vec);
+    pdd expected = normal.FitData(vec);
+    REQUIRE(strategy->GetIterationsRun() < cold_iterations / 2);
+    REQUIRE((std::abs(thetas.first - expected.first) < 1e-5 && std::abs(thetas.second - expected.second) < 1e-5));
+    REQUIRE(fitter.GetThetas() == thetas);
+  }
+
+  // After a reset the fitter starts from scratch again.
+  fitter.Reset();
+  REQUIRE(! fitter.HasThetas());
+  CHECK_THROWS_AS(fitter.GetThetas(), std::logic_error);
+  fitter.FitData(vec);
+  REQUIRE(strategy->GetIterationsRun() > cold_iterations / 2);
+
+  CHECK_THROWS_AS(lrgWarmStartFitter(nullptr), std::invalid_argument);
+}
+
+TEST_CASE("lrgNormalEquationSolverStrategy: weighted least squares, TestDataWeighted.txt", "[lrgNormalEquationSolverStrategy]")
+{
+  pdd_vector vec;
+  auto vec_ptr = std::make_shared<pdd_vector>(vec);
+  std::string filepath = "../../Testing/TestFiles/TestDataWeighted.txt";
+  lrgFileLoaderDataCreator data(filepath, std::move(vec_ptr));
+  weighted_vector samples = data.GetWeightedData();
+
+  // Reference: the weighted normal equation with raw sums.
+  double sw = 0, swx = 0, swy = 0, swxx = 0, swxy = 0;
+  for (auto &sample : samples)
+  {
+    sw += sample.weight;
+    swx += sample.weight * sample.x;
+    swy += sample.weight * sample.y;
+    swxx += sample.weight * sample.x * sample.x;
+    swxy += sample.weight * sample.x * sample.y;
+  }
+  double expected_t1 = (sw * swxy - swx * swy) / (sw * swxx - swx * swx);
+  double expected_t0 = (swy - expected_t1 * swx) / sw;
+
+  lrgNormalEquationSolverStrategy normal;
+  std::unique_ptr<lrgWeightedLinearModelSolverStrategyI> solver = std::make_unique<lrgNormalEquationSolverStrategy>(normal);
+  pdd thetas = solver->FitData(samples);
+  REQUIRE((std::abs(thetas.first - expected_t0) < 1e-8 && std::abs(thetas.second - expected_t1) < 1e-8));
+
+  // The inverse-variance weights recover the true line (t0 = 2, t1 = 3).
+  REQUIRE((std::abs(thetas.first - 2) < 0.1 && std::abs(thetas.second - 3) < 0.1));
+
+  // Unit weights are ordinary least squares.
+  pdd_vector points;
+  weighted_vector unit;
+  for (auto &sample : samples)
+  {
+    points.push_back(std::make_pair(sample.x, sample.y));
+    unit.push_back({sample.x, sample.y, 1});
+  }
+  pdd expected = normal.FitData(points);
+  thetas = normal.FitData(unit);
+  REQUIRE((std::abs(thetas.first - expected.first) < 1e-8 && std::abs(thetas.second - expected.second) < 1e-8));
+
+  // A weight of 2 is the same as a duplicate and a weight of 0 is the same as leaving the sample out.
+  weighted_vector changed = unit;
+  changed[0].weight = 2;
+  changed[1].weight = 0;
+  pdd_vector copies = points;
+  copies.push_back(points[0]);
+  copies.erase(copies.begin() + 1);
+  expected = normal.FitData(copies);
+  thetas = normal.FitData(changed);
+  REQUIRE((std::abs(thetas.first - expected.first) < 1e-8 && std::abs(thetas.second - expected.second) < 1e-8));
+}
+
+TEST_CASE("lrgGradientDescentSolverStrategy: weighted least squares, TestDataWeighted.txt", "[lrgGradientDescentSolverStrategy]")
+{
+  pdd_vector vec;
+  auto vec_ptr = std::make_shared<pdd_vector>(vec);
+  std::string filepath = "../../Testing/TestFiles/TestDataWeighted.txt";
+  lrgFileLoaderDataCreator data(filepath, std::move(vec_ptr));
+  weighted_vector samples = data.GetWeightedData();
+
+  lrgNormalEquationSolverStrategy normal;
+  pdd expected = normal.FitData(samples);
+
+  double eta = 0.1;
+  unsigned int iterations = 100000;
+  lrgGradientDescentSolverStrategy strategy(eta, iterations);
+  strategy.SetTolerance(1e-9);
+  std::unique_ptr<lrgWeightedLinearModelSolverStrategyI> solver = std::make_unique<lrgGradientDescentSolverStrategy>(strategy);
+  pdd thetas = solver->FitData(samples);
+  REQUIRE((std::abs(thetas.first - expected.first) < 1e-6 && std::abs(thetas.second - expected.second) < 1e-6));
+}
+
+TEST_CASE("lrgNormalEquationSolverStrategy: negative test, weights", "[lrgNormalEquationSolverStrategy]")
+{
+  lrgNormalEquationSolverStrategy normal;
+
+  weighted_vector samples = {{1, 2, 0}, {2, 3, 0}};
+  CHECK_THROWS_AS(normal.FitData(samples), std::length_error);
+
+  samples = {{1, 2, 1}, {2, 3, -1}};
+  CHECK_THROWS_AS(normal.FitData(samples), std::invalid_argument);
+
+  // Only one x-value has a weight.
+  samples = {{1, 2, 1}, {2, 3, 0}, {1, 4, 3}};
+  CHECK_THROWS_AS(normal.FitData(samples), std::logic_error);
+}
+
+TEST_CASE("lrgNormalEquationSolverStrategy: several targets, TestDataMultiTarget.txt", "[lrgNormalEquationSolverStrategy]")
+{
+  pdd_vector vec;
+  std::string filepath = "../../Testing/TestFiles/TestDataMultiTarget.txt";
+  lrgFileLoaderDataCreator data(filepath, std::make_shared<pdd_vector>(vec));
+  std::vector<double> x, targets;
+  size_t target_count = data.GetMultiTargetData(x, targets);
+  REQUIRE(target_count == 2);
+
+  lrgNormalEquationSolverStrategy normal;
+  pdd_vector thetas = normal.FitData(x, targets, target_count);
+  REQUIRE(thetas.size() == 2);
+
+  // The same as fitting every column on its own.
+  for (size_t t = 0; t < target_count; t++)
+  {
+    pdd_vector column;
+    for (size_t i = 0; i < x.size(); i++)
+    {
+      column.push_back(std::make_pair(x[i], targets[i * target_count + t]));
+    }
+    pdd expected = normal.FitData(column);
+    REQUIRE((std::abs(thetas[t].first - expected.first) < 1e-8 && std::abs(thetas[t].second - expected.second) < 1e-8));
+  }
+
+  // The y columns are the ones of TestData1.txt (t0 = 3, t1 = 2) and TestData2.txt (t0 = 2, t1 = 3).
+  REQUIRE((std::abs(thetas[0].first - 3) < 0.1 && std::abs(thetas[0].second - 2) < 0.1));
+  REQUIRE((std::abs(thetas[1].first - 2) < 0.1 && std::abs(thetas[1].second - 3) < 0.1));
+
+  // Exact lines, one of them constant.
+  x = {0, 1, 2, 3};
+  targets = {1, 5, -1,
+             3, 5, -4,
+             5, 5, -7,
+             7, 5, -10};
+  thetas = normal.FitData(x, targets, 3);
+  REQUIRE((std::abs(thetas[0].first - 1) < 1e-12 && std::abs(thetas[0].second - 2) < 1e-12));
+  REQUIRE((std::abs(thetas[1].first - 5) < 1e-12 && std::abs(thetas[1].second) < 1e-12));
+  REQUIRE((std::abs(thetas[2].first + 1) < 1e-12 && std::abs(thetas[2].second + 3) < 1e-12));
+}
+
+TEST_CASE("lrgNormalEquationSolverStrategy: negative test, several targets", "[lrgNormalEquationSolverStrategy]")
+{
+  lrgNormalEquationSolverStrategy normal;
+  std::vector<double> x, targets;
+  CHECK_THROWS_AS(normal.FitData(x, targets, 1), std::length_error);
+
+  x = {1, 2, 3};
+  targets = {1, 2, 3, 4, 5};
+  CHECK_THROWS_AS(normal.FitData(x, targets, 2), std::invalid_argument);
+  CHECK_THROWS_AS(normal.FitData(x, targets, 0), std::invalid_argument);
+
+  x = {1, 1, 1};
+  targets = {1, 2, 3};
+  CHECK_THROWS_AS(normal.FitData(x, targets, 1), std::logic_error);
+
+  // TestData1.txt has only one y column, that is fine. TestDataSparse.txt is not made of numbers.
+  pdd_vector vec;
+  std::string filepath = "../../Testing/TestFiles/TestData1.txt";
+  lrgFileLoaderDataCreator data(filepath, std::make_shared<pdd_vector>(vec));
+  CHECK(data.GetMultiTargetData(x, targets) == 1);
+
+  filepath = "../../Testing/TestFiles/TestDataSparse.txt";
+  lrgFileLoaderDataCreator sparse(filepath, std::make_shared<pdd_vector>(vec));
+  CHECK_THROWS_AS(sparse.GetMultiTargetData(x, targets), std::ios_base::failure);
+
+  filepath = "../../Testing/TestFiles/TestData0.txt";
+  lrgFileLoaderDataCreator empty(filepath, std::make_shared<pdd_vector>(vec));
+  CHECK_THROWS_AS(empty.GetMultiTargetData(x, targets), std::length_error);
+}
+
+TEST_CASE("lrgNormalEquationSolverStrategy: mixed precision, TestData1.txt", "[lrgNormalEquationSolverStrategy]")
+{
+  pdd_vector vec;
+  std::string filepath = "../../Testing/TestFiles/TestData1.txt";
+  lrgFileLoaderDataCreator data(filepath, std::make_shared<pdd_vector>(vec));
+  vec = data.GetData();
+
+  lrgNormalEquationSolverStrategy normal;
+  pdd expected = normal.FitData(vec);
+
+  // The float solution alone is good to about 6 digits, the refinement brings back the rest.
+  unsigned int none = 0;
+  normal.SetPrecision(lrgPrecision::Mixed);
+  normal.SetRefinement(none);
+  pdd rough = normal.FitData(vec);
+  REQUIRE(normal.GetRefinementsRun() == 0);
+  REQUIRE((std::abs(rough.first - expected.first) < 1e-4 && std::abs(rough.second - expected.second) < 1e-4));
+
+  unsigned int steps = 10;
+  normal.SetRefinement(steps);
+  pdd thetas = normal.FitData(vec);
+  REQUIRE(normal.GetRefinementsRun() >= 1);
+  REQUIRE(normal.GetRefinementsRun() <= 4);
+  REQUIRE((std::abs(thetas.first - expected.first) < 1e-12 && std::abs(thetas.second - expected.second) < 1e-12));
+}
+
+TEST_CASE("lrgNormalEquationSolverStrategy: mixed precision far from zero", "[lrgNormalEquationSolverStrategy]")
+{
+  // y = 2 + 3x on x in [0, 1), moved to x in [10000, 10001): X^T X is far too ill-conditioned for float.
+  pdd_vector vec;
+  lrgLinearDataCreator data(2, 3, 10000, std::make_shared<pdd_vector>(vec));
+  vec = data.GetData();
+  for (auto &xy : vec)
+  {
+    xy.first += 10000;
+  }
+  lrgSufficientStatistics stats(vec);
+  double t1 = stats.GetSxy() / stats.GetSxx();
+  double t0 = stats.GetMeanY() - t1 * stats.GetMeanX();
+
+  // Relative to the first point float sees a well-conditioned problem, and the refinement does the rest.
+  lrgNormalEquationSolverStrategy normal;
+  normal.SetPrecision(lrgPrecision::Mixed);
+  pdd thetas = normal.FitData(vec);
+  REQUIRE(std::abs(thetas.second - t1) < 1e-9);
+  REQUIRE(std::abs(thetas.first - t0) < 1e-5);
+
+  // A vertical line has no slope in any precision.
+  pdd_vector vertical;
+  for (int i = 0; i < 20; i++)
+  {
+    vertical.push_back(std::make_pair(10000.5, i));
+  }
+  CHECK_THROWS_AS(normal.FitData(vertical), std::logic_error);
+}
+
 TEST_CASE("lrgFileLoaderDataCreator: check GetData() TestData1.txt", "[lrgFileLoaderDataCreator]")
 {
   pdd_vector vec;
@@ -605,4 +1111,36 @@ TEST_CASE("lrgFileLoaderDataCreator: negative test check GetData() (empty file)"
   // In the case of an empty file, GetData() throws an error.
   CHECK_THROWS(vec = data.GetData());
 
-} 
\ No newline at end of file
+}
+
+TEST_CASE("lrgFileLoaderDataCreator: check GetWeightedData() TestDataWeighted.txt", "[lrgFileLoaderDataCreator]")
+{
+  pdd_vector vec;
+  auto vec_ptr = std::make_shared<pdd_vector>(vec);
+
+  std::string filepath = "../../Testing/TestFiles/TestDataWeighted.txt";
+  lrgFileLoaderDataCreator data(filepath, std::move(vec_ptr));
+  weighted_vector samples = data.GetWeightedData();
+
+  REQUIRE(samples.size() == 1000);
+  REQUIRE((samples.front().x == 0.657401 && samples.front().y == 8.2338 && samples.front().weight == 0.258168));
+  REQUIRE((samples.back().x == 1.26386 && samples.back().y == 4.85394 && samples.back().weight == 0.633882));
+}
+
+TEST_CASE("lrgFileLoaderDataCreator: negative test check GetWeightedData()", "[lrgFileLoaderDataCreator]")
+{
+  pdd_vector vec;
+
+  // TestData1.txt has no weight column.
+  std::string filepath = "../../Testing/TestFiles/TestData1.txt";
+  lrgFileLoaderDataCreator data(filepath, std::make_shared<pdd_vector>(vec));
+  CHECK_THROWS_AS(data.GetWeightedData(), std::ios_base::failure);
+
+  filepath = "../Testing/TestFiles/NOT_EXISTING_FILE.txt";
+  lrgFileLoaderDataCreator missing(filepath, std::make_shared<pdd_vector>(vec));
+  CHECK_THROWS_AS(missing.GetWeightedData(), std::ios_base::failure);
+
+  filepath = "../../Testing/TestFiles/TestData0.txt";
+  lrgFileLoaderDataCreator empty(filepath, std::make_shared<pdd_vector>(vec));
+  CHECK_THROWS_AS(empty.GetWeightedData(), std::length_error);
+}
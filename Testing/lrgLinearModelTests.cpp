@@ -0,0 +1,190 @@
+/*=============================================================================
+
+  PHAS0100ASSIGNMENT1: PHAS0100 Assignment 1 Linear Regression
+
+  Copyright (c) University College London (UCL). All rights reserved.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even
+  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  See LICENSE.txt in the top level directory for details.
+
+=============================================================================*/
+
+#include "catch.hpp"
+#include "lrgCatchMain.h"
+#include "lrgLinearModel.h"
+#include "lrgLogisticRegressionSolverStrategy.h"
+#include "lrgLogisticDataCreator.h"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+static std::vector<double> random_x(size_t count)
+{
+  std::mt19937_64 mt64(3);
+  std::normal_distribution<double> normal(0.0, 5.0);
+  std::vector<double> x(count);
+  for (auto &value : x)
+  {
+    value = normal(mt64);
+  }
+  return x;
+}
+
+TEST_CASE("lrgLinearModel: batch predictions are t0 + t1 x", "[lrgLinearModel]")
+{
+  pdd thetas = std::make_pair(1.5, -0.25);
+  lrgLinearModel model(thetas);
+  REQUIRE(model.Predict(2.0) == 1.0);
+
+  // Sizes around the SIMD width, so the remainder of the vector loop is covered as well.
+  for (size_t count : {0, 1, 3, 7, 8, 9, 1001})
+  {
+    std::vector<double> x = random_x(count);
+    std::vector<double> y(count, -1);
+    model.Predict(x.data(), count, y.data());
+    for (size_t i = 0; i < count; i++)
+    {
+      REQUIRE(y[i] == 1.5 - 0.25 * x[i]);
+    }
+
+    // In place.
+    model.Predict(x.data(), count, x.data());
+    REQUIRE(x == y);
+  }
+
+  // Only count values of the buffer are written.
+  std::vector<double> x = random_x(10);
+  std::vector<double> y(12, 42);
+  model.Predict(x.data(), 10, y.data());
+  REQUIRE(y[10] == 42);
+  REQUIRE(y[11] == 42);
+}
+
+TEST_CASE("lrgLinearModel: the logistic link gives the probabilities of a logistic fit", "[lrgLinearModel]")
+{
+  pdd_vector vec;
+  lrgLogisticDataCreator data(-1, 3, 5000, std::make_shared<pdd_vector>(vec));
+  vec = data.GetData();
+  lrgLogisticRegressionSolverStrategy logistic;
+  pdd thetas = logistic.FitData(vec);
+
+  lrgLinearModel model(thetas, lrgLink::Logistic);
+  REQUIRE(model.GetLink() == lrgLink::Logistic);
+  std::vector<double> x = random_x(3000);
+  x.push_back(1e6);
+  x.push_back(-1e6);
+  std::vector<double> y;
+  model.Predict(x, y);
+  REQUIRE(y.size() == x.size());
+  double loss = 0;
+  for (size_t i = 0; i < x.size(); i++)
+  {
+    double z = thetas.first + thetas.second * x[i];
+    double expected = (z >= 0) ? 1 / (1 + std::exp(-z)) : std::exp(z) / (1 + std::exp(z));
+    REQUIRE(std::abs(y[i] - expected) <= 1e-13 * expected + 1e-300);
+  }
+
+  // The fast exp stops at exp(-708), so the smallest probability is about 3e-308 instead of 0.
+  REQUIRE(y[3000] == 1);
+  REQUIRE(y[3001] < 1e-300);
+
+  // The mean log loss of the probabilities is the loss of the fit.
+  for (auto &xy : vec)
+  {
+    double p = model.Predict(xy.first);
+    loss -= (xy.second > 0) ? std::log(p) : std::log(1 - p);
+  }
+  REQUIRE(std::abs(loss / vec.size() - logistic.GetLoss()) < 1e-10);
+}
+
+TEST_CASE("lrgLinearModel: threads give the same predictions", "[lrgLinearModel]")
+{
+  pdd thetas = std::make_pair(0.3, 0.7);
+  std::vector<double> x = random_x(100003);
+  for (lrgLink link : {lrgLink::Identity, lrgLink::Logistic})
+  {
+    lrgLinearModel single(thetas, link);
+    unsigned int one = 1;
+    single.SetThreads(one);
+    std::vector<double> expected;
+    single.Predict(x, expected);
+
+    lrgLinearModel parallel(thetas, link);
+    unsigned int threads = 4;
+    size_t rows = 1000;
+    parallel.SetThreads(threads);
+    parallel.SetParallelRows(rows);
+    REQUIRE(parallel.GetParallelRows() == 1000);
+    std::vector<double> y;
+    parallel.Predict(x, y);
+    REQUIRE(y == expected);
+  }
+}
+
+TEST_CASE("lrgLinearModel: streaming predictions", "[lrgLinearModel]")
+{
+  pdd thetas = std::make_pair(2.0, 0.5);
+  lrgLinearModel model(thetas);
+
+  // More lines than a block, with y-values after the x-values and a blank line.
+  std::stringstream input, output;
+  input << std::setprecision(17);
+  size_t lines = 2 * lrgLinearModel::BlockRows + 5;
+  for (size_t i = 0; i < lines; i++)
+  {
+    input << i * 0.1 << " " << -double(i) << "\n";
+    if (i == 10)
+    {
+      input << "\n";
+    }
+  }
+  REQUIRE(model.PredictStream(input, output) == lines);
+  double y;
+  size_t i = 0;
+  while (output >> y)
+  {
+    REQUIRE(y == model.Predict(i * 0.1));
+    i++;
+  }
+  REQUIRE(i == lines);
+
+  // A file: every x-value of TestData1.txt.
+  std::string filepath = "../../Testing/TestFiles/TestData1.txt";
+  std::string predictions = "lrgLinearModelTests_predictions.txt";
+  REQUIRE(model.PredictFile(filepath, predictions) == 1000);
+  std::ifstream data(filepath), scored(predictions);
+  double x, ignored;
+  i = 0;
+  while (data >> x >> ignored)
+  {
+    REQUIRE(scored >> y);
+    REQUIRE(y == model.Predict(x));
+    i++;
+  }
+  REQUIRE(i == 1000);
+  REQUIRE(! (scored >> y));
+  std::remove(predictions.c_str());
+}
+
+TEST_CASE("lrgLinearModel: negative tests", "[lrgLinearModel]")
+{
+  lrgLinearModel model;
+  unsigned int zero = 0;
+  size_t no_rows = 0;
+  REQUIRE_THROWS_AS(model.SetThreads(zero), std::invalid_argument);
+  REQUIRE_THROWS_AS(model.SetParallelRows(no_rows), std::invalid_argument);
+  pdd infinite = std::make_pair(1.0, INFINITY);
+  REQUIRE_THROWS_AS(model.SetThetas(infinite), std::logic_error);
+  REQUIRE_THROWS_AS(lrgLinkFromString("probit"), std::invalid_argument);
+  REQUIRE(lrgLinkFromString("logistic") == lrgLink::Logistic);
+
+  std::stringstream text("1.0\nabc\n"), output;
+  REQUIRE_THROWS_AS(model.PredictStream(text, output), std::ios_base::failure);
+  REQUIRE_THROWS_AS(model.PredictFile("../../Testing/TestFiles/TestData100.txt", "unused.txt"), std::ios_base::failure);
+}
@@ -0,0 +1,186 @@
+/*=============================================================================
+
+  PHAS0100ASSIGNMENT1: PHAS0100 Assignment 1 Linear Regression
+
+  Copyright (c) University College London (UCL). All rights reserved.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even
+  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  See LICENSE.txt in the top level directory for details.
+
+=============================================================================*/
+
+#include "catch.hpp"
+#include "lrgCatchMain.h"
+#include "lrgLogisticRegressionSolverStrategy.h"
+#include "lrgLogisticDataCreator.h"
+#include <cmath>
+#include <random>
+
+// A sparse data set with an intercept column and features features, 5 non-zeros per sample, and labels drawn
+// from the logistic model with thetas (0.5, 1, -1, 1, -1, ...) / 2.
+static lrgSparseDataset sparse_data(int samples, int features)
+{
+  std::mt19937_64 mt64(7);
+  std::uniform_int_distribution<int> column(1, features);
+  std::normal_distribution<double> value(0.0, 1.0);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+  std::vector<Eigen::Triplet<double>> triplets;
+  lrgSparseDataset data;
+  data.y.resize(samples);
+  for (int i = 0; i < samples; i++)
+  {
+    triplets.push_back(Eigen::Triplet<double>(i, 0, 1));
+    double margin = 0.25;
+    std::vector<int> used;
+    while (used.size() < 5)
+    {
+      int j = column(mt64);
+      if (std::find(used.begin(), used.end(), j) == used.end())
+      {
+        used.push_back(j);
+        double v = value(mt64);
+        triplets.push_back(Eigen::Triplet<double>(i, j, v));
+        margin += ((j % 2) ? 0.5 : -0.5) * v;
+      }
+    }
+    data.y(i) = (uniform(mt64) < 1 / (1 + std::exp(-margin))) ? 1 : -1;
+  }
+  data.X.resize(samples, features + 1);
+  data.X.setFromTriplets(triplets.begin(), triplets.end());
+  return data;
+}
+
+TEST_CASE("lrgLogisticRegressionSolverStrategy: the fast exp and log-sigmoid", "[lrgLogisticRegressionSolverStrategy]")
+{
+  double worst = 0;
+  for (double x = -700; x <= 700; x += 0.0137)
+  {
+    worst = std::max(worst, std::abs(lrgFastExp(x) / std::exp(x) - 1));
+  }
+  REQUIRE(worst < 1e-13);
+  REQUIRE(lrgFastExp(0) == 1);
+
+  const double margins[] = {-800, -40, -5, -0.3, 0, 0.3, 5, 40, 800};
+  for (double z : margins)
+  {
+    double expected = (z > 0) ? -std::log1p(std::exp(-z)) : z - std::log1p(std::exp(z));
+    REQUIRE(std::isfinite(lrgLogSigmoid(z)));
+    REQUIRE(std::abs(lrgLogSigmoid(z) - expected) <= 1e-13 * (1 + std::abs(expected)));
+  }
+
+  // The kernel against the textbook formulas.
+  std::vector<double> z = {-3, -0.5, 0, 0.5, 3, 20}, labels = {0, 1, 1, 0, 1, 0};
+  std::vector<double> residuals(6), weights(6);
+  double loss = lrgLogisticKernel(z.data(), labels.data(), 6, residuals.data(), weights.data());
+  double expected_loss = 0;
+  for (int i = 0; i < 6; i++)
+  {
+    double probability = 1 / (1 + std::exp(-z[i]));
+    REQUIRE(std::abs(residuals[i] - (probability - labels[i])) < 1e-15);
+    REQUIRE(std::abs(weights[i] - probability * (1 - probability)) < 1e-15);
+    expected_loss += std::max(z[i], 0.0) + std::log1p(std::exp(-std::abs(z[i]))) - labels[i] * z[i];
+  }
+  REQUIRE(std::abs(loss - expected_loss) < 1e-12);
+}
+
+TEST_CASE("lrgLogisticRegressionSolverStrategy: Newton and L-BFGS on one feature", "[lrgLogisticRegressionSolverStrategy]")
+{
+  pdd_vector vec;
+  lrgLogisticDataCreator data(-2, 4, 20000, std::make_shared<pdd_vector>(vec));
+  vec = data.GetData();
+
+  lrgLogisticRegressionSolverStrategy newton;
+  pdd thetas = newton.FitData(vec);
+  REQUIRE(std::abs(thetas.first + 2) < 0.15);
+  REQUIRE(std::abs(thetas.second - 4) < 0.3);
+  REQUIRE(newton.GetIterationsRun() <= 10);
+
+  lrgLogisticRegressionSolverStrategy lbfgs;
+  lbfgs.SetMethod(lrgLogisticMethod::LBFGS);
+  pdd other = lbfgs.FitData(vec);
+  REQUIRE(std::abs(other.first - thetas.first) < 1e-6);
+  REQUIRE(std::abs(other.second - thetas.second) < 1e-6);
+  REQUIRE(std::abs(lbfgs.GetLoss() - newton.GetLoss()) < 1e-12);
+
+  // A penalty pulls the slope towards zero, but not the intercept.
+  double lambda = 0.1;
+  lrgLogisticRegressionSolverStrategy ridge(lambda);
+  pdd shrunk = ridge.FitData(vec);
+  REQUIRE(std::abs(shrunk.second) < std::abs(thetas.second));
+}
+
+TEST_CASE("lrgLogisticRegressionSolverStrategy: many sparse features", "[lrgLogisticRegressionSolverStrategy]")
+{
+  lrgSparseDataset data = sparse_data(3000, 200);
+  double lambda = 1e-3;
+
+  // 201 columns: Auto takes L-BFGS.
+  lrgLogisticRegressionSolverStrategy lbfgs(lambda);
+  Eigen::VectorXd thetas = lbfgs.FitData(data);
+  REQUIRE(thetas.size() == 201);
+  REQUIRE(lbfgs.GetIterationsRun() > 10);
+
+  lrgLogisticRegressionSolverStrategy newton(lambda);
+  newton.SetMethod(lrgLogisticMethod::Newton);
+  Eigen::VectorXd expected = newton.FitData(data);
+  REQUIRE(newton.GetIterationsRun() < lbfgs.GetIterationsRun());
+  REQUIRE((thetas - expected).lpNorm<Eigen::Infinity>() < 1e-5);
+  REQUIRE(std::abs(lbfgs.GetLoss() - newton.GetLoss()) < 1e-10);
+
+  // The odd features push the log odds up and the even ones down.
+  int right = 0;
+  for (int j = 1; j <= 200; j++)
+  {
+    right += ((j % 2) ? thetas(j) > 0 : thetas(j) < 0);
+  }
+  REQUIRE(right > 150);
+}
+
+TEST_CASE("lrgLogisticRegressionSolverStrategy: separable data", "[lrgLogisticRegressionSolverStrategy]")
+{
+  pdd_vector vec;
+  for (int i = 0; i < 100; i++)
+  {
+    vec.push_back(std::make_pair(i * 0.01, (i < 50) ? 0 : 1));
+  }
+
+  // Without a penalty the thetas grow until the loss is flat, but stay finite.
+  lrgLogisticRegressionSolverStrategy plain;
+  pdd thetas = plain.FitData(vec);
+  REQUIRE(std::isfinite(thetas.first));
+  REQUIRE(thetas.second > 100);
+  REQUIRE(plain.GetLoss() < 1e-4);
+
+  // The boundary sits between the classes.
+  double lambda = 0.01;
+  lrgLogisticRegressionSolverStrategy ridge(lambda);
+  pdd shrunk = ridge.FitData(vec);
+  REQUIRE(std::abs(-shrunk.first / shrunk.second - 0.495) < 0.01);
+}
+
+TEST_CASE("lrgLogisticRegressionSolverStrategy: negative tests", "[lrgLogisticRegressionSolverStrategy]")
+{
+  lrgLogisticRegressionSolverStrategy logistic;
+  double negative = -1;
+  unsigned int zero = 0;
+  REQUIRE_THROWS_AS(lrgLogisticRegressionSolverStrategy(negative), std::invalid_argument);
+  REQUIRE_THROWS_AS(logistic.SetLambda(negative), std::invalid_argument);
+  REQUIRE_THROWS_AS(logistic.SetTolerance(-1), std::invalid_argument);
+  REQUIRE_THROWS_AS(logistic.SetMemory(zero), std::invalid_argument);
+  REQUIRE_THROWS_AS(lrgLogisticMethodFromString("gradient"), std::invalid_argument);
+  REQUIRE(lrgLogisticMethodFromString("lbfgs") == lrgLogisticMethod::LBFGS);
+
+  pdd_vector empty;
+  REQUIRE_THROWS_AS(logistic.FitData(empty), std::length_error);
+
+  // Regression data are not labels.
+  pdd_vector continuous = {{0.1, 0.5}, {0.2, 1.0}, {0.3, 0.0}};
+  REQUIRE_THROWS_AS(logistic.FitData(continuous), std::invalid_argument);
+
+  lrgLogisticDataCreator unset;
+  REQUIRE_THROWS_AS(unset.GetData(), std::invalid_argument);
+}
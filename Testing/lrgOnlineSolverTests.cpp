@@ -0,0 +1,289 @@
+/*=============================================================================
+
+  PHAS0100ASSIGNMENT1: PHAS0100 Assignment 1 Linear Regression
+
+  Copyright (c) University College London (UCL). All rights reserved.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even
+  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  See LICENSE.txt in the top level directory for details.
+
+=============================================================================*/
+
+#include "catch.hpp"
+#include "lrgCatchMain.h"
+#include "lrgNormalEquationSolverStrategy.h"
+#include "lrgRecursiveLeastSquares.h"
+#include "lrgSlidingWindowRegression.h"
+#include "lrgFileLoaderDataCreator.h"
+#include <cmath>
+#include <random>
+
+static pdd_vector load_test_file(std::string filepath)
+{
+  pdd_vector vec;
+  auto vec_ptr = std::make_shared<pdd_vector>(vec);
+  lrgFileLoaderDataCreator data(filepath, std::move(vec_ptr));
+  return data.GetData();
+}
+
+// Weighted least squares with two passes, as a reference.
+static pdd weighted_fit(const pdd_vector &vec, const std::vector<double> &weights)
+{
+  double weight = 0, mean_x = 0, mean_y = 0;
+  for (size_t i = 0; i < vec.size(); i++)
+  {
+    weight += weights[i];
+    mean_x += weights[i] * vec[i].first;
+    mean_y += weights[i] * vec[i].second;
+  }
+  mean_x /= weight;
+  mean_y /= weight;
+
+  double sxx = 0, sxy = 0;
+  for (size_t i = 0; i < vec.size(); i++)
+  {
+    sxx += weights[i] * (vec[i].first - mean_x) * (vec[i].first - mean_x);
+    sxy += weights[i] * (vec[i].first - mean_x) * (vec[i].second - mean_y);
+  }
+  double t1 = sxy / sxx;
+  return std::make_pair(mean_y - t1 * mean_x, t1);
+}
+
+TEST_CASE("lrgRecursiveLeastSquares: matches the normal equation after every update, TestData1.txt", "[lrgRecursiveLeastSquares]")
+{
+  pdd_vector vec = load_test_file("../../Testing/TestFiles/TestData1.txt");
+
+  lrgNormalEquationSolverStrategy normal;
+  lrgRecursiveLeastSquares rls;
+
+  pdd_vector history;
+  for (size_t i = 0; i < 50; i++)
+  {
+    rls.Update(vec[i].first, vec[i].second);
+    history.push_back(vec[i]);
+    if (i > 0)
+    {
+      pdd expected = normal.FitData(history);
+      pdd thetas = rls.GetThetas();
+      REQUIRE((std::abs(thetas.first - expected.first) < 1e-8 && std::abs(thetas.second - expected.second) < 1e-8));
+    }
+  }
+  REQUIRE(rls.GetWeight() == 50);
+
+  // FitData() starts from an empty stream.
+  std::unique_ptr<lrgLinearModelSolverStrategyI> solver = std::make_unique<lrgRecursiveLeastSquares>(rls);
+  pdd thetas = solver->FitData(vec);
+  pdd expected = normal.FitData(vec);
+  REQUIRE((std::abs(thetas.first - expected.first) < 1e-8 && std::abs(thetas.second - expected.second) < 1e-8));
+}
+
+TEST_CASE("lrgRecursiveLeastSquares: forgetting factor", "[lrgRecursiveLeastSquares]")
+{
+  pdd_vector vec = load_test_file("../../Testing/TestFiles/TestData2.txt");
+
+  // Point i has weight f^(N - 1 - i).
+  double forgetting_factor = 0.99;
+  lrgRecursiveLeastSquares rls(forgetting_factor);
+  pdd thetas = rls.FitData(vec);
+
+  std::vector<double> weights(vec.size());
+  for (size_t i = 0; i < vec.size(); i++)
+  {
+    weights[i] = std::pow(forgetting_factor, double(vec.size() - 1 - i));
+  }
+  pdd expected = weighted_fit(vec, weights);
+  REQUIRE((std::abs(thetas.first - expected.first) < 1e-8 && std::abs(thetas.second - expected.second) < 1e-8));
+
+  // The effective number of points is bounded by 1 / (1 - f).
+  REQUIRE(rls.GetWeight() < 1 / (1 - forgetting_factor) + 1e-8);
+
+  // The slope changes from 2 to -1 half way through. Without forgetting the fit ends up in between,
+  // with forgetting it follows the new slope.
+  std::mt19937_64 mt64;
+  std::uniform_real_distribution<double> distribution(0.0, 1.0);
+  lrgRecursiveLeastSquares memory;
+  rls.Reset();
+  for (int i = 0; i < 2000; i++)
+  {
+    double x = distribution(mt64);
+    double y = (i < 1000) ? 1 + 2 * x : 1 - x;
+    rls.Update(x, y);
+    memory.Update(x, y);
+  }
+  REQUIRE(std::abs(rls.GetThetas().second + 1) < 1e-3);
+  REQUIRE(std::abs(memory.GetThetas().second - 0.5) < 0.2);
+}
+
+TEST_CASE("lrgRecursiveLeastSquares: weighted updates", "[lrgRecursiveLeastSquares]")
+{
+  pdd_vector vec = load_test_file("../../Testing/TestFiles/TestData1.txt");
+
+  // Every third point counts three times.
+  std::vector<double> weights(vec.size());
+  lrgRecursiveLeastSquares rls;
+  for (size_t i = 0; i < vec.size(); i++)
+  {
+    weights[i] = (i % 3 == 0) ? 3 : 1;
+    rls.Update(vec[i].first, vec[i].second, weights[i]);
+  }
+  pdd expected = weighted_fit(vec, weights);
+  pdd thetas = rls.GetThetas();
+  REQUIRE((std::abs(thetas.first - expected.first) < 1e-8 && std::abs(thetas.second - expected.second) < 1e-8));
+
+  REQUIRE_THROWS_AS(rls.Update(1, 2, -1), std::invalid_argument);
+}
+
+TEST_CASE("lrgRecursiveLeastSquares: negative tests", "[lrgRecursiveLeastSquares]")
+{
+  double forgetting_factor = 0;
+  REQUIRE_THROWS_AS(lrgRecursiveLeastSquares(forgetting_factor), std::invalid_argument);
+  forgetting_factor = 1.01;
+  REQUIRE_THROWS_AS(lrgRecursiveLeastSquares(forgetting_factor), std::invalid_argument);
+
+  lrgRecursiveLeastSquares rls;
+  REQUIRE_THROWS_AS(rls.GetThetas(), std::logic_error);
+  rls.Update(1, 2);
+  rls.Update(1, 3);
+  REQUIRE_THROWS_AS(rls.GetThetas(), std::logic_error);
+
+  pdd_vector empty;
+  REQUIRE_THROWS_AS(rls.FitData(empty), std::length_error);
+}
+
+TEST_CASE("lrgSlidingWindowRegression: every window matches the normal equation, TestData1.txt", "[lrgSlidingWindowRegression]")
+{
+  pdd_vector vec = load_test_file("../../Testing/TestFiles/TestData1.txt");
+
+  unsigned int window = 20;
+  lrgSlidingWindowRegression sliding(window);
+  pdd_vector thetas = sliding.FitWindows(vec);
+  REQUIRE(thetas.size() == vec.size() - window + 1);
+
+  lrgNormalEquationSolverStrategy normal;
+  for (size_t k = 0; k < thetas.size(); k++)
+  {
+    pdd_vector points(vec.begin() + k, vec.begin() + k + window);
+    pdd expected = normal.FitData(points);
+    REQUIRE((std::abs(thetas[k].first - expected.first) < 1e-8 && std::abs(thetas[k].second - expected.second) < 1e-8));
+  }
+
+  // Point by point gives the same, the window fills up first.
+  sliding.Reset();
+  for (size_t i = 0; i < vec.size(); i++)
+  {
+    sliding.Add(vec[i].first, vec[i].second);
+    REQUIRE(sliding.GetSize() == std::min<size_t>(i + 1, window));
+    if (sliding.IsFull())
+    {
+      pdd current = sliding.GetThetas();
+      REQUIRE(current == thetas[i + 1 - window]);
+    }
+  }
+}
+
+TEST_CASE("lrgSlidingWindowRegression: re-anchoring keeps a long series accurate", "[lrgSlidingWindowRegression]")
+{
+  // A million points far from zero with a large intercept, the hard case for downdating.
+  std::mt19937_64 mt64;
+  std::uniform_real_distribution<double> distribution(0.0, 1.0);
+  std::normal_distribution<double> noise(0.0, 1.0);
+  pdd_vector vec;
+  for (int i = 0; i < 1000000; i++)
+  {
+    double x = 1e4 + distribution(mt64);
+    vec.push_back(std::make_pair(x, 1e6 + 3 * x + noise(mt64)));
+  }
+
+  unsigned int window = 50;
+  lrgSlidingWindowRegression sliding(window);
+  pdd_vector thetas = sliding.FitWindows(vec);
+
+  // Check some windows against a fresh fit.
+  lrgRecursiveLeastSquares fresh;
+  for (size_t k = 0; k < thetas.size(); k += 99991)
+  {
+    pdd_vector points(vec.begin() + k, vec.begin() + k + window);
+    pdd expected = fresh.FitData(points);
+    REQUIRE(std::abs(thetas[k].second - expected.second) < 1e-6 * std::abs(expected.second));
+  }
+  pdd_vector points(vec.end() - window, vec.end());
+  pdd expected = fresh.FitData(points);
+  REQUIRE(std::abs(thetas.back().second - expected.second) < 1e-6 * std::abs(expected.second));
+}
+
+TEST_CASE("lrgSlidingWindowRegression: re-anchoring follows a larger window", "[lrgSlidingWindowRegression]")
+{
+  std::mt19937_64 mt64;
+  std::uniform_real_distribution<double> distribution(0.0, 1.0);
+  std::normal_distribution<double> noise(0.0, 1.0);
+  pdd_vector vec;
+  for (int i = 0; i < 200000; i++)
+  {
+    double x = 1e4 + distribution(mt64);
+    vec.push_back(std::make_pair(x, 1e6 + 3 * x + noise(mt64)));
+  }
+
+  unsigned int window = 5;
+  lrgSlidingWindowRegression sliding(window);
+  window = 500;
+  sliding.SetWindow(window);
+  for (auto &item : vec)
+  {
+    sliding.Add(item.first, item.second);
+  }
+  REQUIRE(sliding.GetSize() == 500);
+
+  lrgRecursiveLeastSquares fresh;
+  pdd_vector points(vec.end() - window, vec.end());
+  pdd expected = fresh.FitData(points);
+  pdd thetas = sliding.GetThetas();
+  REQUIRE(std::abs(thetas.second - expected.second) < 1e-6 * std::abs(expected.second));
+}
+
+TEST_CASE("lrgSlidingWindowRegression: weighted points", "[lrgSlidingWindowRegression]")
+{
+  pdd_vector vec = load_test_file("../../Testing/TestFiles/TestData2.txt");
+
+  std::vector<double> weights(vec.size());
+  for (size_t i = 0; i < vec.size(); i++)
+  {
+    weights[i] = 0.5 + (i % 7);
+  }
+
+  unsigned int window = 30;
+  lrgSlidingWindowRegression sliding(window);
+  for (size_t i = 0; i < vec.size(); i++)
+  {
+    sliding.Add(vec[i].first, vec[i].second, weights[i]);
+    if (sliding.IsFull() && i % 50 == 0)
+    {
+      pdd_vector points(vec.begin() + i + 1 - window, vec.begin() + i + 1);
+      std::vector<double> window_weights(weights.begin() + i + 1 - window, weights.begin() + i + 1);
+      pdd expected = weighted_fit(points, window_weights);
+      pdd thetas = sliding.GetThetas();
+      REQUIRE((std::abs(thetas.first - expected.first) < 1e-8 && std::abs(thetas.second - expected.second) < 1e-8));
+    }
+  }
+}
+
+TEST_CASE("lrgSlidingWindowRegression: negative tests", "[lrgSlidingWindowRegression]")
+{
+  unsigned int window = 1;
+  REQUIRE_THROWS_AS(lrgSlidingWindowRegression(window), std::invalid_argument);
+
+  window = 5;
+  lrgSlidingWindowRegression sliding(window);
+  REQUIRE_THROWS_AS(sliding.GetThetas(), std::logic_error);
+
+  pdd_vector short_vec = {{1, 2}, {2, 3}, {3, 4}};
+  REQUIRE_THROWS_AS(sliding.FitWindows(short_vec), std::length_error);
+
+  for (int i = 0; i < 10; i++)
+  {
+    sliding.Add(1, i);
+  }
+  REQUIRE_THROWS_AS(sliding.GetThetas(), std::logic_error);
+}
@@ -0,0 +1,155 @@
+/*=============================================================================
+
+  PHAS0100ASSIGNMENT1: PHAS0100 Assignment 1 Linear Regression
+
+  Copyright (c) University College London (UCL). All rights reserved.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even
+  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  See LICENSE.txt in the top level directory for details.
+
+=============================================================================*/
+
+#include "catch.hpp"
+#include "lrgCatchMain.h"
+#include "lrgRansacSolverStrategy.h"
+#include "lrgSufficientStatistics.h"
+#include <cmath>
+#include <random>
+
+// y = 2 + 3x + N(0, 0.5) for x in [0, 10), with a fraction of the points replaced by uniform noise
+// over the whole range of y (about 35 noise units either side of the line).
+static pdd_vector scattered_data(unsigned int size, double fraction)
+{
+  std::mt19937_64 mt64(7);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  std::normal_distribution<double> noise(0.0, 0.5);
+  pdd_vector vec;
+  for (unsigned int i = 0; i < size; i++)
+  {
+    double x = 10 * uniform(mt64);
+    double y = 2 + 3 * x + noise(mt64);
+    if (uniform(mt64) < fraction)
+    {
+      y = -2 + 36 * uniform(mt64);
+    }
+    vec.push_back(std::make_pair(x, y));
+  }
+  return vec;
+}
+
+TEST_CASE("lrgRansacSolverStrategy: most of the points are outliers", "[lrgRansacSolverStrategy]")
+{
+  pdd_vector vec = scattered_data(20000, 0.6);
+
+  lrgSufficientStatistics stats(vec);
+  REQUIRE(std::abs(stats.GetSxy() / stats.GetSxx() - 3) > 0.5);
+
+  lrgRansacSolverStrategy strategy;
+  std::unique_ptr<lrgLinearModelSolverStrategyI> solver = std::make_unique<lrgRansacSolverStrategy>(strategy);
+  pdd thetas = solver->FitData(vec);
+  REQUIRE(std::abs(thetas.first - 2) < 0.1);
+  REQUIRE(std::abs(thetas.second - 3) < 0.02);
+}
+
+TEST_CASE("lrgRansacSolverStrategy: threshold, inliers and the adaptive stop", "[lrgRansacSolverStrategy]")
+{
+  pdd_vector vec = scattered_data(20000, 0.3);
+
+  // 3 noise units: 99.7% of the 70% inliers, plus the outliers that fall near the line by chance.
+  double threshold = 1.5;
+  lrgRansacSolverStrategy strategy(threshold);
+  pdd thetas = strategy.FitData(vec);
+  REQUIRE(strategy.GetThreshold() == 1.5);
+  REQUIRE(std::abs(thetas.second - 3) < 0.01);
+  REQUIRE((strategy.GetInliers() > 0.69 * 20000 && strategy.GetInliers() < 0.76 * 20000));
+
+  // With 70% inliers, 99% confidence needs log(0.01) / log(1 - 0.7^2) = 7 hypotheses (one block of 8),
+  // 99.9999% needs 21 (three blocks).
+  REQUIRE(strategy.GetHypotheses() == 8);
+  double confidence = 0.999999;
+  strategy.SetConfidence(confidence);
+  strategy.FitData(vec);
+  REQUIRE(strategy.GetHypotheses() == 24);
+
+  // More outliers need more hypotheses, up to the maximum.
+  pdd_vector noisy = scattered_data(20000, 0.9);
+  unsigned long hypotheses = 40;
+  strategy.SetMaxHypotheses(hypotheses);
+  strategy.FitData(noisy);
+  REQUIRE(strategy.GetHypotheses() == 40);
+
+  // The automatic threshold is a few noise units.
+  lrgRansacSolverStrategy automatic;
+  automatic.FitData(vec);
+  REQUIRE((automatic.GetThreshold() > 1 && automatic.GetThreshold() < 2.5));
+}
+
+TEST_CASE("lrgRansacSolverStrategy: the same result on any number of threads", "[lrgRansacSolverStrategy]")
+{
+  pdd_vector vec = scattered_data(10000, 0.7);
+
+  unsigned int threads = 1;
+  lrgRansacSolverStrategy single;
+  single.SetThreads(threads);
+  pdd expected = single.FitData(vec);
+
+  for (threads = 2; threads <= 5; threads++)
+  {
+    lrgRansacSolverStrategy parallel;
+    parallel.SetThreads(threads);
+    pdd thetas = parallel.FitData(vec);
+    REQUIRE(thetas.first == expected.first);
+    REQUIRE(thetas.second == expected.second);
+    REQUIRE(parallel.GetHypotheses() == single.GetHypotheses());
+  }
+
+  // Another seed draws other hypotheses but finds the same line.
+  lrgRansacSolverStrategy reseeded;
+  reseeded.SetSeed(2024);
+  pdd thetas = reseeded.FitData(vec);
+  REQUIRE(std::abs(thetas.second - expected.second) < 0.05);
+}
+
+TEST_CASE("lrgRansacSolverStrategy: points on a line and repeated x", "[lrgRansacSolverStrategy]")
+{
+  // 1500 points on y = 1 + 2x (at only 10 different x), 1000 far away. The refit on the inliers is exact.
+  pdd_vector vec;
+  for (int i = 0; i < 1500; i++)
+  {
+    vec.push_back(std::make_pair(i % 10, 1 + 2 * (i % 10)));
+  }
+  for (int i = 0; i < 1000; i++)
+  {
+    vec.push_back(std::make_pair(i % 7, 100 + 37 * (i % 3)));
+  }
+  lrgRansacSolverStrategy strategy;
+  pdd thetas = strategy.FitData(vec);
+  REQUIRE(std::abs(thetas.first - 1) < 1e-10);
+  REQUIRE(std::abs(thetas.second - 2) < 1e-10);
+  REQUIRE(strategy.GetInliers() == 1500);
+}
+
+TEST_CASE("lrgRansacSolverStrategy: negative tests", "[lrgRansacSolverStrategy]")
+{
+  lrgRansacSolverStrategy strategy;
+  pdd_vector empty;
+  REQUIRE_THROWS_AS(strategy.FitData(empty), std::length_error);
+
+  pdd_vector vertical = {{1, 1}, {1, 2}, {1, 3}};
+  REQUIRE_THROWS_AS(strategy.FitData(vertical), std::logic_error);
+  double threshold = 1;
+  lrgRansacSolverStrategy fixed(threshold);
+  REQUIRE_THROWS_AS(fixed.FitData(vertical), std::logic_error);
+
+  threshold = 0;
+  REQUIRE_THROWS_AS(lrgRansacSolverStrategy(threshold), std::invalid_argument);
+  double confidence = 1;
+  REQUIRE_THROWS_AS(strategy.SetConfidence(confidence), std::invalid_argument);
+  unsigned long hypotheses = 0;
+  REQUIRE_THROWS_AS(strategy.SetMaxHypotheses(hypotheses), std::invalid_argument);
+  unsigned int threads = 0;
+  REQUIRE_THROWS_AS(strategy.SetThreads(threads), std::invalid_argument);
+}
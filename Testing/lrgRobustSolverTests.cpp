@@ -0,0 +1,146 @@
+/*=============================================================================
+
+  PHAS0100ASSIGNMENT1: PHAS0100 Assignment 1 Linear Regression
+
+  Copyright (c) University College London (UCL). All rights reserved.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even
+  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  See LICENSE.txt in the top level directory for details.
+
+=============================================================================*/
+
+#include "catch.hpp"
+#include "lrgCatchMain.h"
+#include "lrgTestData.h"
+#include "lrgNormalEquationSolverStrategy.h"
+#include "lrgRobustSolverStrategy.h"
+#include "lrgLinearDataCreator.h"
+#include "lrgFileLoaderDataCreator.h"
+#include <cmath>
+
+TEST_CASE("lrgLinearDataCreator: contamination only moves the outliers", "[lrgRobustSolverStrategy]")
+{
+  pdd_vector clean = contaminated_data(1000, 0);
+  pdd_vector dirty = contaminated_data(1000, 0.2);
+  REQUIRE(dirty.size() == clean.size());
+
+  int outliers = 0;
+  for (size_t i = 0; i < clean.size(); i++)
+  {
+    REQUIRE(dirty[i].first == clean[i].first);
+    if (dirty[i].second != clean[i].second)
+    {
+      REQUIRE(dirty[i].second - clean[i].second >= 20);
+      outliers++;
+    }
+  }
+  REQUIRE((outliers > 150 && outliers < 250));
+
+  pdd_vector vec;
+  lrgLinearDataCreator data(2, 3, 10, std::make_shared<pdd_vector>(vec));
+  REQUIRE_THROWS_AS(data.SetContamination(1.5, 1), std::invalid_argument);
+}
+
+TEST_CASE("lrgRobustSolverStrategy: clean data is close to least squares, TestData1.txt", "[lrgRobustSolverStrategy]")
+{
+  pdd_vector vec;
+  auto vec_ptr = std::make_shared<pdd_vector>(vec);
+  std::string filepath = "../../Testing/TestFiles/TestData1.txt";
+  lrgFileLoaderDataCreator data(filepath, std::move(vec_ptr));
+  vec = data.GetData();
+
+  lrgNormalEquationSolverStrategy normal;
+  pdd expected = normal.FitData(vec);
+
+  std::unique_ptr<lrgLinearModelSolverStrategyI> solver = std::make_unique<lrgRobustSolverStrategy>();
+  pdd thetas = solver->FitData(vec);
+  REQUIRE((std::abs(thetas.first - expected.first) < 0.05 && std::abs(thetas.second - expected.second) < 0.05));
+
+  // A huge tuning constant gives every point a weight of 1: least squares after one iteration.
+  double tuning = 1e6;
+  lrgRobustSolverStrategy huber(lrgRobustLoss::Huber, tuning);
+  thetas = huber.FitData(vec);
+  REQUIRE((std::abs(thetas.first - expected.first) < 1e-10 && std::abs(thetas.second - expected.second) < 1e-10));
+  REQUIRE(huber.GetIterationsRun() == 1);
+}
+
+TEST_CASE("lrgRobustSolverStrategy: converges on contaminated data", "[lrgRobustSolverStrategy]")
+{
+  pdd_vector vec = contaminated_data(20000, 0.15);
+
+  // The outliers pull least squares far away from t0 = 2.
+  lrgNormalEquationSolverStrategy normal;
+  pdd ols = normal.FitData(vec);
+  REQUIRE(ols.first > 5);
+
+  lrgRobustSolverStrategy huber(lrgRobustLoss::Huber);
+  pdd huber_thetas = huber.FitData(vec);
+  REQUIRE(huber.GetIterationsRun() < 100);
+  REQUIRE((std::abs(huber_thetas.first - 2) < 1 && std::abs(huber_thetas.second - 3) < 0.2));
+
+  lrgRobustSolverStrategy tukey(lrgRobustLoss::Tukey);
+  pdd tukey_thetas = tukey.FitData(vec);
+  REQUIRE(tukey.GetIterationsRun() < 200);
+  REQUIRE((std::abs(tukey_thetas.first - 2) < 0.1 && std::abs(tukey_thetas.second - 3) < 0.15));
+  REQUIRE(std::abs(tukey_thetas.first - 2) < std::abs(huber_thetas.first - 2));
+
+  // The scale is close to the one of the clean noise (the outliers still push the median up a little)
+  // and Tukey gives the outliers no weight at all.
+  REQUIRE(std::abs(tukey.GetScale() - 1) < 0.3);
+  pdd_vector clean = contaminated_data(20000, 0);
+  for (size_t i = 0; i < vec.size(); i++)
+  {
+    if (vec[i].second != clean[i].second)
+    {
+      REQUIRE(tukey.GetWeights()[i] == 0);
+    }
+  }
+
+  // At convergence the thetas are the weighted least squares fit with the final weights.
+  weighted_vector samples;
+  for (size_t i = 0; i < vec.size(); i++)
+  {
+    samples.push_back({vec[i].first, vec[i].second, huber.GetWeights()[i]});
+  }
+  pdd weighted = normal.FitData(samples);
+  REQUIRE((std::abs(weighted.first - huber_thetas.first) < 1e-6 && std::abs(weighted.second - huber_thetas.second) < 1e-6));
+}
+
+TEST_CASE("lrgRobustSolverStrategy: low-rank updates agree with full passes", "[lrgRobustSolverStrategy]")
+{
+  pdd_vector vec = contaminated_data(20000, 0.05);
+
+  lrgRobustSolverStrategy low_rank(lrgRobustLoss::Huber);
+  pdd thetas = low_rank.FitData(vec);
+
+  lrgRobustSolverStrategy full(lrgRobustLoss::Huber);
+  full.SetLowRankUpdates(false);
+  pdd expected = full.FitData(vec);
+
+  REQUIRE((std::abs(thetas.first - expected.first) < 1e-8 && std::abs(thetas.second - expected.second) < 1e-8));
+  REQUIRE(low_rank.GetIterationsRun() == full.GetIterationsRun());
+  REQUIRE(low_rank.GetPointsUpdated() < full.GetPointsUpdated() / 2);
+}
+
+TEST_CASE("lrgRobustSolverStrategy: negative tests", "[lrgRobustSolverStrategy]")
+{
+  REQUIRE_THROWS_AS(lrgRobustLossFromString("cauchy"), std::invalid_argument);
+  REQUIRE(lrgRobustLossFromString("tukey") == lrgRobustLoss::Tukey);
+
+  double tuning = 0;
+  REQUIRE_THROWS_AS(lrgRobustSolverStrategy(lrgRobustLoss::Huber, tuning), std::invalid_argument);
+
+  lrgRobustSolverStrategy strategy;
+  double tolerance = -1;
+  REQUIRE_THROWS_AS(strategy.SetTolerance(tolerance), std::invalid_argument);
+
+  pdd_vector empty;
+  REQUIRE_THROWS_AS(strategy.FitData(empty), std::length_error);
+
+  // All the x-values are the same.
+  pdd_vector vec = {std::make_pair(1.0, 1.0), std::make_pair(1.0, 2.0), std::make_pair(1.0, 3.0)};
+  REQUIRE_THROWS_AS(strategy.FitData(vec), std::logic_error);
+}
@@ -0,0 +1,140 @@
+/*=============================================================================
+
+  PHAS0100ASSIGNMENT1: PHAS0100 Assignment 1 Linear Regression
+
+  Copyright (c) University College London (UCL). All rights reserved.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even
+  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  See LICENSE.txt in the top level directory for details.
+
+=============================================================================*/
+
+#include "catch.hpp"
+#include "lrgCatchMain.h"
+#include "lrgTestData.h"
+#include "lrgSketchSolverStrategy.h"
+#include "lrgSufficientStatistics.h"
+#include <cmath>
+#include <random>
+
+// y = 2 + 3x + N(0, 1) for x uniform in [offset, offset + 10).
+static pdd_vector linear_data(unsigned int size, double offset)
+{
+  std::mt19937_64 mt64(42);
+  std::uniform_real_distribution<double> uniform(offset, offset + 10);
+  std::normal_distribution<double> noise(0.0, 1.0);
+  pdd_vector vec;
+  for (unsigned int i = 0; i < size; i++)
+  {
+    double x = uniform(mt64);
+    vec.push_back(std::make_pair(x, 2 + 3 * x + noise(mt64)));
+  }
+  return vec;
+}
+
+static double squared_error(const pdd_vector &vec, const pdd &thetas)
+{
+  lrgSufficientStatistics stats(vec);
+  return stats.GetSquaredError(thetas);
+}
+
+TEST_CASE("lrgSketchSolverStrategy: the sketched line is close to least squares", "[lrgSketchSolverStrategy]")
+{
+  pdd_vector vec = linear_data(200000, 0);
+  pdd exact = least_squares(lrgSufficientStatistics(vec));
+
+  unsigned int rows = 4096;
+  lrgSketchSolverStrategy sketch(rows);
+  pdd thetas = sketch.FitData(vec);
+  REQUIRE(sketch.GetIterationsRun() == 0);
+
+  // The slope's standard error on 4096 rows is about 1 / (2.9 * 64) = 0.005.
+  REQUIRE(std::abs(thetas.second - exact.second) < 0.03);
+  REQUIRE(std::abs(thetas.first - exact.first) < 0.2);
+  REQUIRE(squared_error(vec, thetas) < 1.01 * squared_error(vec, exact));
+
+  // More rows, a better line.
+  unsigned int more = 65536;
+  lrgSketchSolverStrategy bigger(more);
+  pdd closer = bigger.FitData(vec);
+  REQUIRE(squared_error(vec, closer) - squared_error(vec, exact) < squared_error(vec, thetas) - squared_error(vec, exact));
+}
+
+TEST_CASE("lrgSketchSolverStrategy: LSQR refinement reaches the exact line", "[lrgSketchSolverStrategy]")
+{
+  // Far from zero the columns 1 and x are almost parallel, and only the preconditioner saves LSQR.
+  const double offsets[] = {0, 1e4};
+  for (double offset : offsets)
+  {
+    pdd_vector vec = linear_data(100000, offset);
+    pdd exact = least_squares(lrgSufficientStatistics(vec));
+
+    unsigned int rows = 1024, iterations = 20;
+    lrgSketchSolverStrategy sketch(rows);
+    sketch.SetRefinement(iterations);
+    pdd thetas = sketch.FitData(vec);
+
+    REQUIRE(sketch.GetIterationsRun() <= 10);
+    REQUIRE(std::abs(thetas.second - exact.second) < 1e-9);
+    REQUIRE(std::abs(thetas.first - exact.first) < 1e-9 * (1 + 3 * offset));
+  }
+}
+
+TEST_CASE("lrgSketchSolverStrategy: points on a line and the seed", "[lrgSketchSolverStrategy]")
+{
+  pdd_vector vec;
+  std::vector<double> x, y;
+  for (int i = 0; i < 1000; i++)
+  {
+    vec.push_back(std::make_pair(i * 0.01, 1.5 - 2 * i * 0.01));
+    x.push_back(vec.back().first);
+    y.push_back(vec.back().second);
+  }
+
+  // Every sketch of points on a line has the line as its exact solution.
+  unsigned int rows = 16;
+  lrgSketchSolverStrategy sketch(rows);
+  pdd thetas = sketch.FitData(vec);
+  REQUIRE(std::abs(thetas.first - 1.5) < 1e-10);
+  REQUIRE(std::abs(thetas.second + 2) < 1e-10);
+
+  // The same seed gives the same sketch, on a pdd_vector or on arrays.
+  pdd_vector noisy = linear_data(5000, 0);
+  std::vector<double> noisy_x, noisy_y;
+  for (auto &xy : noisy)
+  {
+    noisy_x.push_back(xy.first);
+    noisy_y.push_back(xy.second);
+  }
+  pdd a = sketch.FitData(noisy);
+  pdd b = sketch.FitData(noisy_x.data(), noisy_y.data(), noisy.size());
+  REQUIRE(a.first == b.first);
+  REQUIRE(a.second == b.second);
+  sketch.SetSeed(7);
+  pdd c = sketch.FitData(noisy);
+  REQUIRE(a.second != c.second);
+}
+
+TEST_CASE("lrgSketchSolverStrategy: negative tests", "[lrgSketchSolverStrategy]")
+{
+  unsigned int one = 1;
+  REQUIRE_THROWS_AS(lrgSketchSolverStrategy(one), std::invalid_argument);
+
+  lrgSketchSolverStrategy sketch;
+  REQUIRE_THROWS_AS(sketch.SetSketchRows(one), std::invalid_argument);
+  REQUIRE_THROWS_AS(sketch.SetTolerance(-1), std::invalid_argument);
+
+  pdd_vector empty;
+  REQUIRE_THROWS_AS(sketch.FitData(empty), std::length_error);
+
+  // All the x-values are the same.
+  pdd_vector vertical;
+  for (int i = 0; i < 100; i++)
+  {
+    vertical.push_back(std::make_pair(2.0, i));
+  }
+  REQUIRE_THROWS_AS(sketch.FitData(vertical), std::logic_error);
+}
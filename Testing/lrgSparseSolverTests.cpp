@@ -0,0 +1,163 @@
+/*=============================================================================
+
+  PHAS0100ASSIGNMENT1: PHAS0100 Assignment 1 Linear Regression
+
+  Copyright (c) University College London (UCL). All rights reserved.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even
+  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  See LICENSE.txt in the top level directory for details.
+
+=============================================================================*/
+
+#include "catch.hpp"
+#include "lrgCatchMain.h"
+#include "lrgSparseFileLoader.h"
+#include "lrgSparseNormalEquationSolverStrategy.h"
+#include "lrgSparseStochasticGradientSolverStrategy.h"
+#include "lrgConjugateGradientSolverStrategy.h"
+#include <memory>
+
+// TestDataSparse.txt has 300 samples with 3 of 20 features each, created from
+// y = 1.5 + sum of thetas_j * x_j + noise (standard deviation 0.01) with these thetas.
+static Eigen::VectorXd sparseTestThetas()
+{
+  Eigen::VectorXd thetas(21);
+  thetas << 1.5, -1.057, -2.095, 0.906, -2.565, 0.215, -0.806, -2.652, 0.045, -2.775, -0.398,
+      -2.581, -2.456, -0.453, 1.961, -2.257, -1.661, 0.765, 2.686, 0.463, -0.62;
+  return thetas;
+}
+
+// As in lrgLeastSquaresSolverTests.cpp, the executable is expected to run inside the bin directory.
+static lrgSparseDataset loadSparseTestData()
+{
+  std::string filepath = "../../Testing/TestFiles/TestDataSparse.txt";
+  lrgSparseFileLoader loader(filepath);
+  return loader.GetData();
+}
+
+TEST_CASE("lrgSparseFileLoader: check GetData() TestDataSparse.txt", "[lrgSparseFileLoader]")
+{
+  lrgSparseDataset data = loadSparseTestData();
+
+  // 20 features plus the column of ones, and 3 non-zeros plus the one per row.
+  REQUIRE(data.X.rows() == 300);
+  REQUIRE(data.X.cols() == 21);
+  REQUIRE(data.X.nonZeros() == 300 * 4);
+  REQUIRE(data.y.size() == 300);
+
+  // First line: -0.272591 2:1.7877 8:0.9344 18:0.7164
+  REQUIRE(data.y(0) == -0.272591);
+  REQUIRE(data.X.coeff(0, 0) == 1);
+  REQUIRE(data.X.coeff(0, 1) == 0);
+  REQUIRE(data.X.coeff(0, 2) == 1.7877);
+  REQUIRE(data.X.coeff(0, 18) == 0.7164);
+}
+
+TEST_CASE("lrgSparseFileLoader: negative tests", "[lrgSparseFileLoader]")
+{
+  // The file doesn't exist.
+  std::string filepath = "../../Testing/TestFiles/NOT_EXISTING_FILE.txt";
+  lrgSparseFileLoader missing(filepath);
+  CHECK_THROWS(missing.GetData());
+
+  // The file is empty.
+  filepath = "../../Testing/TestFiles/TestData0.txt";
+  lrgSparseFileLoader empty(filepath);
+  CHECK_THROWS(empty.GetData());
+
+  // The file has the dense "x y" format, so the second value is not an index:value entry.
+  filepath = "../../Testing/TestFiles/TestData1.txt";
+  lrgSparseFileLoader dense(filepath);
+  CHECK_THROWS(dense.GetData());
+
+  // "1.5:3" is not index 1.
+  filepath = "../../Testing/TestFiles/TestDataSparseIndex.txt";
+  lrgSparseFileLoader fractional(filepath);
+  CHECK_THROWS(fractional.GetData());
+
+  // The same feature twice on one line.
+  filepath = "../../Testing/TestFiles/TestDataSparseDuplicate.txt";
+  lrgSparseFileLoader duplicate(filepath);
+  CHECK_THROWS(duplicate.GetData());
+}
+
+TEST_CASE("lrgSparseFileLoader: blank lines are skipped", "[lrgSparseFileLoader]")
+{
+  std::string filepath = "../../Testing/TestFiles/TestDataSparseBlankLines.txt";
+  lrgSparseFileLoader loader(filepath);
+  lrgSparseDataset data = loader.GetData();
+
+  REQUIRE(data.X.rows() == 3);
+  REQUIRE(data.y(1) == -3.85054);
+  REQUIRE(data.X.coeff(2, 16) == 0.9712);
+}
+
+TEST_CASE("lrgSparseNormalEquationSolverStrategy: check FitData() TestDataSparse.txt", "[lrgSparseNormalEquationSolverStrategy]")
+{
+  lrgSparseDataset data = loadSparseTestData();
+
+  std::unique_ptr<lrgSparseLinearModelSolverStrategyI> solver = std::make_unique<lrgSparseNormalEquationSolverStrategy>();
+  Eigen::VectorXd thetas = solver->FitData(data);
+
+  REQUIRE((thetas - sparseTestThetas()).cwiseAbs().maxCoeff() < 0.05);
+
+  // Same answer as the dense normal equation.
+  Eigen::MatrixXd X = Eigen::MatrixXd(data.X);
+  Eigen::VectorXd expected = (X.transpose() * X).ldlt().solve(X.transpose() * data.y);
+  REQUIRE((thetas - expected).cwiseAbs().maxCoeff() < 1e-8);
+}
+
+TEST_CASE("lrgSparseNormalEquationSolverStrategy: negative test, feature that never appears", "[lrgSparseNormalEquationSolverStrategy]")
+{
+  lrgSparseDataset data = loadSparseTestData();
+
+  // Add a 22nd column without any non-zeros. Its theta cannot be determined.
+  data.X.conservativeResize(data.X.rows(), data.X.cols() + 1);
+
+  lrgSparseNormalEquationSolverStrategy solver;
+  CHECK_THROWS(solver.FitData(data));
+}
+
+TEST_CASE("lrgConjugateGradientSolverStrategy: check sparse FitData() TestDataSparse.txt", "[lrgConjugateGradientSolverStrategy]")
+{
+  lrgSparseDataset data = loadSparseTestData();
+
+  lrgSparseNormalEquationSolverStrategy normal;
+  Eigen::VectorXd expected = normal.FitData(data);
+
+  lrgConjugateGradientSolverStrategy strategy;
+  std::unique_ptr<lrgSparseLinearModelSolverStrategyI> solver = std::make_unique<lrgConjugateGradientSolverStrategy>(strategy);
+  Eigen::VectorXd thetas = solver->FitData(data);
+  REQUIRE((thetas - expected).cwiseAbs().maxCoeff() < 1e-6);
+
+  strategy.SetPreconditioning(true);
+  thetas = strategy.FitData(data);
+  REQUIRE((thetas - expected).cwiseAbs().maxCoeff() < 1e-6);
+}
+
+TEST_CASE("lrgSparseStochasticGradientSolverStrategy: check FitData() TestDataSparse.txt", "[lrgSparseStochasticGradientSolverStrategy]")
+{
+  lrgSparseDataset data = loadSparseTestData();
+
+  lrgSparseNormalEquationSolverStrategy normal;
+  Eigen::VectorXd expected = normal.FitData(data);
+
+  double eta = 0.01;
+  unsigned int epochs = 500;
+  lrgSparseStochasticGradientSolverStrategy solver(eta, epochs);
+  Eigen::VectorXd thetas = solver.FitData(data);
+
+  REQUIRE((thetas - expected).cwiseAbs().maxCoeff() < 1e-2);
+}
+
+TEST_CASE("lrgSparseStochasticGradientSolverStrategy: negative test, empty constructor", "[lrgSparseStochasticGradientSolverStrategy]")
+{
+  lrgSparseDataset data = loadSparseTestData();
+
+  // eta and epochs are not set.
+  lrgSparseStochasticGradientSolverStrategy solver;
+  CHECK_THROWS(solver.FitData(data));
+}
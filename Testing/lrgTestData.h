@@ -0,0 +1,48 @@
+/*=============================================================================
+
+  PHAS0100ASSIGNMENT1: PHAS0100 Assignment 1 Linear Regression
+
+  Copyright (c) University College London (UCL). All rights reserved.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even
+  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  See LICENSE.txt in the top level directory for details.
+
+=============================================================================*/
+
+#ifndef lrgTestData_h
+#define lrgTestData_h
+
+#include "lrgLinearDataCreator.h"
+#include "lrgSufficientStatistics.h"
+#include <memory>
+
+// Test data and reference fits shared by the test files.
+
+// y = 2 + 3x + N(0, 1) for x in [0, 1).
+inline pdd_vector linear_data(unsigned int size)
+{
+  pdd_vector vec;
+  lrgLinearDataCreator data(2, 3, size, std::make_shared<pdd_vector>(vec));
+  return data.GetData();
+}
+
+// y = 2 + 3x + N(0, 1) with a fraction of the points moved up by 20 or more.
+inline pdd_vector contaminated_data(unsigned int size, double fraction)
+{
+  pdd_vector vec;
+  lrgLinearDataCreator data(2, 3, size, std::make_shared<pdd_vector>(vec));
+  data.SetContamination(fraction, 20);
+  return data.GetData();
+}
+
+// The least squares line straight from the moments.
+inline pdd least_squares(const lrgSufficientStatistics &stats)
+{
+  double t1 = stats.GetSxy() / stats.GetSxx();
+  return std::make_pair(stats.GetMeanY() - t1 * stats.GetMeanX(), t1);
+}
+
+#endif
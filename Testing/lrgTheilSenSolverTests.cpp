@@ -0,0 +1,182 @@
+/*=============================================================================
+
+  PHAS0100ASSIGNMENT1: PHAS0100 Assignment 1 Linear Regression
+
+  Copyright (c) University College London (UCL). All rights reserved.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even
+  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  See LICENSE.txt in the top level directory for details.
+
+=============================================================================*/
+
+#include "catch.hpp"
+#include "lrgCatchMain.h"
+#include "lrgTestData.h"
+#include "lrgNormalEquationSolverStrategy.h"
+#include "lrgTheilSenSolverStrategy.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+// The median of all the O(N^2) slopes and then of y - t1 * x, straight from the definition.
+static pdd brute_force(const pdd_vector &vec)
+{
+  std::vector<double> slopes;
+  for (size_t i = 0; i < vec.size(); i++)
+  {
+    for (size_t j = i + 1; j < vec.size(); j++)
+    {
+      if (vec[i].first != vec[j].first)
+      {
+        slopes.push_back((vec[j].second - vec[i].second) / (vec[j].first - vec[i].first));
+      }
+    }
+  }
+  std::sort(slopes.begin(), slopes.end());
+  size_t M = slopes.size();
+  double t1 = (M % 2 == 1) ? slopes[M / 2] : (slopes[M / 2 - 1] + slopes[M / 2]) / 2;
+
+  std::vector<double> intercepts;
+  for (auto &xy : vec)
+  {
+    intercepts.push_back(xy.second - t1 * xy.first);
+  }
+  std::sort(intercepts.begin(), intercepts.end());
+  size_t N = intercepts.size();
+  double t0 = (N % 2 == 1) ? intercepts[N / 2] : (intercepts[N / 2 - 1] + intercepts[N / 2]) / 2;
+  return std::make_pair(t0, t1);
+}
+
+TEST_CASE("lrgTheilSenSolverStrategy: small data sets match the definition", "[lrgTheilSenSolverStrategy]")
+{
+  std::mt19937_64 mt64;
+  std::normal_distribution<double> distribution(0.0, 1.0);
+
+  // Odd and even numbers of slopes, and two or three points.
+  for (unsigned int size : {2u, 3u, 4u, 7u, 50u, 101u, 300u})
+  {
+    pdd_vector vec;
+    for (unsigned int i = 0; i < size; i++)
+    {
+      double x = distribution(mt64);
+      vec.push_back(std::make_pair(x, 1 - 2 * x + distribution(mt64)));
+    }
+    lrgTheilSenSolverStrategy strategy;
+    std::unique_ptr<lrgLinearModelSolverStrategyI> solver = std::make_unique<lrgTheilSenSolverStrategy>(strategy);
+    pdd thetas = solver->FitData(vec);
+    pdd expected = brute_force(vec);
+    REQUIRE(std::abs(thetas.first - expected.first) < 1e-12);
+    REQUIRE(std::abs(thetas.second - expected.second) < 1e-12);
+  }
+}
+
+TEST_CASE("lrgTheilSenSolverStrategy: repeated x and repeated points", "[lrgTheilSenSolverStrategy]")
+{
+  // x on a grid of 20 values, so most of the points share their x with others, and some exact copies.
+  std::mt19937_64 mt64;
+  std::uniform_int_distribution<int> grid(0, 19);
+  std::normal_distribution<double> distribution(0.0, 1.0);
+  pdd_vector vec;
+  for (int i = 0; i < 2000; i++)
+  {
+    double x = grid(mt64);
+    vec.push_back(std::make_pair(x, 5 + 0.5 * x + distribution(mt64)));
+  }
+  for (int i = 0; i < 100; i++)
+  {
+    vec.push_back(vec[i]);
+  }
+
+  lrgTheilSenSolverStrategy strategy;
+  pdd thetas = strategy.FitData(vec);
+  pdd expected = brute_force(vec);
+  REQUIRE(std::abs(thetas.first - expected.first) < 1e-12);
+  REQUIRE(std::abs(thetas.second - expected.second) < 1e-12);
+
+  // All the points on a line: every slope is the same.
+  pdd_vector line;
+  for (int i = 0; i < 5000; i++)
+  {
+    line.push_back(std::make_pair(i % 100, 1 + 3 * (i % 100)));
+  }
+  thetas = strategy.FitData(line);
+  REQUIRE(thetas.second == 3);
+  REQUIRE(thetas.first == 1);
+}
+
+TEST_CASE("lrgTheilSenSolverStrategy: narrowing rounds match the definition", "[lrgTheilSenSolverStrategy]")
+{
+  // 3000 points have 4.5M slopes, far more than can be listed, so the interval has to be narrowed.
+  pdd_vector vec = contaminated_data(3000, 0.2);
+  lrgTheilSenSolverStrategy strategy;
+  pdd thetas = strategy.FitData(vec);
+  REQUIRE(strategy.GetRounds() > 0);
+  pdd expected = brute_force(vec);
+  REQUIRE(std::abs(thetas.first - expected.first) < 1e-12);
+  REQUIRE(std::abs(thetas.second - expected.second) < 1e-12);
+
+  // The random pairs only change the route to the answer.
+  strategy.SetSeed(42);
+  pdd reseeded = strategy.FitData(vec);
+  REQUIRE(reseeded.first == thetas.first);
+  REQUIRE(reseeded.second == thetas.second);
+}
+
+TEST_CASE("lrgTheilSenSolverStrategy: outliers do not move the line", "[lrgTheilSenSolverStrategy]")
+{
+  pdd_vector vec = contaminated_data(20000, 0.2);
+
+  lrgNormalEquationSolverStrategy normal;
+  pdd least_squares = normal.FitData(vec);
+  REQUIRE(std::abs(least_squares.first - 2) > 2);
+
+  lrgTheilSenSolverStrategy strategy;
+  pdd thetas = strategy.FitData(vec);
+  REQUIRE(std::abs(thetas.second - 3) < 0.1);
+  // The outliers all go up, so the median intercept is biased a little, but nowhere near least squares.
+  REQUIRE(std::abs(thetas.first - 2) < 1);
+}
+
+TEST_CASE("lrgTheilSenSolverStrategy: sampled pairs are close to the exact estimate", "[lrgTheilSenSolverStrategy]")
+{
+  pdd_vector vec = contaminated_data(20000, 0.2);
+
+  lrgTheilSenSolverStrategy exact;
+  pdd expected = exact.FitData(vec);
+
+  unsigned long pairs = 200000;
+  unsigned int threads = 4;
+  lrgTheilSenSolverStrategy sampled;
+  sampled.SetSampledPairs(pairs);
+  sampled.SetThreads(threads);
+  pdd thetas = sampled.FitData(vec);
+  REQUIRE(std::abs(thetas.second - expected.second) < 0.02);
+  REQUIRE(std::abs(thetas.first - expected.first) < 0.1);
+
+  // The same seed and threads give the same pairs.
+  pdd again = sampled.FitData(vec);
+  REQUIRE(again.first == thetas.first);
+  REQUIRE(again.second == thetas.second);
+}
+
+TEST_CASE("lrgTheilSenSolverStrategy: negative tests", "[lrgTheilSenSolverStrategy]")
+{
+  lrgTheilSenSolverStrategy strategy;
+  pdd_vector empty;
+  REQUIRE_THROWS_AS(strategy.FitData(empty), std::length_error);
+
+  // One point, or every point at the same x, has no slope.
+  pdd_vector vertical = {{1, 1}, {1, 2}, {1, 3}};
+  REQUIRE_THROWS_AS(strategy.FitData(pdd_vector{{1, 1}}), std::logic_error);
+  REQUIRE_THROWS_AS(strategy.FitData(vertical), std::logic_error);
+
+  unsigned long pairs = 100;
+  strategy.SetSampledPairs(pairs);
+  REQUIRE_THROWS_AS(strategy.FitData(vertical), std::logic_error);
+
+  unsigned int threads = 0;
+  REQUIRE_THROWS_AS(strategy.SetThreads(threads), std::invalid_argument);
+}